@@ -35,8 +35,34 @@
 #define AMBE_ENCODE_BUFFER 0x1FFF6B60;
 #define AMBE_ENCODE_ECC_BUFFER 0x1FFF8244;
 
+#define CODEC_BER_BITS_PER_FRAME	47// Golay protected bits (C0 + C1) in each AMBE frame. The same as MMDVMHost uses
+#define CODEC_BER_WINDOW_FRAMES		50// About 1 second of audio, as there are 3 AMBE frames per 60mS superframe slot
+
+typedef struct
+{
+	uint32_t callFrames;
+	uint32_t callErrors;
+	uint16_t windowFrames;
+	uint16_t windowErrors;
+	int16_t windowBER;// BER of the last complete window, in 0.1% units, or -1 if there is none yet
+} codecBER_t;
+
+extern volatile codecBER_t codecBER;
+
+#define CODEC_PLAYBACK_QUEUE_SIZE	8// Must be a power of 2
+#define CODEC_AMBE_BURST_LENGTH		27// 3 AMBE frames, 60mS of audio
+
 void init_codec(void);
 void tick_codec_decode(uint8_t *indata_ptr);
 void tick_codec_encode(uint8_t *outdata_ptr);
+void codecBERReset(void);
+void codecAGCReset(void);
+void codecBERCountFrames(uint8_t *indata_ptr);
+int codecGetBER(bool wholeCall);
+bool codecPlaybackPut(const uint8_t *ambeBurst);
+int codecPlaybackGetSpace(void);
+bool codecPlaybackIsActive(void);
+void codecPlaybackStop(void);
+void tick_codec_playback(bool canPlay);
 
 #endif /* _FW_CODEC_H_ */
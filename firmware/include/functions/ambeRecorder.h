@@ -0,0 +1,49 @@
+/*
+ * Copyright (C)2019 Roger Clark. VK3KYY / G4KYF
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+ */
+#ifndef _FW_AMBERECORDER_H_
+#define _FW_AMBERECORDER_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#define AMBE_RECORDER_BURST_LENGTH		27// 3 AMBE frames, 60mS of audio
+#define AMBE_RECORDER_BURSTS_PER_PAGE	9
+
+// Flags, in the top byte of srcId
+#define AMBE_RECORDER_FLAG_TX			0x01
+#define AMBE_RECORDER_FLAG_CALL_START	0x02
+
+typedef struct
+{
+	uint32_t sequence;// 0xFFFFFFFF means erased / unused page
+	uint32_t srcId;// DMR ID, and the AMBE_RECORDER_FLAG_xxx in the top byte
+	uint32_t dstId;// TG or PC, in the same format as the last heard talkGroupOrPcId
+	uint8_t  numBursts;
+	uint8_t  data[AMBE_RECORDER_BURSTS_PER_PAGE][AMBE_RECORDER_BURST_LENGTH];
+} ambeRecorderPage_t;// 256 bytes, one Flash page
+
+void ambeRecorderInit(void);
+void ambeRecorderQueueBurst(const uint8_t *ambeBurst, bool isTx);
+void ambeRecorderSetRxCallInfo(uint32_t srcId, uint32_t dstId);
+void ambeRecorderTick(void);
+void ambeRecorderFlush(void);
+bool ambeRecorderPlayLastCall(uint32_t srcId);
+void ambeRecorderStopPlayback(void);
+bool ambeRecorderIsPlaying(void);
+
+#endif /* _FW_AMBERECORDER_H_ */
@@ -0,0 +1,44 @@
+/*
+ * Copyright (C)2019 Roger Clark. VK3KYY / G4KYF
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+ */
+#ifndef _FW_BOOTPROFILER_H_
+#define _FW_BOOTPROFILER_H_
+
+#include <stdint.h>
+
+#define BOOT_PROFILER_MAX_STAGES	24
+#define BOOT_PROFILER_NAME_LENGTH	12
+
+typedef struct
+{
+	uint32_t timeUs;// Since the clocks were set up, at the end of the stage
+	char     name[BOOT_PROFILER_NAME_LENGTH];
+} bootProfilerStage_t;
+
+// Read as is by the CPS (area 7 of the 'R' command), so the layout must not change
+typedef struct
+{
+	uint32_t            numStages;
+	bootProfilerStage_t stages[BOOT_PROFILER_MAX_STAGES];
+} bootProfiler_t;
+
+extern bootProfiler_t bootProfiler;
+
+void bootProfilerInit(void);
+void bootProfilerMark(const char *name);
+
+#endif /* _FW_BOOTPROFILER_H_ */
@@ -45,6 +45,34 @@ typedef struct deviationToneStruct
 	uint8_t dcs_narrow;
 } deviationToneStruct_t;
 
+#define CALIBRATION_NUM_FREQ_OFFSETS 8
+
+enum CALIBRATION_BANDWIDTH { CALIBRATION_NARROWBAND = 0, CALIBRATION_WIDEBAND = 1 };
+
+// Calibration values for one band, decoded once from the calibration table
+typedef struct calibrationBandValues
+{
+	// HR-C6000
+	uint8_t DACDataShift;
+	uint8_t QMod2Offset;
+	uint8_t twoPointMod47;
+	uint8_t twoPointMod48;
+	uint8_t phaseReduce[CALIBRATION_NUM_FREQ_OFFSETS];
+
+	// AT1846S
+	uint8_t pgaGain;
+	uint8_t voiceGainTx;
+	uint8_t gainTx;
+	uint8_t padrvIbit;
+	uint8_t dacVgainAnalog;
+	uint8_t volumeAnalog;
+	uint16_t xmitterDev[2];
+	uint16_t noise1Th[2];
+	uint16_t noise2Th[2];
+	uint16_t rssi3Th[2];
+	uint16_t squelchTh[CALIBRATION_NUM_FREQ_OFFSETS][2];
+} calibrationBandValues_t;
+
 
 void read_val_DACDATA_shift(int offset, uint8_t* val_shift);
 void read_val_twopoint_mod(int offset, uint8_t* val_0x47, uint8_t* val_0x48);
@@ -74,4 +102,7 @@ void read_val_squelch_th(int offset, int mod, uint16_t* value);
 bool calibrationGetPowerForFrequency(int freq, calibrationPowerValues_t *powerSettings);
 bool calibrationGetRSSIMeterParams(calibrationRSSIMeter_t *rssiMeterValues);
 bool checkAndCopyCalibrationToCommonLocation(void);
+bool calibrationInit(void);
+const calibrationBandValues_t *calibrationGetBandValues(int band);
+bool calibrationIsInCalibrationSector(uint32_t address);
 #endif
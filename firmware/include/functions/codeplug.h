@@ -79,7 +79,7 @@ typedef struct struct_codeplugRxGroup
 	char name[16];
 	uint16_t contacts[32];
 	int	NOT_IN_CODEPLUG_numTGsInGroup;// NOT IN THE
-	uint16_t NOT_IN_CODEPLUG_contactsTG[32];
+	uint32_t NOT_IN_CODEPLUG_sortedTGs[32];// The TGs of the contacts, in ascending order for the DMR Rx filter
 } struct_codeplugRxGroup_t;
 
 typedef struct struct_codeplugContact
@@ -133,6 +133,8 @@ void codeplugGetVFO_ChannelData(struct_codeplugChannel_t *vfoBuf,int VFONumber);
 void codeplugSetVFO_ChannelData(struct_codeplugChannel_t *vfoBuf,int VFONumber);
 bool codeplugChannelIndexIsValid(int index);
 void codeplugChannelIndexSetValid(int index);
+int codeplugChannelGetNextValidIndex(int index, int direction);
+void codeplugChannelsCacheInvalidate(void);
 bool codeplugChannelSaveDataForIndex(int index, struct_codeplugChannel_t *channelBuf);
 bool codeplugChannelToneIsCTCSS(uint16_t tone);
 
@@ -146,6 +148,7 @@ void codeplugInitChannelsPerZone(void);
 bool codeplugGetOpenGD77CustomData(codeplugCustomDataType_t dataType,uint8_t *dataBuf);
 int codeplugGetQuickkeyFunctionID(int key);
 void codeplugInitContactsCache(void);
+bool codeplugContactsCacheTick(void);
 bool codeplugContactsContainsPC(uint32_t pc);
 
 #endif
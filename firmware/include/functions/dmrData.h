@@ -0,0 +1,67 @@
+/*
+ * Copyright (C)2019 Roger Clark. VK3KYY / G4KYF
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+ */
+#ifndef _FW_DMRDATA_H_
+#define _FW_DMRDATA_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#define DMR_DATA_BURST_MAX_LENGTH		24// Rate 1 data block
+#define DMR_DATA_INBOX_DATA_LENGTH		240
+
+#define DMR_DATA_INBOX_FLAG_GROUP		0x01
+#define DMR_DATA_INBOX_FLAG_TRUNCATED	0x02
+
+// Data Packet Formats, from the Data Header
+#define DMR_DATA_DPF_UNCONFIRMED		0x02
+#define DMR_DATA_DPF_CONFIRMED			0x03
+#define DMR_DATA_DPF_SHORT_DEFINED		0x0D
+#define DMR_DATA_DPF_SHORT_RAW			0x0E
+
+typedef struct
+{
+	uint32_t sequence;// 0xFFFFFFFF means erased / unused record
+	uint32_t srcId;
+	uint32_t dstId;
+	uint8_t  flags;
+	uint8_t  dpf;
+	uint8_t  sap;
+	uint8_t  length;
+	uint8_t  data[DMR_DATA_INBOX_DATA_LENGTH];
+} dmrDataInboxRecord_t;// 256 bytes, one Flash page per record
+
+typedef struct
+{
+	uint32_t burstsReceived;
+	uint32_t burstsDropped;// ISR queue was full
+	uint32_t messagesReceived;
+	uint32_t messagesFailed;// CRC error, missing blocks or timeout
+	uint32_t messagesNotStored;// Inbox write still pending when the next message completed
+} dmrDataStats_t;
+
+extern dmrDataStats_t dmrDataStats;
+
+int dmrDataBurstLength(int dataType);
+void dmrDataQueueBurst(int dataType, int timeSlot, const uint8_t *data);
+void dmrDataInit(void);
+void dmrDataTick(void);
+void dmrDataFlush(void);
+int dmrDataInboxGetCount(void);
+bool dmrDataInboxGetMessage(int number, dmrDataInboxRecord_t *rec);
+
+#endif /* _FW_DMRDATA_H_ */
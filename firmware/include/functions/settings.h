@@ -88,6 +88,10 @@ typedef struct settingsStruct
 	uint8_t			contactDisplayPriority;
 	uint8_t			splitContact;
 	uint8_t			beepOptions;
+	uint8_t			callRecorder;// 0 = off, 1 = record the DMR calls
+	uint8_t			voicePrompts;// 0 = off, 1 = AMBE voice prompts (not used on the GD-77S, which has the EPL003)
+	uint8_t			rxAGC;// 0 = off, 1 = DMR receive AGC and noise gate
+	uint8_t			micCompressor;// Profile. 0 = off, 1 = 2:1, 2 = 4:1
 
 } settingsStruct_t;
 
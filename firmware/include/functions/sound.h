@@ -59,6 +59,8 @@ extern int soundBeepVolumeDivider;
 #define HOTSPOT_BUFFER_SIZE 50
 #define HOTSPOT_BUFFER_COUNT 48
 
+#define MIC_COMPRESSOR_NUM_PROFILES 3// Off, 2:1 and 4:1
+
 extern union sharedDataBuffer
 {
 	volatile uint8_t wavbuffer[WAV_BUFFER_COUNT][WAV_BUFFER_SIZE];
@@ -94,11 +96,13 @@ void tick_RXsoundbuffer(void);
 void setup_soundBuffer(void);
 void tick_melody(void);
 void fw_beep_task(void *data);
+uint32_t soundISqrt(uint32_t value);
 
 //bit masks to track amp usage
 #define AUDIO_AMP_MODE_NONE 0B00000000
 #define AUDIO_AMP_MODE_BEEP 0B00000001
 #define AUDIO_AMP_MODE_RF 	0B00000010
+#define AUDIO_AMP_MODE_PROMPT 0B00000100
 
 
 uint8_t getAudioAmpStatus(void);
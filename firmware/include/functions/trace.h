@@ -0,0 +1,78 @@
+/*
+ * Copyright (C)2019 Roger Clark. VK3KYY / G4KYF
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+ */
+#ifndef _FW_TRACE_H_
+#define _FW_TRACE_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// Event IDs. These are decoded by tools/trace_decoder, so existing values must not change
+typedef enum
+{
+	TRACE_EVENT_OVERFLOW = 1,// arg1: number of records lost
+	TRACE_EVENT_DMR_SYS_INT,// arg1: interrupt flags (0x82), arg2: slot_state
+	TRACE_EVENT_DMR_SEND_REJECTED,
+	TRACE_EVENT_DMR_SEND_START,// arg1: 0x84
+	TRACE_EVENT_DMR_SEND_END,
+	TRACE_EVENT_DMR_RX_DATA,// arg1: data type | sync class << 8 | CRC OK << 16 | RPI << 24, arg2: colour code | timecode << 8
+	TRACE_EVENT_DMR_RX_STOP,// arg1: timecode
+	TRACE_EVENT_DMR_ABNORMAL_EXIT,// arg1: 0x98
+	TRACE_EVENT_DMR_TIMESLOT,// arg1: slot_state, arg2: timecode
+	TRACE_EVENT_DMR_RX_ISR,
+	TRACE_EVENT_DMR_TX_ISR,
+	TRACE_EVENT_CODEC_ENCODE,// arg1: wavbuffer_count
+	TRACE_EVENT_CODEC_DECODE,// arg1: wavbuffer_count, arg2: AMBE FEC bit errors in the burst
+	NUM_TRACE_EVENTS
+} traceEventId_t;
+
+typedef struct
+{
+	uint32_t timestamp;// PITCounter, 0.1mS
+	uint16_t eventId;
+	uint16_t sequence;// Low 16 bits of the record number, also used to detect a record which is being written
+	uint32_t arg1;
+	uint32_t arg2;
+} traceRecord_t;// 16 bytes, sent as is over RTT / USB
+
+typedef enum
+{
+	TRACE_SINK_NONE = 0,
+	TRACE_SINK_RTT,
+	TRACE_SINK_USB
+} traceSink_t;
+
+#if defined(USE_SEGGER_RTT)
+#define TRACE_SINK_DEFAULT TRACE_SINK_RTT
+#else
+#define TRACE_SINK_DEFAULT TRACE_SINK_NONE
+#endif
+
+#if defined(DISABLE_TRACE)
+#define TRACE(eventId, arg1, arg2)
+#else
+#define TRACE(eventId, arg1, arg2) traceEvent((eventId), (uint32_t)(arg1), (uint32_t)(arg2))
+#endif
+
+void traceInit(void);
+void traceEvent(traceEventId_t eventId, uint32_t arg1, uint32_t arg2);
+bool traceRead(traceRecord_t *record);
+void traceSetSink(traceSink_t sink);
+traceSink_t traceGetSink(void);
+void traceTick(void);
+
+#endif /* _FW_TRACE_H_ */
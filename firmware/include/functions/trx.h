@@ -36,6 +36,17 @@ typedef struct trxFrequency
 	int txFreq;
 } trxFrequency_t;
 
+// Precomputed AT1846S Rx frequency registers, used by the scan to retune without any calibration or HR-C6000 update
+typedef struct trxFastTune
+{
+	uint8_t fh_h;// Register 0x29
+	uint8_t fh_l;
+	uint8_t fl_h;// Register 0x2A
+	uint8_t fl_l;
+	uint8_t band;
+	uint8_t squelch;// Noise level below which a carrier is considered as present
+} trxFastTune_t;
+
 extern const int RADIO_VHF_MIN;
 extern const int RADIO_VHF_MAX;
 extern const int RADIO_UHF_MIN;
@@ -97,6 +108,10 @@ bool trxCheckFrequencyInAmateurBand(int tmp_frequency);
 int trxGetBandFromFrequency(int frequency);
 int trxGetNextOrPrevBandFromFrequency(int frequency, bool nextBand);
 void trxReadRSSIAndNoise(void);
+void trxFastTunePrepare(int fRx, uint8_t sql, trxFastTune_t *fastTune);
+void trxFastTuneRx(trxFastTune_t *fastTune);
+bool trxFastTuneCarrierDetected(trxFastTune_t *fastTune);
+void trxFastTuneRestore(void);
 uint8_t trxGetCalibrationVoiceGainTx(void);
 void trxSelectVoiceChannel(uint8_t channel);
 void trxSetTone1(int toneFreq);
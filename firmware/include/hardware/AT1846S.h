@@ -38,6 +38,10 @@ void I2C_AT1846_Postinit(void);
 void I2C_AT1846_SetBandwidth(void);
 void I2C_AT1846_SetMode(void);
 void setMicGainFM(uint8_t gain);
+int I2C_AT1846S_write_reg_2byte(uint8_t reg, uint8_t val1, uint8_t val2);
+int I2C_AT1846S_set_clear_reg_2byte_with_mask(uint8_t reg, uint8_t mask1, uint8_t mask2, uint8_t val1, uint8_t val2);
+int I2C_AT1846S_read_reg_2byte(uint8_t reg, uint8_t *val1, uint8_t *val2);
+void I2C_AT1846S_invalidate_shadow_registers(void);
 
 
 #endif /* _FW_AT1846S_H_ */
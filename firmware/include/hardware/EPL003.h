@@ -34,7 +34,9 @@
 #define GPIO_SpeechSynth_DAT   GPIOC
 #define Pin_SpeechSynth_DAT    12
 
+#endif
 
+// Word numbers of the EPL003. The AMBE voice prompts in the Flash, used on the other platforms, are in the same order
 typedef enum
 {
 	SPEECH_SYNTHESIS_ZERO = 0,
@@ -137,6 +139,8 @@ typedef enum
 } EPL003_Sequence_t;
 
 
+#if defined(PLATFORM_GD77S)
+
 void EPL003_init(void);
 void EPL003_speak(EPL003_Sequence_t seq);
 
@@ -141,11 +141,20 @@
 
 
 #define DMR_FRAME_BUFFER_SIZE 64
+#define DMR_RX_FRAME_QUEUE_SIZE 4 // Must be a power of 2
+
+typedef struct
+{
+	uint32_t received;
+	uint32_t dropped;// Queue was full, the foreground was more than DMR_RX_FRAME_QUEUE_SIZE frames late
+	uint32_t maxLatency;// PIT ticks (0.1mS) between the ISR and the foreground
+} dmrRxFrameQueueStats_t;
 
 extern const uint8_t TG_CALL_FLAG;
 extern const uint8_t PC_CALL_FLAG;
 extern volatile int slot_state;
 extern volatile uint8_t DMR_frame_buffer[DMR_FRAME_BUFFER_SIZE];
+extern volatile dmrRxFrameQueueStats_t dmrRxFrameQueueStats;
 extern volatile bool updateLastHeard;
 extern volatile int dmrMonitorCapturedTS;
 extern char talkAliasText[33];
@@ -168,6 +177,7 @@ void init_digital(void);
 void terminate_digital(void);
 void init_hrc6000_task(void);
 void fw_hrc6000_task(void *data);
+void fw_hrc6000_irq_task(void *data);
 void tick_HR_C6000(void);
 
 void clearIsWakingState(void);
@@ -54,6 +54,7 @@ typedef enum
 } ucChoice_t;
 
 extern uint8_t screenBuf[];
+extern volatile uint8_t ucRenderedRowsMask;
 
 
 extern const int FONT_SIZE_3_HEIGHT;
@@ -65,6 +66,7 @@ void ucClearBuf(void);
 void ucClearRows(int16_t startRow, int16_t endRow, bool isInverted);
 void ucRender(void);
 void ucRenderRows(int16_t startRow, int16_t endRow);
+void ucRenderColumns(int16_t startRow, int16_t endRow, int16_t startColumn, int16_t endColumn);
 void ucPrintCentered(uint8_t y,const  char *text, ucFont_t fontSize);
 void ucPrintAt(uint8_t x, uint8_t y,const  char *text, ucFont_t fontSize);
 int ucPrintCore(int16_t x, int16_t y,const char *szMsg, ucFont_t fontSize, ucTextAlign_t alignment, bool isInverted);
@@ -0,0 +1,29 @@
+/*
+ *   Copyright (C) 2016 by Jonathan Naylor G4KLX
+ *
+ *   Ported to OpenGD77 by Roger Clark VK3KYY / G4KYF
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+ */
+#ifndef _DMR_TRELLIS34_H_
+#define _DMR_TRELLIS34_H_
+
+#include "main.h"
+
+// in / out (respectively) is a complete 33 byte DMR burst, the 18 byte payload is the other parameter
+bool Trellis34_decode(const unsigned char* in, unsigned char* out);
+void Trellis34_encode(const unsigned char* in, unsigned char* out);
+
+#endif
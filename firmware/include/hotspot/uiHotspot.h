@@ -19,6 +19,7 @@
 #define _FW_HOTSPOT_H_
 #include "main.h"
 void hotspotRxFrameHandler(uint8_t* frameBuf);
+bool hotspotTxFrameGet(uint8_t *frameBuf, bool remove);
 
 enum {
 		HOTSPOT_RX_IDLE,
@@ -21,6 +21,7 @@
 
 #include "FreeRTOS.h"
 #include "task.h"
+#include "semphr.h"
 
 #include "fsl_dspi.h"
 
@@ -158,6 +159,11 @@ void init_SPI(void);
 void setup_SPI0(void);
 void setup_SPI1(void);
 
+// Both SPI buses go to the HR-C6000. Any sequence of transfers which must not be interleaved with the DMR interrupt task
+// or another task is bracketed by these. The lock is recursive, so it can be nested
+void lock_SPI_bus(void);
+void unlock_SPI_bus(void);
+
 void clear_SPI_buffer_SPI0(void);
 int write_SPI_page_reg_byte_SPI0(uint8_t page, uint8_t reg, uint8_t val);
 int read_SPI_page_reg_byte_SPI0(uint8_t page, uint8_t reg, volatile uint8_t* val);
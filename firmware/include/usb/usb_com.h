@@ -28,6 +28,7 @@
 
 #define COM_BUFFER_SIZE (512 * 2)
 #define COM_REQUESTBUFFER_SIZE 64
+#define COM_STREAMBUFFER_SIZE 512
 
 extern volatile uint8_t com_buffer[COM_BUFFER_SIZE];
 extern int com_buffer_write_idx;
@@ -38,10 +39,18 @@ extern volatile int com_request;
 extern volatile uint8_t com_requestbuffer[COM_REQUESTBUFFER_SIZE];
 extern USB_DMA_NONINIT_DATA_ALIGN(USB_DATA_ALIGN_SIZE) uint8_t usbComSendBuf[COM_BUFFER_SIZE];
 
+extern volatile uint8_t com_streambuffer[COM_STREAMBUFFER_SIZE];
+extern volatile int com_streambuffer_write_idx;
+extern volatile int com_streambuffer_read_idx;
+extern volatile bool com_streambuffer_stalled;
+
 void tick_com_request(void);
 void send_packet(uint8_t val_0x82, uint8_t val_0x86, int ram);
 void send_packet_big(uint8_t val_0x82, uint8_t val_0x86, int ram1, int ram2);
 void add_to_commbuffer(uint8_t value);
+bool add_to_streambuffer(const uint8_t *data, int length);
+void consume_from_streambuffer(int length);
+void reset_streambuffer(void);
 void USB_DEBUG_PRINT(char *str);
 void USB_DEBUG_printf(const char *format, ...);
 
@@ -23,6 +23,7 @@
 #include "event_groups.h"
 
 void USB_DeviceApplicationInit(void);
+usb_status_t USB_DeviceCdcVcomScheduleRecv(void);
 
 /*******************************************************************************
 * Definitions
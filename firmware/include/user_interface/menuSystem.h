@@ -68,6 +68,17 @@ extern menuControlDataStruct_t menuControlData;
 void menuDisplayTitle(const char *title);
 void menuDisplayEntry(int loopOffset, int focusedItem,const char *entryText);
 int menuGetMenuOffset(int maxMenuEntries, int loopOffset);
+void menuClearListArea(void);
+void menuRenderListArea(void);
+
+#define MENU_LIST_CACHE_TEXT_LENGTH 21
+typedef bool (*menuListCacheLoadFunction_t)(int key, char *text); // Decodes the entry text (MENU_LIST_CACHE_TEXT_LENGTH bytes buffer), returns false if the entry doesn't exist
+void menuListCacheSetLoadFunction(menuListCacheLoadFunction_t loadFunction);
+void menuListCacheInvalidate(void);
+const char *menuListCacheGetText(int key);
+void menuListCachePrefetch(int key);
+void menuListSetScrollDirection(int direction);
+void menuListPrefetchTick(int maxMenuEntries);
 
 void uiChannelModeUpdateScreen(int txTimeSecs);
 void uiChannelModeColdStart();
@@ -151,6 +162,7 @@ enum MENU_SCREENS { UI_SPLASH_SCREEN=0,
 					MENU_CONTACT_NEW,
 					MENU_LANGUAGE,
 					UI_PRIVATE_CALL,
+					MENU_MESSAGE_INBOX,
 					NUM_MENU_ENTRIES
 };
 
@@ -205,5 +217,6 @@ int menuContactListSubMenu(uiEvent_t *event, bool isFirstRun);
 int menuContactDetails(uiEvent_t *event, bool isFirstRun);
 int menuLanguage(uiEvent_t *event, bool isFirstRun);
 int menuPrivateCall(uiEvent_t *event, bool isFirstRun);
+int menuMessageScreen(uiEvent_t *event, bool isFirstRun);
 
 #endif
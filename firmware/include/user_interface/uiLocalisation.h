@@ -42,6 +42,7 @@ typedef struct stringsTable
    const char contact_list[LANGUAGE_TEXTS_LENGTH];// Menu number  15
    const char contact_details[LANGUAGE_TEXTS_LENGTH];// Menu number 16
    const char hotspot_mode[LANGUAGE_TEXTS_LENGTH];// Menu number 17
+   const char inbox[LANGUAGE_TEXTS_LENGTH];// Menu number 18
 
 // Variable length texts
    const char *built;//
@@ -144,6 +145,10 @@ typedef struct stringsTable
    const char *dmr_beep;
    const char *start;
    const char *both;
+   const char *recorder;
+   const char *voice_prompts;
+   const char *rx_agc;
+   const char *mic_compressor;
 } stringsTable_t;
 
 extern const stringsTable_t languages[];
@@ -60,6 +60,7 @@ typedef struct LinkItem
     char 		talkerAlias[32];// 4 blocks of data. 6 bytes + 7 bytes + 7 bytes + 7 bytes . plus 1 for termination some more for safety.
     char 		locator[7];
     uint32_t	time;// current system time when this station was heard
+    int16_t		ber;// Bit error rate of the last call, in 0.1% units, or -1 if unknown
     struct LinkItem *next;
 } LinkItem_t;
 
@@ -87,6 +88,8 @@ extern const int SCAN_TOTAL_INTERVAL;			    //time between each scan step
 extern const int SCAN_DMR_SIMPLEX_MIN_INTERVAL;		//minimum time between steps when scanning DMR Simplex. (needs extra time to capture TDMA Pulsing)
 extern const int SCAN_FREQ_CHANGE_SETTLING_INTERVAL;//Time after frequency is changed before RSSI sampling starts
 extern const int SCAN_SKIP_CHANNEL_INTERVAL;		//This is actually just an implicit flag value to indicate the channel should be skipped
+extern const int SCAN_FAST_DWELL_TIME;				//time the Rx noise is sampled on each channel before stepping to the next one
+extern const int SCAN_FAST_SETTLING_TIME;			//time after the Rx frequency is changed before the Rx noise is sampled
 extern ScanState_t scanState;
 extern int scanTimer;
 extern bool scanActive;
@@ -116,8 +119,13 @@ void menuUtilityRenderQSOData(void);
 void menuUtilityRenderHeader(void);
 LinkItem_t *lastheardFindInList(uint32_t id);
 void lastheardInitList(void);
+void lastheardUpdateRestoredNames(void);
+void lastheardLogTick(void);
+void lastheardLogFlush(void);
+bool lastheardLogRead(uint32_t address, uint8_t *buf, uint32_t length);
 bool lastHeardListUpdate(uint8_t *dmrDataBuffer, bool forceOnHotspot);
 void lastHeardClearLastID(void);
+void lastheardUpdateBER(void);
 void drawRSSIBarGraph(void);
 void drawDMRMicLevelBarGraph(void);
 void setOverrideTGorPC(int tgOrPc, bool privateCall);
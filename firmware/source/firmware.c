@@ -21,6 +21,7 @@
  * @brief   Application entry point.
  */
 #include <main.h>
+#include <bootProfiler.h>
 #include <stdio.h>
 #include "board.h"
 #include "peripherals.h"
@@ -38,7 +39,9 @@ int main(void) {
   	/* Init board hardware. */
     BOARD_InitBootPins();
     BOARD_BootClockHSRUN();
+    bootProfilerInit();
     BOARD_InitBootPeripherals();
+    bootProfilerMark("Board");
 
     fw_init();
 
@@ -0,0 +1,365 @@
+/*
+ * Copyright (C)2019 Roger Clark. VK3KYY / G4KYF
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+ */
+
+#include <ambeRecorder.h>
+#include <HR-C6000.h>
+#include <settings.h>
+#include <speech_synthesis.h>
+#include <SPI_Flash.h>
+#include <trx.h>
+
+// DMR call recorder.
+//
+// The raw AMBE bursts (27 bytes per 60mS) which are received or transmitted are queued by the HR-C6000 task,
+// and the foreground packs them into 256 byte pages, with the call details, which are appended to a ring in the Flash.
+// Unlike the last heard log, pages are written during the call, as there is not enough RAM to hold a whole call.
+// Playback reads the pages of a call back and queues the bursts into the codec, which decodes them as if they were received.
+
+#define AMBE_RECORDER_QUEUE_SIZE	16// Must be a power of 2
+
+typedef struct
+{
+	bool    isTx;
+	uint8_t data[AMBE_RECORDER_BURST_LENGTH];
+} ambeRecorderBurst_t;
+
+// The recordings use the top 256KB of the Flash, which gives about 9 minutes of audio
+static const uint32_t AMBE_RECORDER_FLASH_START = 0xC0000;
+static const uint32_t AMBE_RECORDER_FLASH_SIZE  = 0x40000;
+static const uint32_t AMBE_RECORDER_NUM_PAGES   = (0x40000 / sizeof(ambeRecorderPage_t));
+
+static ambeRecorderBurst_t ambeRecorderQueue[AMBE_RECORDER_QUEUE_SIZE];
+static volatile uint32_t ambeRecorderQueueHead = 0;// Written by the HR-C6000 task
+static volatile uint32_t ambeRecorderQueueTail = 0;// Written by the foreground
+
+__attribute__((section(".data.$RAM2"))) static ambeRecorderPage_t ambeRecorderWritePage;
+__attribute__((section(".data.$RAM2"))) static ambeRecorderPage_t ambeRecorderPlayPage;
+
+static uint32_t ambeRecorderWritePos = 0;// Offset of the next free page, relative to AMBE_RECORDER_FLASH_START
+static uint32_t ambeRecorderSequence = 0;
+static bool ambeRecorderCallStart = true;
+static uint32_t ambeRecorderRxSrcId = 0;
+static uint32_t ambeRecorderRxDstId = 0;
+
+static bool ambeRecorderPlaying = false;
+static uint32_t ambeRecorderPlaySequence;
+static int ambeRecorderPlayBurst;
+
+// Called from the HR-C6000 task
+void ambeRecorderQueueBurst(const uint8_t *ambeBurst, bool isTx)
+{
+	uint32_t head = ambeRecorderQueueHead;
+
+	if ((nonVolatileSettings.callRecorder == 0) || ((head - ambeRecorderQueueTail) >= AMBE_RECORDER_QUEUE_SIZE))
+	{
+		return;
+	}
+
+	ambeRecorderBurst_t *burst = &ambeRecorderQueue[head & (AMBE_RECORDER_QUEUE_SIZE - 1)];
+	burst->isTx = isTx;
+	memcpy(burst->data, ambeBurst, AMBE_RECORDER_BURST_LENGTH);
+
+	ambeRecorderQueueHead = head + 1;
+}
+
+// Called by lastHeardListUpdate() with the details of the station being received
+void ambeRecorderSetRxCallInfo(uint32_t srcId, uint32_t dstId)
+{
+	ambeRecorderRxSrcId = srcId;
+	ambeRecorderRxDstId = dstId;
+}
+
+static bool ambeRecorderWriteCurrentPage(void)
+{
+	uint32_t address = AMBE_RECORDER_FLASH_START + ambeRecorderWritePos;
+	bool ok = true;
+
+	// Entering a new sector, it needs to be erased first (this discards the oldest recordings)
+	if ((ambeRecorderWritePos % 4096) == 0)
+	{
+		ok = SPI_Flash_eraseSector(address);
+	}
+
+	if (ok)
+	{
+		ambeRecorderWritePage.sequence = ambeRecorderSequence;
+		ok = SPI_Flash_writePage(address, (uint8_t *)&ambeRecorderWritePage);
+	}
+
+	// The page is discarded even if it could not be written, so that the log stays sequential
+	ambeRecorderSequence++;
+	ambeRecorderWritePos = (ambeRecorderWritePos + sizeof(ambeRecorderPage_t)) % AMBE_RECORDER_FLASH_SIZE;
+	ambeRecorderWritePage.numBursts = 0;
+
+	return ok;
+}
+
+static void ambeRecorderAddBurst(ambeRecorderBurst_t *burst)
+{
+	uint32_t srcId = (burst->isTx ? trxDMRID : ambeRecorderRxSrcId) & 0x00FFFFFF;
+	uint32_t dstId = (burst->isTx ? trxTalkGroupOrPcId : ambeRecorderRxDstId);
+	uint32_t flags = (burst->isTx ? AMBE_RECORDER_FLAG_TX : 0);
+
+	if (ambeRecorderWritePage.numBursts > 0)
+	{
+		uint32_t pageSrcId = (ambeRecorderWritePage.srcId & 0x00FFFFFF);
+		bool pageIsTx = ((ambeRecorderWritePage.srcId >> 24) & AMBE_RECORDER_FLAG_TX);
+
+		if ((pageIsTx == burst->isTx) && (pageSrcId == 0))
+		{
+			// The call details arrived after the first bursts of the call
+			ambeRecorderWritePage.srcId |= srcId;
+			ambeRecorderWritePage.dstId = dstId;
+		}
+		else if ((pageIsTx != burst->isTx) || (pageSrcId != srcId) || (ambeRecorderWritePage.dstId != dstId))
+		{
+			// A different call
+			ambeRecorderWriteCurrentPage();
+			ambeRecorderCallStart = true;
+		}
+	}
+
+	if (ambeRecorderWritePage.numBursts == 0)
+	{
+		if (ambeRecorderCallStart)
+		{
+			flags |= AMBE_RECORDER_FLAG_CALL_START;
+			ambeRecorderCallStart = false;
+		}
+		ambeRecorderWritePage.srcId = (flags << 24) | srcId;
+		ambeRecorderWritePage.dstId = dstId;
+	}
+
+	memcpy(ambeRecorderWritePage.data[ambeRecorderWritePage.numBursts], burst->data, AMBE_RECORDER_BURST_LENGTH);
+	ambeRecorderWritePage.numBursts++;
+
+	if (ambeRecorderWritePage.numBursts == AMBE_RECORDER_BURSTS_PER_PAGE)
+	{
+		ambeRecorderWriteCurrentPage();
+	}
+}
+
+// Find the newest page. As the pages are written sequentially, only the first page of each sector needs to be read to find the newest sector
+void ambeRecorderInit(void)
+{
+	const uint32_t pagesPerSector = (4096 / sizeof(ambeRecorderPage_t));
+	uint32_t sequence;
+	uint32_t newestSequence = 0;
+	uint32_t newestSector = 0;
+	bool found = false;
+
+	ambeRecorderQueueHead = ambeRecorderQueueTail = 0;
+	ambeRecorderWritePage.numBursts = 0;
+	ambeRecorderCallStart = true;
+	ambeRecorderPlaying = false;
+
+	for (uint32_t sector = 0; sector < (AMBE_RECORDER_FLASH_SIZE / 4096); sector++)
+	{
+		SPI_Flash_read(AMBE_RECORDER_FLASH_START + (sector * 4096), (uint8_t *)&sequence, sizeof(sequence));
+
+		if ((sequence != 0xFFFFFFFF) && ((found == false) || ((int32_t)(sequence - newestSequence) > 0)))
+		{
+			newestSequence = sequence;
+			newestSector = sector;
+			found = true;
+		}
+	}
+
+	if (found)
+	{
+		uint32_t lastPage = 0;
+
+		for (uint32_t page = 1; page < pagesPerSector; page++)
+		{
+			SPI_Flash_read(AMBE_RECORDER_FLASH_START + (newestSector * 4096) + (page * sizeof(ambeRecorderPage_t)), (uint8_t *)&sequence, sizeof(sequence));
+			if (sequence != (newestSequence + page))
+			{
+				break;
+			}
+			lastPage = page;
+		}
+
+		ambeRecorderSequence = newestSequence + lastPage + 1;
+		ambeRecorderWritePos = ((newestSector * 4096) + ((lastPage + 1) * sizeof(ambeRecorderPage_t))) % AMBE_RECORDER_FLASH_SIZE;
+	}
+	else
+	{
+		ambeRecorderSequence = 0;
+		ambeRecorderWritePos = 0;
+	}
+}
+
+static uint32_t ambeRecorderGetPageAddress(uint32_t sequence)
+{
+	uint32_t pagesBack = (ambeRecorderSequence - sequence);
+
+	return AMBE_RECORDER_FLASH_START +
+			((((ambeRecorderWritePos / sizeof(ambeRecorderPage_t)) + AMBE_RECORDER_NUM_PAGES - pagesBack) % AMBE_RECORDER_NUM_PAGES) * sizeof(ambeRecorderPage_t));
+}
+
+// Read the page with this sequence number, or just its header. False if it has been overwritten or erased since
+static bool ambeRecorderReadPage(uint32_t sequence, ambeRecorderPage_t *page, bool headerOnly)
+{
+	uint32_t pagesBack = (ambeRecorderSequence - sequence);
+
+	if ((pagesBack == 0) || (pagesBack > AMBE_RECORDER_NUM_PAGES))
+	{
+		return false;
+	}
+
+	SPI_Flash_read(ambeRecorderGetPageAddress(sequence), (uint8_t *)page, (headerOnly ? offsetof(ambeRecorderPage_t, data) : sizeof(ambeRecorderPage_t)));
+
+	return ((page->sequence == sequence) && (page->numBursts <= AMBE_RECORDER_BURSTS_PER_PAGE));
+}
+
+static bool ambeRecorderCanPlay(void)
+{
+	return ((trxGetMode() == RADIO_MODE_DIGITAL) && (settingsUsbMode != USB_MODE_HOTSPOT) &&
+			(trxIsTransmitting == false) && (slot_state == DMR_STATE_IDLE));
+}
+
+static void ambeRecorderPlaybackTick(void)
+{
+	if (ambeRecorderCanPlay() == false)
+	{
+		ambeRecorderStopPlayback();
+		return;
+	}
+
+	while (codecPlaybackGetSpace() > 0)
+	{
+		if (ambeRecorderPlayBurst >= ambeRecorderPlayPage.numBursts)
+		{
+			uint32_t callSrcId = (ambeRecorderPlayPage.srcId & ~(AMBE_RECORDER_FLAG_CALL_START << 24));
+
+			// The call continues on the next page, unless that is the start of another call
+			if ((ambeRecorderReadPage(ambeRecorderPlaySequence + 1, &ambeRecorderPlayPage, false) == false) ||
+					(ambeRecorderPlayPage.srcId != callSrcId))
+			{
+				ambeRecorderPlaying = false;// The codec plays out what has already been queued
+				return;
+			}
+			ambeRecorderPlaySequence++;
+			ambeRecorderPlayBurst = 0;
+			continue;
+		}
+
+		codecPlaybackPut(ambeRecorderPlayPage.data[ambeRecorderPlayBurst]);
+		ambeRecorderPlayBurst++;
+	}
+}
+
+void ambeRecorderTick(void)
+{
+	while (ambeRecorderQueueTail != ambeRecorderQueueHead)
+	{
+		ambeRecorderAddBurst(&ambeRecorderQueue[ambeRecorderQueueTail & (AMBE_RECORDER_QUEUE_SIZE - 1)]);
+		ambeRecorderQueueTail++;
+	}
+
+	// End of the call
+	if ((trxIsTransmitting == false) && (slot_state == DMR_STATE_IDLE))
+	{
+		if (ambeRecorderWritePage.numBursts > 0)
+		{
+			ambeRecorderWriteCurrentPage();
+		}
+		ambeRecorderCallStart = true;
+		ambeRecorderRxSrcId = 0;
+		ambeRecorderRxDstId = 0;
+	}
+
+	if (ambeRecorderPlaying)
+	{
+		ambeRecorderPlaybackTick();
+	}
+}
+
+// Store the partial page of the current call. Used when powering off.
+void ambeRecorderFlush(void)
+{
+	if (ambeRecorderWritePage.numBursts > 0)
+	{
+		ambeRecorderWriteCurrentPage();
+	}
+}
+
+// Play the newest recorded call from (or by, when transmitting) this DMR ID. 0 plays the newest call.
+bool ambeRecorderPlayLastCall(uint32_t srcId)
+{
+	uint32_t sequence = ambeRecorderSequence;
+	bool found = false;
+
+	if ((ambeRecorderCanPlay() == false) || ambeRecorderPlaying || codecPlaybackIsActive() || speechSynthesisIsSpeaking())
+	{
+		return false;
+	}
+
+	ambeRecorderFlush();
+
+	// Find the newest page of the call, searching back from the newest page
+	while (ambeRecorderReadPage(sequence - 1, &ambeRecorderPlayPage, true))
+	{
+		sequence--;
+		if ((srcId == 0) || ((ambeRecorderPlayPage.srcId & 0x00FFFFFF) == srcId))
+		{
+			found = true;
+			break;
+		}
+	}
+
+	if (found == false)
+	{
+		return false;
+	}
+
+	// Then back to its first page
+	while (((ambeRecorderPlayPage.srcId >> 24) & AMBE_RECORDER_FLAG_CALL_START) == 0)
+	{
+		uint32_t callSrcId = ambeRecorderPlayPage.srcId;
+
+		if ((ambeRecorderReadPage(sequence - 1, &ambeRecorderPlayPage, true) == false) ||
+				((ambeRecorderPlayPage.srcId & ~(AMBE_RECORDER_FLAG_CALL_START << 24)) != callSrcId))
+		{
+			break;// The start of the call has been overwritten
+		}
+		sequence--;
+	}
+
+	if (ambeRecorderReadPage(sequence, &ambeRecorderPlayPage, false) == false)
+	{
+		return false;
+	}
+
+	ambeRecorderPlaySequence = sequence;
+	ambeRecorderPlayBurst = 0;
+	ambeRecorderPlaying = true;
+
+	return true;
+}
+
+void ambeRecorderStopPlayback(void)
+{
+	ambeRecorderPlaying = false;
+	codecPlaybackStop();
+}
+
+bool ambeRecorderIsPlaying(void)
+{
+	return (ambeRecorderPlaying || codecPlaybackIsActive());
+}
@@ -0,0 +1,52 @@
+/*
+ * Copyright (C)2019 Roger Clark. VK3KYY / G4KYF
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+ */
+
+#include <string.h>
+#include <bootProfiler.h>
+#include "MK22F51212.h"
+
+// Boot timeline. The PIT is only started part way through the boot, so the time comes from the DWT cycle counter,
+// which is started as soon as the clocks have been set up. At 120MHz it wraps after 35 seconds, long after the boot has finished.
+
+bootProfiler_t bootProfiler;
+
+static uint32_t bootProfilerCyclesPerUs;
+
+void bootProfilerInit(void)
+{
+	CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+	DWT->CYCCNT = 0;
+	DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+
+	bootProfilerCyclesPerUs = (SystemCoreClock / 1000000U);
+	bootProfiler.numStages = 0;
+}
+
+// Record the end of a boot stage. The stages after the table is full are ignored
+void bootProfilerMark(const char *name)
+{
+	if (bootProfiler.numStages < BOOT_PROFILER_MAX_STAGES)
+	{
+		bootProfilerStage_t *stage = &bootProfiler.stages[bootProfiler.numStages];
+
+		stage->timeUs = (DWT->CYCCNT / bootProfilerCyclesPerUs);
+		strncpy(stage->name, name, BOOT_PROFILER_NAME_LENGTH - 1);
+		stage->name[BOOT_PROFILER_NAME_LENGTH - 1] = 0;
+		bootProfiler.numStages++;
+	}
+}
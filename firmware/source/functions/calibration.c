@@ -54,6 +54,28 @@ static const uint32_t EXT_vhf_dev_tone				= CALIBRATION_BASE + 0x0000CE;
 static const uint32_t POWER_ADDRESS_UHF_400MHZ 		= CALIBRATION_BASE + 0x00000B;//UHF is in 5Mhz bands starting at 400Mhz.
 static const uint32_t POWER_ADDRESS_VHF_135MHZ 		= CALIBRATION_BASE + 0x00007B;//VHF is in 5Mhz bands from 135Mhz (Only first 8 entries are used)
 
+static const uint32_t BAND_OFFSET_UHF					= 0x00000000;
+static const uint32_t BAND_OFFSET_VHF					= 0x00000070;
+
+#define CALIBRATION_TABLE_LENGTH 0xE0
+
+// RAM copy of the calibration table, and the per band values decoded from it.
+// This saves reading the Flash and decoding the values each time the frequency is changed.
+static uint8_t calibrationTable[CALIBRATION_TABLE_LENGTH];
+static bool calibrationTableLoaded = false;
+static calibrationBandValues_t calibrationBandValues[2];// UHF, VHF
+
+static bool calibrationRead(uint32_t address, uint8_t *buf, int size)
+{
+	if (calibrationTableLoaded && (address >= CALIBRATION_BASE) && ((address + size) <= (CALIBRATION_BASE + CALIBRATION_TABLE_LENGTH)))
+	{
+		memcpy(buf, &calibrationTable[address - CALIBRATION_BASE], size);
+		return true;
+	}
+
+	return SPI_Flash_read(address, buf, size);
+}
+
 /*
 calibrationStruct_t calibrationVHF;
 calibrationStruct_t calibrationUHF;
@@ -61,7 +83,7 @@ calibrationStruct_t calibrationUHF;
 void read_val_DACDATA_shift(int offset, uint8_t* val_shift)						//Sent to HRC6000 register 0x37. This sets the DMR received Audio Gain. (And Beep Volume)
 {																				//Effective for DMR Receive Only.
 	uint8_t buffer[1];															//only the low 4 bits are used. 1.5dB change per increment 0-31
-	SPI_Flash_read(EXT_DACDATA_shift+offset,buffer,1);
+	calibrationRead(EXT_DACDATA_shift+offset,buffer,1);
 
 	*val_shift=buffer[0]+1;
 	if (*val_shift>31)
@@ -74,7 +96,7 @@ void read_val_DACDATA_shift(int offset, uint8_t* val_shift)						//Sent to HRC60
 void read_val_twopoint_mod(int offset, uint8_t* val_0x47, uint8_t* val_0x48)      // Sent to HRC6000 register 0x47 and 0x48 to set the DC level of the Mod1 output. This sets the frequency of the AT1846 Reference Oscillator.
 {																				  // Effective for DMR and FM Receive and Transmit. Calibrates the receive and transmit frequencies.
 	uint8_t buffer[2];															  // Only one setting should be required for all frequencies but the Cal table has separate entries for VHF and UHF.
-	SPI_Flash_read(EXT_twopoint_mod+offset,buffer,2);
+	calibrationRead(EXT_twopoint_mod+offset,buffer,2);
 	*val_0x47=buffer[0];
 	*val_0x48=buffer[1];
 }
@@ -82,56 +104,56 @@ void read_val_twopoint_mod(int offset, uint8_t* val_0x47, uint8_t* val_0x48)
 void read_val_Q_MOD2_offset(int offset, uint8_t* val_0x04)						  //Sent to the HRC6000 register 0x04 which is the offset value for the Mod 2 output.
 {																				  //However according to the schematics the Mod 2 output is not connected.
 	uint8_t buffer[1];															  //Therefore the function of this setting is unclear. (possible datasheet error?)
-	SPI_Flash_read(EXT_Q_MOD2_offset+offset,buffer,1);							  //The Cal table has one entry for each band and this is almost identical to 0x47 above.
+	calibrationRead(EXT_Q_MOD2_offset+offset,buffer,1);							  //The Cal table has one entry for each band and this is almost identical to 0x47 above.
 	*val_0x04=buffer[0];
 }
 
 void read_val_phase_reduce(int offset, uint8_t* val_0x46)						  //Sent to the HRC6000 register 0x46. This adjusts the level of the DMR Modulation on the MOD1 output.
 {																				  //Mod 1 controls the AT1846 Reference oscillator so this is effectively the deviation setting for DMR.
 	uint8_t buffer[1];															  //Because it modulates the reference oscillator the deviation will change depending on the frequency being used.
-	SPI_Flash_read(EXT_phase_reduce+offset,buffer,1);							  //Only affects DMR Transmit. The Cal table has 8 calibration values for each band.
+	calibrationRead(EXT_phase_reduce+offset,buffer,1);							  //Only affects DMR Transmit. The Cal table has 8 calibration values for each band.
 	*val_0x46=buffer[0];
 }
 
 void read_val_pga_gain(int offset, uint8_t* value)								  //Sent to AT1846S register 0x0a bits 6-10. Sets Voice Analogue Gain for FM Transmit.
 {
 	uint8_t buffer[1];
-	SPI_Flash_read(EXT_pga_gain+offset,buffer,1);
+	calibrationRead(EXT_pga_gain+offset,buffer,1);
 	*value=buffer[0] & 0x1f;
 }
 
 void read_val_voice_gain_tx(int offset, uint8_t* value)							  //Sent to AT1846S register 0x41 bits 0-6. Sets Voice Digital Gain for FM Transmit.
 {
 	uint8_t buffer[1];
-	SPI_Flash_read(EXT_voice_gain_tx+offset,buffer,1);
+	calibrationRead(EXT_voice_gain_tx+offset,buffer,1);
 	*value=buffer[0] & 0x7f;
 }
 
 void read_val_gain_tx(int offset, uint8_t* value)   							//Sent to AT1846S register 0x44 bits 8-11. Sets Voice Digital Gain after ADC for FM Transmit.
 {
 	uint8_t buffer[1];
-	SPI_Flash_read(EXT_gain_tx+offset,buffer,1);
+	calibrationRead(EXT_gain_tx+offset,buffer,1);
 	*value=buffer[0] & 0x0f;
 }
 
 void read_val_padrv_ibit(int offset, uint8_t* value)							//Sent to AT1846S register 0x0a bits 11-14. Sets PA Power Control for DMR and FM Transmit.
 {
 	uint8_t buffer[1];
-	SPI_Flash_read(EXT_padrv_ibit+offset,buffer,1);
+	calibrationRead(EXT_padrv_ibit+offset,buffer,1);
 	*value=buffer[0] & 0x0f;
 }
 
 void read_val_xmitter_dev_wideband(int offset, uint16_t* value)					//Sent to AT1846S register 0x59 bits 6-15. Sets Deviation for Wideband FM Transmit
 {
 	uint8_t buffer[2];
-	SPI_Flash_read(EXT_xmitter_dev_wideband+offset,buffer,2);
+	calibrationRead(EXT_xmitter_dev_wideband+offset,buffer,2);
 	*value=buffer[0] + ((buffer[1] & 0x03) << 8);
 }
 
 void read_val_xmitter_dev_narrowband(int offset, uint16_t* value)				//Sent to AT1846S register 0x59 bits 6-15. Sets Deviation for NarrowBand FM Transmit
 {
 	uint8_t buffer[2];
-	SPI_Flash_read(EXT_xmitter_dev_narrowband+offset,buffer,2);
+	calibrationRead(EXT_xmitter_dev_narrowband+offset,buffer,2);
 	*value=buffer[0] + ((buffer[1] & 0x03) << 8);
 }
 
@@ -147,69 +169,69 @@ void read_val_dev_tone(int index, uint8_t *value)
 	{
 		address = EXT_vhf_dev_tone+index;
 	}
-	SPI_Flash_read(address, value, 1);
+	calibrationRead(address, value, 1);
 }
 
 void read_val_dac_vgain_analog(int offset, uint8_t* value)					//Sent to AT1846S register 0x44 bits 0-3. Sets Digital Audio Gain for FM and DMR Receive.
 {
 	uint8_t buffer[1];
-	SPI_Flash_read(EXT_dac_vgain_analog+offset,buffer,1);
+	calibrationRead(EXT_dac_vgain_analog+offset,buffer,1);
 	*value=buffer[0] & 0x0f;
 }
 
 void read_val_volume_analog(int offset, uint8_t* value)						//Sent to AT1846S register 0x44 bits 4-7. Sets Analogue Audio Gain for FM and DMR Receive.
 {
 	uint8_t buffer[1];
-	SPI_Flash_read(EXT_volume_analog+offset,buffer,1);
+	calibrationRead(EXT_volume_analog+offset,buffer,1);
 	*value=buffer[0] & 0x0f;
 }
 
 void read_val_noise1_th_wideband(int offset, uint16_t* value)				//Sent to AT1846S register 0x48. Sets Noise 1 Threshold  for FM Wideband Receive.
 {
 	uint8_t buffer[2];
-	SPI_Flash_read(EXT_noise1_th_wideband+offset,buffer,2);
+	calibrationRead(EXT_noise1_th_wideband+offset,buffer,2);
 	*value=((buffer[0] & 0x7f) << 7) + ((buffer[1] & 0x7f) << 0);
 }
 
 void read_val_noise2_th_wideband(int offset, uint16_t* value)				//Sent to AT1846S register 0x60. Sets Noise 2 Threshold  for FM  Wideband Receive.
 {
 	uint8_t buffer[2];
-	SPI_Flash_read(EXT_noise2_th_wideband+offset,buffer,2);
+	calibrationRead(EXT_noise2_th_wideband+offset,buffer,2);
 	*value=((buffer[0] & 0x7f) << 7) + ((buffer[1] & 0x7f) << 0);
 }
 
 void read_val_rssi3_th_wideband(int offset, uint16_t* value)				//Sent to AT1846S register 0x3F. Sets RSSI3 Threshold  for  Wideband Receive.
 {
 	uint8_t buffer[2];
-	SPI_Flash_read(EXT_rssi3_th_wideband+offset,buffer,2);
+	calibrationRead(EXT_rssi3_th_wideband+offset,buffer,2);
 	*value=((buffer[0] & 0x7f) << 7) + ((buffer[1] & 0x7f) << 0);
 }
 
 void read_val_noise1_th_narrowband(int offset, uint16_t* value)				//Sent to AT1846S register 0x48. Sets Noise 1 Threshold  for FM Narrowband Receive.
 {
 	uint8_t buffer[2];
-	SPI_Flash_read(EXT_noise1_th_narrowband+offset,buffer,2);
+	calibrationRead(EXT_noise1_th_narrowband+offset,buffer,2);
 	*value=((buffer[0] & 0x7f) << 7) + ((buffer[1] & 0x7f) << 0);
 }
 
 void read_val_noise2_th_narrowband(int offset, uint16_t* value)				//Sent to AT1846S register 0x60. Sets Noise 2 Threshold  for FM  Narrowband  Receive.
 {
 	uint8_t buffer[2];
-	SPI_Flash_read(EXT_noise2_th_narrowband+offset,buffer,2);
+	calibrationRead(EXT_noise2_th_narrowband+offset,buffer,2);
 	*value=((buffer[0] & 0x7f) << 7) + ((buffer[1] & 0x7f) << 0);
 }
 
 void read_val_rssi3_th_narrowband(int offset, uint16_t* value)				//Sent to AT1846S register 0x3F. Sets RSSI3 Threshold  for  Narrowband Receive.
 {
 	uint8_t buffer[2];
-	SPI_Flash_read(EXT_rssi3_th_narrowband+offset,buffer,2);
+	calibrationRead(EXT_rssi3_th_narrowband+offset,buffer,2);
 	*value=((buffer[0] & 0x7f) << 7) + ((buffer[1] & 0x7f) << 0);
 }
 
 void read_val_squelch_th(int offset, int mod, uint16_t* value)				//Sent to At1846S register 0x49. sets squelch open threshold for FM Receive.
 {																			//8 Cal Table Entries for each band. Frequency Dependent.
 	uint8_t buffer[1];
-	SPI_Flash_read(EXT_squelch_th+offset,buffer,1);
+	calibrationRead(EXT_squelch_th+offset,buffer,1);
 	uint8_t v1 = buffer[0]-mod;
 	uint8_t v2 = buffer[0]-mod-3;
 	if ( v1 >= 127 || v2 >= 127 || v1 < v2 )
@@ -262,7 +284,7 @@ bool calibrationGetPowerForFrequency(int freq, calibrationPowerValues_t *powerSe
 		address = POWER_ADDRESS_VHF_135MHZ +   (address * 2);
 	}
 
-	SPI_Flash_read(address,buffer,2);
+	calibrationRead(address,buffer,2);
 	powerSettings->lowPower 	= buffer[0] * 16;
 	powerSettings->highPower 	= buffer[1] * 16;
 
@@ -282,7 +304,7 @@ bool calibrationGetRSSIMeterParams(calibrationRSSIMeter_t *rssiMeterValues)
 		address = CALIBRATION_BASE + 0x0C3;
 	}
 
-	if (SPI_Flash_read(address,(uint8_t *)rssiMeterValues,2))
+	if (calibrationRead(address,(uint8_t *)rssiMeterValues,2))
 	{
 		return true;
 	}
@@ -316,7 +338,6 @@ const uint8_t MARKER_BYTES[] = {0xA0 ,0x0F ,0xC0 ,0x12 ,0xA0 ,0x0F ,0xC0 ,0x12};
 
 #endif
 
-	const int CALIBRATION_TABLE_LENGTH = 0xE0;
 	uint8_t tmp[CALIBRATION_TABLE_LENGTH];
 
 	if (SPI_Flash_read(CALIBRATION_BASE,(uint8_t *)tmp,MARKER_BYTES_LENGTH))
@@ -343,3 +364,62 @@ const uint8_t MARKER_BYTES[] = {0xA0 ,0x0F ,0xC0 ,0x12 ,0xA0 ,0x0F ,0xC0 ,0x12};
 
 	return false; // Something went wrong!
 }
+
+static void calibrationDecodeBandValues(uint32_t band_offset, calibrationBandValues_t *values)
+{
+	read_val_DACDATA_shift(band_offset, &values->DACDataShift);
+	read_val_Q_MOD2_offset(band_offset, &values->QMod2Offset);
+	read_val_twopoint_mod(band_offset, &values->twoPointMod47, &values->twoPointMod48);
+
+	read_val_pga_gain(band_offset, &values->pgaGain);
+	read_val_voice_gain_tx(band_offset, &values->voiceGainTx);
+	read_val_gain_tx(band_offset, &values->gainTx);
+	read_val_padrv_ibit(band_offset, &values->padrvIbit);
+	read_val_dac_vgain_analog(band_offset, &values->dacVgainAnalog);
+	read_val_volume_analog(band_offset, &values->volumeAnalog);
+
+	read_val_xmitter_dev_narrowband(band_offset, &values->xmitterDev[CALIBRATION_NARROWBAND]);
+	read_val_xmitter_dev_wideband(band_offset, &values->xmitterDev[CALIBRATION_WIDEBAND]);
+	read_val_noise1_th_narrowband(band_offset, &values->noise1Th[CALIBRATION_NARROWBAND]);
+	read_val_noise1_th_wideband(band_offset, &values->noise1Th[CALIBRATION_WIDEBAND]);
+	read_val_noise2_th_narrowband(band_offset, &values->noise2Th[CALIBRATION_NARROWBAND]);
+	read_val_noise2_th_wideband(band_offset, &values->noise2Th[CALIBRATION_WIDEBAND]);
+	read_val_rssi3_th_narrowband(band_offset, &values->rssi3Th[CALIBRATION_NARROWBAND]);
+	read_val_rssi3_th_wideband(band_offset, &values->rssi3Th[CALIBRATION_WIDEBAND]);
+
+	for (int i = 0; i < CALIBRATION_NUM_FREQ_OFFSETS; i++)
+	{
+		read_val_phase_reduce(band_offset + i, &values->phaseReduce[i]);
+		read_val_squelch_th(band_offset + i, 3, &values->squelchTh[i][CALIBRATION_NARROWBAND]);
+		read_val_squelch_th(band_offset + i, 0, &values->squelchTh[i][CALIBRATION_WIDEBAND]);
+	}
+}
+
+// Load the calibration table into RAM, and decode the values for both bands.
+// Needs to be called again if the calibration data is changed in the Flash.
+bool calibrationInit(void)
+{
+	calibrationTableLoaded = false;
+
+	if (!SPI_Flash_read(CALIBRATION_BASE, calibrationTable, CALIBRATION_TABLE_LENGTH))
+	{
+		return false;
+	}
+	calibrationTableLoaded = true;
+
+	calibrationDecodeBandValues(BAND_OFFSET_UHF, &calibrationBandValues[0]);
+	calibrationDecodeBandValues(BAND_OFFSET_VHF, &calibrationBandValues[1]);
+
+	return true;
+}
+
+// The 220Mhz band uses the VHF calibration
+const calibrationBandValues_t *calibrationGetBandValues(int band)
+{
+	return &calibrationBandValues[((band == RADIO_BAND_UHF) ? 0 : 1)];
+}
+
+bool calibrationIsInCalibrationSector(uint32_t address)
+{
+	return ((address & ~(0xFFF)) == CALIBRATION_BASE);
+}
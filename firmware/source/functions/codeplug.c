@@ -35,6 +35,7 @@ const int CODEPLUG_ZONE_MAX_COUNT = 250;
 const int CODEPLUG_CHANNEL_DATA_SIZE = 56;
 const int CODEPLUG_ADDR_CHANNEL_EEPROM = 0x3790;
 const int CODEPLUG_ADDR_CHANNEL_FLASH = 0x7B1C0;
+const int CODEPLUG_CHANNELS_MAX = 1024;
 
 const int CODEPLUG_ADDR_RX_GROUP = 0x8D6A0;//
 const int CODEPLUG_RX_GROUP_LEN = 0x50;
@@ -80,10 +81,18 @@ typedef struct
 	int numTGContacts;
 	int numPCContacts;
 	codeplugContactCache_t contactsLookupCache[1024];
+	uint16_t pcSortedIndex[1024];// Positions in contactsLookupCache of the PC contacts, in ascending ID order
 } codeplugContactsCache_t;
 
 __attribute__((section(".data.$RAM2"))) codeplugContactsCache_t codeplugContactsCache;
 
+// Reading the 1024 contacts takes a long time, so the cache is built in the background after the first screen is shown,
+// CODEPLUG_CONTACTS_CACHE_BATCH contacts on each main loop tick. Anything which needs it before then completes it at once.
+#define CODEPLUG_CONTACTS_CACHE_BATCH 64
+static int codeplugContactsCacheNextIndex = 0;
+static volatile bool codeplugContactsCacheComplete = false;
+static void codeplugContactsCacheEnsureComplete(void);
+
 
 uint32_t byteSwap32(uint32_t n)
 {
@@ -152,17 +161,51 @@ void codeplugUtilConvertStringToBuf(char *inBuf,char *outBuf,int len)
 	return;
 }
 
-int codeplugZonesGetCount(void)
+// RAM copy of the channel In Use bitmaps (8 banks of 128 channels) and the Zone In Use data.
+// Its loaded the first time its needed, and reloaded after the CPS has written to the EEPROM or Flash
+typedef struct
 {
-	uint8_t buf[CODEPLUG_ADDR_EX_ZONE_INUSE_PACKED_DATA_SIZE];
-	int numZones = 0;
+	bool loaded;
+	int numZones;
+	uint8_t zonesInUse[32];
+	uint8_t channelsValid[1024 / 8];
+} codeplugChannelsCache_t;
+
+static codeplugChannelsCache_t codeplugChannelsCache = { .loaded = false };
+
+static void codeplugChannelsCacheLoad(void)
+{
+	if (codeplugChannelsCache.loaded)
+	{
+		return;
+	}
+
+	// Bank 0 is in the EEPROM, banks 1 to 7 are in the Flash
+	EEPROM_Read(CODEPLUG_ADDR_CHANNEL_EEPROM-16,(uint8_t *)&codeplugChannelsCache.channelsValid[0],16);
+	for(int channelbank=1;channelbank<(CODEPLUG_CHANNELS_MAX / 128);channelbank++)
+	{
+		SPI_Flash_read(CODEPLUG_ADDR_CHANNEL_FLASH-16+(channelbank-1)*(128*CODEPLUG_CHANNEL_DATA_SIZE+16),(uint8_t *)&codeplugChannelsCache.channelsValid[channelbank*16],16);
+	}
 
-	EEPROM_Read(CODEPLUG_ADDR_EX_ZONE_INUSE_PACKED_DATA, (uint8_t*)&buf, CODEPLUG_ADDR_EX_ZONE_INUSE_PACKED_DATA_SIZE);
+	EEPROM_Read(CODEPLUG_ADDR_EX_ZONE_INUSE_PACKED_DATA, (uint8_t*)&codeplugChannelsCache.zonesInUse, CODEPLUG_ADDR_EX_ZONE_INUSE_PACKED_DATA_SIZE);
+	codeplugChannelsCache.numZones = 0;
 	for(int i=0;i<CODEPLUG_ADDR_EX_ZONE_INUSE_PACKED_DATA_SIZE;i++)
 	{
-		numZones += __builtin_popcount(buf[i]);
+		codeplugChannelsCache.numZones += __builtin_popcount(codeplugChannelsCache.zonesInUse[i]);
 	}
-	return numZones+1; // Add one extra zone to allow for the special 'All Channels' Zone
+
+	codeplugChannelsCache.loaded = true;
+}
+
+void codeplugChannelsCacheInvalidate(void)
+{
+	codeplugChannelsCache.loaded = false;
+}
+
+int codeplugZonesGetCount(void)
+{
+	codeplugChannelsCacheLoad();
+	return codeplugChannelsCache.numZones+1; // Add one extra zone to allow for the special 'All Channels' Zone
 }
 
 void codeplugZoneGetDataForNumber(int zoneNum, struct_codeplugZone_t *returnBuf)
@@ -184,32 +227,25 @@ void codeplugZoneGetDataForNumber(int zoneNum, struct_codeplugZone_t *returnBuf)
 	{
 		// Need to find the index into the Zones data for the specific Zone number.
 		// Because the Zones data is not guaranteed to be packed by the CPS (though we should attempt to make the CPS always pack the Zones)
-
-		// Read the In Use data which is the first 32 byes of the Zones data
-		uint8_t inUseBuf[CODEPLUG_ADDR_EX_ZONE_INUSE_PACKED_DATA_SIZE];
-		EEPROM_Read(CODEPLUG_ADDR_EX_ZONE_INUSE_PACKED_DATA, (uint8_t*)&inUseBuf, CODEPLUG_ADDR_EX_ZONE_INUSE_PACKED_DATA_SIZE);
-
-		int count=-1;// Need to start counting at -1 because the Zone number is zero indexed
+		int count=zoneNum;
 		int foundIndex=-1;
 
-		// Go though each byte in the In Use table
-		for(int i=0;(i<32 && foundIndex==-1);i++)
+		// Skip whole bytes of the In Use table, then find the bit within the byte which holds the Zone
+		for(int i=0;i<CODEPLUG_ADDR_EX_ZONE_INUSE_PACKED_DATA_SIZE;i++)
 		{
-			// Go though each binary bit, counting them one by one
-			for(int j=0;j<8;j++)
+			uint8_t inUse = codeplugChannelsCache.zonesInUse[i];
+			int bitsInByte = __builtin_popcount(inUse);
+
+			if (count < bitsInByte)
 			{
-				if ((inUseBuf[i] & 0x01 )==0x01)
+				while (count-- > 0)
 				{
-					count++;
-					if (count == zoneNum)
-					{
-						// found it. So save the index before we exit the "for" loops
-						foundIndex = (i * 8) + j;
-						break;// Will break out of this loop, but the outer loop breaks becuase it also checks for foundIndex
-					}
+					inUse &= inUse - 1;// clear the lowest set bit
 				}
-				inUseBuf[i] = inUseBuf[i]>>1;
+				foundIndex = (i * 8) + __builtin_ctz(inUse);
+				break;
 			}
+			count -= bitsInByte;
 		}
 
 		// IMPORTANT. read size is different from the size of the data, because I added a extra property to the struct to hold the number of channels in the zone.
@@ -231,63 +267,78 @@ void codeplugZoneGetDataForNumber(int zoneNum, struct_codeplugZone_t *returnBuf)
 
 bool codeplugChannelIndexIsValid(int index)
 {
-	uint8_t bitarray[16];
-
-	index--;
-	int channelbank=index/128;
-	int channeloffset=index%128;
-
-	if(channelbank==0)
-	{
-		EEPROM_Read(CODEPLUG_ADDR_CHANNEL_EEPROM-16,(uint8_t *)bitarray,16);
-	}
-	else
-	{
-		SPI_Flash_read(CODEPLUG_ADDR_CHANNEL_FLASH-16+(channelbank-1)*(128*CODEPLUG_CHANNEL_DATA_SIZE+16),(uint8_t *)bitarray,16);
-	}
-
-	int byteno=channeloffset/8;
-	int bitno=channeloffset%8;
-	if (((bitarray[byteno] >> bitno) & 0x01) == 0)
+	if ((index < 1) || (index > CODEPLUG_CHANNELS_MAX))
 	{
 		return false;
 	}
-	else
-	{
-		return true;
-	}
+
+	codeplugChannelsCacheLoad();
+
+	index--;
+	return (((codeplugChannelsCache.channelsValid[index/8] >> (index%8)) & 0x01) != 0);
 }
 
 void codeplugChannelIndexSetValid(int index)
 {
-	uint8_t bitarray[16];
+	uint8_t *bitarray;
+
+	codeplugChannelsCacheLoad();
 
 	index--;
 	int channelbank=index/128;
 	int channeloffset=index%128;
 
+	// Update the RAM copy, then write the whole bank bitmap back to where it came from
+	bitarray = &codeplugChannelsCache.channelsValid[channelbank*16];
+	bitarray[channeloffset/8] |= 1 << (channeloffset%8);
+
 	if(channelbank==0)
 	{
-		EEPROM_Read(CODEPLUG_ADDR_CHANNEL_EEPROM-16,(uint8_t *)bitarray,16);
+		EEPROM_Write(CODEPLUG_ADDR_CHANNEL_EEPROM-16,bitarray,16);
 	}
 	else
 	{
-		SPI_Flash_read(CODEPLUG_ADDR_CHANNEL_FLASH-16+(channelbank-1)*(128*CODEPLUG_CHANNEL_DATA_SIZE+16),(uint8_t *)bitarray,16);
+		SPI_Flash_write(CODEPLUG_ADDR_CHANNEL_FLASH-16+(channelbank-1)*(128*CODEPLUG_CHANNEL_DATA_SIZE+16),bitarray,16);
 	}
+}
 
-	int byteno=channeloffset/8;
-	int bitno=channeloffset%8;
+// Returns the next valid channel (1 to 1024) in the specified direction, wrapping around at either end.
+// Returns the same index if it is the only valid channel, or 0 if there are no valid channels at all.
+int codeplugChannelGetNextValidIndex(int index, int direction)
+{
+	int pos = index - 1;
+	int remaining = CODEPLUG_CHANNELS_MAX;
 
-	bitarray[byteno] |= 1 << bitno;
+	codeplugChannelsCacheLoad();
 
-	if(channelbank==0)
-	{
-		EEPROM_Write(CODEPLUG_ADDR_CHANNEL_EEPROM-16,(uint8_t *)bitarray,16);
-	}
-	else
+	while (remaining > 0)
 	{
-		SPI_Flash_write(CODEPLUG_ADDR_CHANNEL_FLASH-16+(channelbank-1)*(128*CODEPLUG_CHANNEL_DATA_SIZE+16),(uint8_t *)bitarray,16);
+		pos += direction;
+		if (pos >= CODEPLUG_CHANNELS_MAX)
+		{
+			pos = 0;
+		}
+		else if (pos < 0)
+		{
+			pos = CODEPLUG_CHANNELS_MAX - 1;
+		}
+		remaining--;
+
+		uint8_t bits = codeplugChannelsCache.channelsValid[pos/8];
+		if (bits == 0)
+		{
+			// Nothing valid in this byte, jump to its last bit in the search direction
+			int skip = ((direction > 0) ? (7 - (pos%8)) : (pos%8));
+			pos += skip * direction;
+			remaining -= skip;
+		}
+		else if ((bits >> (pos%8)) & 0x01)
+		{
+			return pos + 1;
+		}
 	}
+
+	return 0;
 }
 
 void codeplugChannelGetDataForIndex(int index, struct_codeplugChannel_t *channelBuf)
@@ -460,13 +511,21 @@ void codeplugRxGroupGetDataForIndex(int index, struct_codeplugRxGroup_t *rxGroup
 	SPI_Flash_read(CODEPLUG_ADDR_RX_GROUP + index*(dataSizeInCodeplug),(uint8_t *)rxGroupBuf,dataSizeInCodeplug);
 	for(i=0;i<32;i++)
 	{
-		codeplugContactGetDataForIndex(rxGroupBuf->contacts[i],&contactData);
-		rxGroupBuf->NOT_IN_CODEPLUG_contactsTG[i] = contactData.tgNumber;
 		// Empty groups seem to be filled with zeros
 		if (rxGroupBuf->contacts[i] == 0)
 		{
 			break;
 		}
+		codeplugContactGetDataForIndex(rxGroupBuf->contacts[i],&contactData);
+
+		// Insertion sort, so the Rx filter can do a binary search
+		int j = i;
+		while (j > 0 && rxGroupBuf->NOT_IN_CODEPLUG_sortedTGs[j-1] > contactData.tgNumber)
+		{
+			rxGroupBuf->NOT_IN_CODEPLUG_sortedTGs[j] = rxGroupBuf->NOT_IN_CODEPLUG_sortedTGs[j-1];
+			j--;
+		}
+		rxGroupBuf->NOT_IN_CODEPLUG_sortedTGs[j] = contactData.tgNumber;
 	}
 	rxGroupBuf->NOT_IN_CODEPLUG_numTGsInGroup = i;
 }
@@ -475,6 +534,8 @@ void codeplugRxGroupGetDataForIndex(int index, struct_codeplugRxGroup_t *rxGroup
 
 int codeplugContactsGetCount(int callType) // 0:TG 1:PC
 {
+	codeplugContactsCacheEnsureComplete();
+
 	if (callType == CONTACT_CALLTYPE_PC)
 	{
 		return codeplugContactsCache.numPCContacts;
@@ -489,6 +550,8 @@ int codeplugContactGetDataForNumber(int number, int callType, struct_codeplugCon
 {
 	int pos = 0;
 
+	codeplugContactsCacheEnsureComplete();
+
 	for (int i = 0; i < 1024; i++)
 	{
 		if ((codeplugContactsCache.contactsLookupCache[i].tgOrPCNum>>24) == callType)
@@ -508,6 +571,8 @@ int codeplugContactGetDataForNumber(int number, int callType, struct_codeplugCon
 
 int codeplugContactIndexByTGorPC(int tgorpc, int callType, struct_codeplugContact_t *contact)
 {
+	codeplugContactsCacheEnsureComplete();
+
 	int numContacts =  codeplugContactsCache.numTGContacts + codeplugContactsCache.numPCContacts;
 	for (int i = 0; i < numContacts; i++)
 	{
@@ -520,30 +585,82 @@ int codeplugContactIndexByTGorPC(int tgorpc, int callType, struct_codeplugContac
 	return 0;
 }
 
+// Called on every received DMR burst when the Rx filter is set to Digital Contacts, so this is a binary search of the sorted PC index.
+// The loop always runs log2(n) times and the comparison compiles to a conditional select rather than a branch
 bool codeplugContactsContainsPC(uint32_t pc)
 {
-	int numContacts =  codeplugContactsCache.numTGContacts + codeplugContactsCache.numPCContacts;
+	const uint16_t *base = codeplugContactsCache.pcSortedIndex;
+	int n = codeplugContactsCache.numPCContacts;
+
+	// This is called from the HR-C6000 task, so it can't build the cache
+	if ((n == 0) || !codeplugContactsCacheComplete)
+	{
+		return false;
+	}
+
 	pc = pc & 0x00FFFFFF;
 	pc = pc | (CONTACT_CALLTYPE_PC << 24);
 
+	while (n > 1)
+	{
+		int half = n / 2;
+		base = (codeplugContactsCache.contactsLookupCache[base[half]].tgOrPCNum <= pc) ? (base + half) : base;
+		n -= half;
+	}
+	return (codeplugContactsCache.contactsLookupCache[*base].tgOrPCNum == pc);
+}
+
+// Rebuild the sorted index of the PC contacts. This needs to be done whenever the contacts cache changes,
+// as inserting or removing a contact moves the ones after it in the cache
+static void codeplugContactsCacheBuildPCIndex(void)
+{
+	int numContacts =  codeplugContactsCache.numTGContacts + codeplugContactsCache.numPCContacts;
+	int numPC = 0;
+
 	for (int i = 0; i < numContacts; i++)
 	{
-		if (codeplugContactsCache.contactsLookupCache[i].tgOrPCNum == pc)
+		uint32_t id = codeplugContactsCache.contactsLookupCache[i].tgOrPCNum;
+
+		if ((id>>24) == CONTACT_CALLTYPE_PC)
 		{
-			return true;
+			int j = numPC;
+			while (j > 0 && codeplugContactsCache.contactsLookupCache[codeplugContactsCache.pcSortedIndex[j-1]].tgOrPCNum > id)
+			{
+				j--;
+			}
+			memmove(&codeplugContactsCache.pcSortedIndex[j+1],&codeplugContactsCache.pcSortedIndex[j],(numPC - j) * sizeof(uint16_t));
+			codeplugContactsCache.pcSortedIndex[j] = i;
+			numPC++;
 		}
 	}
-	return false;
 }
 
 void codeplugInitContactsCache(void)
 {
-	struct_codeplugContact_t contact;
-	int codeplugNumContacts=0;
+	codeplugContactsCacheComplete = false;
+	codeplugContactsCacheNextIndex = 0;
 	codeplugContactsCache.numTGContacts=0;
 	codeplugContactsCache.numPCContacts=0;
+}
+
+// Read up to maxContacts more contacts into the cache. Returns true once the whole cache has been built
+static bool codeplugContactsCacheBuild(int maxContacts)
+{
+	struct_codeplugContact_t contact;
+	int codeplugNumContacts = codeplugContactsCache.numTGContacts + codeplugContactsCache.numPCContacts;
+	int lastIndex = codeplugContactsCacheNextIndex + maxContacts;
+
+	if (codeplugContactsCacheComplete)
+	{
+		return true;
+	}
+
+	if (lastIndex > 1024)
+	{
+		lastIndex = 1024;
+	}
 
-	for(int i=0;i<1024;i++)
+	for(int i=codeplugContactsCacheNextIndex;i<lastIndex;i++)
 	{
 		SPI_Flash_read((CODEPLUG_ADDR_CONTACTS + (i * CODEPLUG_CONTACT_DATA_LEN)), (uint8_t *)&contact, 16+4+1);// Name + TG/ID + Call type
 		if (contact.name[0]!=0xFF)
@@ -562,10 +679,31 @@ void codeplugInitContactsCache(void)
 			codeplugNumContacts++;
 		}
 	}
+	codeplugContactsCacheNextIndex = lastIndex;
+
+	if (codeplugContactsCacheNextIndex >= 1024)
+	{
+		codeplugContactsCacheBuildPCIndex();
+		codeplugContactsCacheComplete = true;
+	}
+
+	return codeplugContactsCacheComplete;
+}
+
+static void codeplugContactsCacheEnsureComplete(void)
+{
+	codeplugContactsCacheBuild(1024);
+}
+
+bool codeplugContactsCacheTick(void)
+{
+	return codeplugContactsCacheBuild(CODEPLUG_CONTACTS_CACHE_BATCH);
 }
 
 void codeplugContactsCacheUpdateOrInsertContactAt(int index, struct_codeplugContact_t *contact)
 {
+	codeplugContactsCacheEnsureComplete();
+
 	int numContacts =  codeplugContactsCache.numTGContacts + codeplugContactsCache.numPCContacts;
 	int numContactsMinus1 = numContacts-1;
 
@@ -640,6 +778,8 @@ void codeplugContactsCacheUpdateOrInsertContactAt(int index, struct_codeplugCont
 
 void codeplugContactsCacheRemoveContactAt(int index)
 {
+	codeplugContactsCacheEnsureComplete();
+
 	int numContacts =  codeplugContactsCache.numTGContacts + codeplugContactsCache.numPCContacts;
 	for(int i=0;i<numContacts;i++)
 	{
@@ -665,6 +805,8 @@ int codeplugContactGetFreeIndex(void)
 	int i;
 	int lastIndex=0;
 
+	codeplugContactsCacheEnsureComplete();
+
 	int numContacts =  codeplugContactsCache.numTGContacts + codeplugContactsCache.numPCContacts;
 
 	for (i = 0; i < numContacts; i++)
@@ -783,6 +925,7 @@ int codeplugContactSaveDataForIndex(int index, struct_codeplugContact_t *contact
 		codeplugContactsCacheUpdateOrInsertContactAt(index+1,contact);
 		//initCodeplugContactsCache();// Update the cache
 	}
+	codeplugContactsCacheBuildPCIndex();
 	return retVal;
 }
 
@@ -0,0 +1,436 @@
+/*
+ * Copyright (C)2019 Roger Clark. VK3KYY / G4KYF
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+ */
+
+#include <dmrData.h>
+#include <HR-C6000.h>
+#include <settings.h>
+#include <SPI_Flash.h>
+#include <ticks.h>
+#include <trx.h>
+#include <hotspot/dmrDefines.h>
+
+// DMR data call receive engine.
+//
+// The HR-C6000 has already removed the BPTC(196,96) / Trellis 3/4 FEC and checked the header CRC when the
+// Received Data interrupt fires, so the ISR only copies the decoded burst into a queue.
+// The foreground reassembles the blocks following each Data Header (one reassembly buffer per timeslot),
+// checks the message CRC-32, and stores the completed message in the inbox, which is a ring of records in the Flash.
+
+#define DMR_DATA_BURST_QUEUE_SIZE	8// Must be a power of 2
+#define DMR_DATA_MAX_BLOCKS			16
+#define DMR_DATA_TIMEOUT_MS			2000
+
+typedef struct
+{
+	uint8_t dataType;
+	uint8_t timeSlot;
+	uint8_t data[DMR_DATA_BURST_MAX_LENGTH];
+} dmrDataBurst_t;
+
+typedef struct
+{
+	bool     active;
+	bool     isGroup;
+	uint8_t  dpf;
+	uint8_t  sap;
+	uint32_t srcId;
+	uint32_t dstId;
+	int      blocksExpected;
+	int      blocksReceived;
+	uint32_t blocksReceivedMask;// Confirmed data blocks, by serial number
+	int      padOctets;
+	int      blockDataType;// All the blocks of a message use the same rate
+	int      blockPayloadLength;
+	uint32_t lastBurstTime;
+	uint8_t  data[DMR_DATA_MAX_BLOCKS * DMR_DATA_BURST_MAX_LENGTH];
+} dmrDataReassembly_t;
+
+// The inbox is stored in the external Flash, directly after the last heard log
+static const uint32_t DMR_DATA_INBOX_FLASH_START = 0x94000;
+static const uint32_t DMR_DATA_INBOX_FLASH_SIZE  = (4 * 4096);
+
+static const uint32_t DMR_DATA_CRC32_POLY = 0x04C11DB7;
+
+dmrDataStats_t dmrDataStats;
+
+static dmrDataBurst_t dmrDataBurstQueue[DMR_DATA_BURST_QUEUE_SIZE];
+static volatile uint32_t dmrDataBurstQueueHead = 0;// Written by the ISR
+static volatile uint32_t dmrDataBurstQueueTail = 0;// Written by the foreground
+
+__attribute__((section(".data.$RAM2"))) static dmrDataReassembly_t dmrDataReassembly[2];// One per timeslot
+
+static uint32_t dmrDataInboxWritePos = 0;// Offset of the next free record, relative to DMR_DATA_INBOX_FLASH_START
+static uint32_t dmrDataInboxSequence = 0;
+static dmrDataInboxRecord_t dmrDataInboxPending;
+static bool dmrDataInboxHasPending = false;
+
+// Length of the decoded payload of a data burst, or 0 if this Data Type is not handled
+int dmrDataBurstLength(int dataType)
+{
+	switch (dataType)
+	{
+		case DT_DATA_HEADER:
+		case DT_RATE_12_DATA:
+			return 12;
+		case DT_RATE_34_DATA:
+			return 18;
+		case DT_RATE_1_DATA:
+			return 24;
+		default:
+			return 0;
+	}
+}
+
+// Called from the HR-C6000 Received Data ISR
+void dmrDataQueueBurst(int dataType, int timeSlot, const uint8_t *data)
+{
+	uint32_t head = dmrDataBurstQueueHead;
+	int length = dmrDataBurstLength(dataType);
+
+	if ((length == 0) || (timeSlot < 0))
+	{
+		return;
+	}
+
+	if ((head - dmrDataBurstQueueTail) >= DMR_DATA_BURST_QUEUE_SIZE)
+	{
+		dmrDataStats.burstsDropped++;
+		return;
+	}
+
+	dmrDataBurst_t *burst = &dmrDataBurstQueue[head & (DMR_DATA_BURST_QUEUE_SIZE - 1)];
+	burst->dataType = dataType;
+	burst->timeSlot = (timeSlot & 0x01);
+	memcpy(burst->data, data, length);
+
+	dmrDataBurstQueueHead = head + 1;
+}
+
+// ETSI TS 102 361-1 B.3.9. The octets are processed in swapped pairs, and the CRC is sent least significant octet first.
+static uint32_t dmrDataCRC32(const uint8_t *data, int length)
+{
+	uint32_t crc = 0;
+
+	for (int i = 0; i < length; i++)
+	{
+		crc ^= ((uint32_t)data[i ^ 1]) << 24;
+		for (int bit = 0; bit < 8; bit++)
+		{
+			crc = ((crc & 0x80000000) ? ((crc << 1) ^ DMR_DATA_CRC32_POLY) : (crc << 1));
+		}
+	}
+	return crc;
+}
+
+static bool dmrDataIsForUs(bool isGroup, uint32_t dstId)
+{
+	if (isGroup)
+	{
+		// With the TG filter on, only accept data sent to the current TG
+		return ((nonVolatileSettings.dmrFilterLevel < DMR_FILTER_CC_TS_TG) || (dstId == (trxTalkGroupOrPcId & 0x00FFFFFF)));
+	}
+	return (dstId == trxDMRID);
+}
+
+static void dmrDataHandleHeader(dmrDataReassembly_t *msg, const uint8_t *data)
+{
+	int dpf = (data[0] & 0x0F);
+	int blocksToFollow;
+
+	if (msg->active)
+	{
+		dmrDataStats.messagesFailed++;// A new header replaces an incomplete message
+		msg->active = false;
+	}
+
+	switch (dpf)
+	{
+		case DMR_DATA_DPF_UNCONFIRMED:
+		case DMR_DATA_DPF_CONFIRMED:
+			blocksToFollow = (data[8] & 0x7F);
+			msg->padOctets = ((data[0] & 0x10) | (data[1] & 0x0F));
+			break;
+		case DMR_DATA_DPF_SHORT_DEFINED:
+		case DMR_DATA_DPF_SHORT_RAW:
+			blocksToFollow = ((data[0] & 0x30) | (data[1] & 0x0F));// Appended Blocks
+			msg->padOctets = 0;
+			break;
+		default:
+			return;// Response and proprietary packets are not handled
+	}
+
+	msg->isGroup = ((data[0] & 0x80) != 0);
+	msg->dstId = (data[2] << 16) | (data[3] << 8) | data[4];
+	msg->srcId = (data[5] << 16) | (data[6] << 8) | data[7];
+
+	if ((blocksToFollow == 0) || (blocksToFollow > DMR_DATA_MAX_BLOCKS) || (dmrDataIsForUs(msg->isGroup, msg->dstId) == false))
+	{
+		return;
+	}
+
+	msg->dpf = dpf;
+	msg->sap = (data[1] >> 4);
+	msg->blocksExpected = blocksToFollow;
+	msg->blocksReceived = 0;
+	msg->blocksReceivedMask = 0;
+	msg->blockDataType = -1;
+	msg->lastBurstTime = fw_millis();
+	msg->active = true;
+}
+
+static void dmrDataCompleteMessage(dmrDataReassembly_t *msg)
+{
+	int totalLength = msg->blocksExpected * msg->blockPayloadLength;
+	int messageLength = totalLength - 4 - msg->padOctets;
+	uint32_t receivedCRC;
+
+	msg->active = false;
+
+	receivedCRC = msg->data[totalLength - 4] | (msg->data[totalLength - 3] << 8) | (msg->data[totalLength - 2] << 16) | (msg->data[totalLength - 1] << 24);
+	if ((messageLength < 0) || (dmrDataCRC32(msg->data, totalLength - 4) != receivedCRC))
+	{
+		dmrDataStats.messagesFailed++;
+		return;
+	}
+
+	dmrDataStats.messagesReceived++;
+
+	if (dmrDataInboxHasPending)
+	{
+		dmrDataStats.messagesNotStored++;
+		return;
+	}
+
+	memset(&dmrDataInboxPending, 0xFF, sizeof(dmrDataInboxRecord_t));
+	dmrDataInboxPending.srcId = msg->srcId;
+	dmrDataInboxPending.dstId = msg->dstId;
+	dmrDataInboxPending.flags = (msg->isGroup ? DMR_DATA_INBOX_FLAG_GROUP : 0);
+	dmrDataInboxPending.dpf = msg->dpf;
+	dmrDataInboxPending.sap = msg->sap;
+	if (messageLength > DMR_DATA_INBOX_DATA_LENGTH)
+	{
+		messageLength = DMR_DATA_INBOX_DATA_LENGTH;
+		dmrDataInboxPending.flags |= DMR_DATA_INBOX_FLAG_TRUNCATED;
+	}
+	dmrDataInboxPending.length = messageLength;
+	memcpy(dmrDataInboxPending.data, msg->data, messageLength);
+	dmrDataInboxHasPending = true;
+}
+
+static void dmrDataHandleBlock(dmrDataReassembly_t *msg, int dataType, const uint8_t *data)
+{
+	int burstLength = dmrDataBurstLength(dataType);
+	int blockIndex;
+
+	if (msg->active == false)
+	{
+		return;
+	}
+
+	if (msg->blockDataType == -1)
+	{
+		msg->blockDataType = dataType;
+		// Confirmed blocks start with the 7 bit serial number and the CRC-9
+		msg->blockPayloadLength = ((msg->dpf == DMR_DATA_DPF_CONFIRMED) ? (burstLength - 2) : burstLength);
+	}
+	else if (msg->blockDataType != dataType)
+	{
+		dmrDataStats.messagesFailed++;
+		msg->active = false;
+		return;
+	}
+
+	msg->lastBurstTime = fw_millis();
+
+	if (msg->dpf == DMR_DATA_DPF_CONFIRMED)
+	{
+		// Confirmed blocks can be repeated, so place them using their serial number
+		blockIndex = (data[0] >> 1);
+		if ((blockIndex >= msg->blocksExpected) || (msg->blocksReceivedMask & (1 << blockIndex)))
+		{
+			return;
+		}
+		msg->blocksReceivedMask |= (1 << blockIndex);
+		memcpy(&msg->data[blockIndex * msg->blockPayloadLength], data + 2, msg->blockPayloadLength);
+	}
+	else
+	{
+		blockIndex = msg->blocksReceived;
+		memcpy(&msg->data[blockIndex * msg->blockPayloadLength], data, msg->blockPayloadLength);
+	}
+
+	msg->blocksReceived++;
+	if (msg->blocksReceived == msg->blocksExpected)
+	{
+		dmrDataCompleteMessage(msg);
+	}
+}
+
+static bool dmrDataInboxWriteRecord(dmrDataInboxRecord_t *rec)
+{
+	uint32_t address = DMR_DATA_INBOX_FLASH_START + dmrDataInboxWritePos;
+
+	// Entering a new sector, it needs to be erased first (this discards the oldest messages)
+	if ((dmrDataInboxWritePos % 4096) == 0)
+	{
+		if (SPI_Flash_eraseSector(address) == false)
+		{
+			return false;
+		}
+	}
+
+	rec->sequence = dmrDataInboxSequence;
+
+	if (SPI_Flash_writePage(address, (uint8_t *)rec) == false)
+	{
+		return false;
+	}
+
+	dmrDataInboxSequence++;
+	dmrDataInboxWritePos = (dmrDataInboxWritePos + sizeof(dmrDataInboxRecord_t)) % DMR_DATA_INBOX_FLASH_SIZE;
+
+	return true;
+}
+
+// Find the newest message in the inbox, and setup the write position
+void dmrDataInit(void)
+{
+	uint32_t sequence;
+	uint32_t newestPos = 0;
+	bool found = false;
+
+	memset(dmrDataReassembly, 0, sizeof(dmrDataReassembly));
+	memset(&dmrDataStats, 0, sizeof(dmrDataStats));
+	dmrDataBurstQueueHead = dmrDataBurstQueueTail = 0;
+	dmrDataInboxHasPending = false;
+
+	for (uint32_t pos = 0; pos < DMR_DATA_INBOX_FLASH_SIZE; pos += sizeof(dmrDataInboxRecord_t))
+	{
+		SPI_Flash_read(DMR_DATA_INBOX_FLASH_START + pos, (uint8_t *)&sequence, sizeof(sequence));
+
+		if ((sequence != 0xFFFFFFFF) && ((found == false) || ((int32_t)(sequence - dmrDataInboxSequence) > 0)))
+		{
+			dmrDataInboxSequence = sequence;
+			newestPos = pos;
+			found = true;
+		}
+	}
+
+	if (found)
+	{
+		dmrDataInboxSequence++;
+		dmrDataInboxWritePos = (newestPos + sizeof(dmrDataInboxRecord_t)) % DMR_DATA_INBOX_FLASH_SIZE;
+	}
+	else
+	{
+		dmrDataInboxSequence = 0;
+		dmrDataInboxWritePos = 0;
+	}
+}
+
+// Process the bursts queued by the ISR, and write a completed message to the Flash, but only while the radio is neither receiving nor transmitting DMR.
+void dmrDataTick(void)
+{
+	uint32_t now = fw_millis();
+
+	while (dmrDataBurstQueueTail != dmrDataBurstQueueHead)
+	{
+		dmrDataBurst_t *burst = &dmrDataBurstQueue[dmrDataBurstQueueTail & (DMR_DATA_BURST_QUEUE_SIZE - 1)];
+		dmrDataReassembly_t *msg = &dmrDataReassembly[burst->timeSlot];
+
+		dmrDataStats.burstsReceived++;
+		if (burst->dataType == DT_DATA_HEADER)
+		{
+			dmrDataHandleHeader(msg, burst->data);
+		}
+		else
+		{
+			dmrDataHandleBlock(msg, burst->dataType, burst->data);
+		}
+
+		dmrDataBurstQueueTail++;
+	}
+
+	for (int i = 0; i < 2; i++)
+	{
+		if (dmrDataReassembly[i].active && ((now - dmrDataReassembly[i].lastBurstTime) > DMR_DATA_TIMEOUT_MS))
+		{
+			dmrDataReassembly[i].active = false;
+			dmrDataStats.messagesFailed++;
+		}
+	}
+
+	if (dmrDataInboxHasPending && (trxIsTransmitting == false) && (slot_state == DMR_STATE_IDLE))
+	{
+		dmrDataInboxWriteRecord(&dmrDataInboxPending);
+		dmrDataInboxHasPending = false;
+	}
+}
+
+// Store a completed message which has not been written yet. Used when powering off.
+void dmrDataFlush(void)
+{
+	if (dmrDataInboxHasPending)
+	{
+		dmrDataInboxWriteRecord(&dmrDataInboxPending);
+		dmrDataInboxHasPending = false;
+	}
+}
+
+static uint32_t dmrDataInboxGetRecordAddress(int number)
+{
+	const int numRecords = (DMR_DATA_INBOX_FLASH_SIZE / sizeof(dmrDataInboxRecord_t));
+	int recordIndex = ((dmrDataInboxWritePos / sizeof(dmrDataInboxRecord_t)) + numRecords - 1 - number) % numRecords;
+
+	return DMR_DATA_INBOX_FLASH_START + (recordIndex * sizeof(dmrDataInboxRecord_t));
+}
+
+// Records in a sector which has been erased since, or never written, do not have the expected sequence number
+static bool dmrDataInboxIsValidSequence(int number, uint32_t sequence)
+{
+	return (((uint32_t)number < dmrDataInboxSequence) && (sequence == (dmrDataInboxSequence - 1 - number)));
+}
+
+int dmrDataInboxGetCount(void)
+{
+	const int numRecords = (DMR_DATA_INBOX_FLASH_SIZE / sizeof(dmrDataInboxRecord_t));
+	uint32_t sequence;
+	int count;
+
+	for (count = 0; count < numRecords; count++)
+	{
+		SPI_Flash_read(dmrDataInboxGetRecordAddress(count), (uint8_t *)&sequence, sizeof(sequence));
+		if (dmrDataInboxIsValidSequence(count, sequence) == false)
+		{
+			break;
+		}
+	}
+	return count;
+}
+
+// Read a message from the inbox. Number 0 is the newest message.
+bool dmrDataInboxGetMessage(int number, dmrDataInboxRecord_t *rec)
+{
+	if ((number < 0) || (number >= (DMR_DATA_INBOX_FLASH_SIZE / sizeof(dmrDataInboxRecord_t))))
+	{
+		return false;
+	}
+
+	SPI_Flash_read(dmrDataInboxGetRecordAddress(number), (uint8_t *)rec, sizeof(dmrDataInboxRecord_t));
+	return dmrDataInboxIsValidSequence(number, rec->sequence);
+}
@@ -91,6 +91,30 @@ bool settingsLoadSettings(void)
 	}
 	soundBeepVolumeDivider = nonVolatileSettings.beepVolumeDivider;
 
+	// Added this parameter without changing the magic number, so need to check for default / invalid numbers
+	if (nonVolatileSettings.callRecorder > 1)
+	{
+		nonVolatileSettings.callRecorder = 0;
+	}
+
+	// Added this parameter without changing the magic number, so need to check for default / invalid numbers
+	if (nonVolatileSettings.voicePrompts > 1)
+	{
+		nonVolatileSettings.voicePrompts = 0;
+	}
+
+	// Added this parameter without changing the magic number, so need to check for default / invalid numbers
+	if (nonVolatileSettings.rxAGC > 1)
+	{
+		nonVolatileSettings.rxAGC = 0;
+	}
+
+	// Added this parameter without changing the magic number, so need to check for default / invalid numbers
+	if (nonVolatileSettings.micCompressor >= MIC_COMPRESSOR_NUM_PROFILES)
+	{
+		nonVolatileSettings.micCompressor = 0;
+	}
+
 	codeplugInitChannelsPerZone();// Initialise the codeplug channels per zone
 
 	return readOK;
@@ -204,6 +228,10 @@ void settingsRestoreDefaultSettings(void)
 			BEEP_TX_STOP |
 #endif
 			BEEP_TX_START;
+	nonVolatileSettings.callRecorder = 0;
+	nonVolatileSettings.voicePrompts = 0;
+	nonVolatileSettings.rxAGC = 0;
+	nonVolatileSettings.micCompressor = 0;
 
 	currentChannelData = &settingsVFOChannel[nonVolatileSettings.currentVFONumber];// Set the current channel data to point to the VFO data since the default screen will be the VFO
 
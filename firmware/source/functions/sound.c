@@ -36,6 +36,27 @@ static volatile uint32_t runningMaxValue=0;
 static const int MIC_AVERAGE_COUNTER_RELOAD = 10;
 static volatile int micAudioAverageCounter = MIC_AVERAGE_COUNTER_RELOAD;
 
+// Mic compressor and peak limiter, applied to each 10mS buffer from the I2S before it goes to the AMBE encoder.
+// Gains are Q12 (4096 = 0dB). The compressor gain is worked out from the peak envelope at the end of each buffer,
+// and the limiter reduces it part way through a buffer if a sample would still go over the ceiling.
+#define MIC_COMPRESSOR_UNITY_GAIN	4096
+
+typedef struct
+{
+	int32_t threshold;// Peak level above which the gain is reduced
+	int32_t ratioShift;// 0 = off, 1 = 2:1, 2 = 4:1
+	int32_t makeupGain;// Q12
+} micCompressorProfile_t;
+static const int32_t MIC_COMPRESSOR_LIMIT_LEVEL = 29205;// -1dBFS
+static const micCompressorProfile_t MIC_COMPRESSOR_PROFILES[MIC_COMPRESSOR_NUM_PROFILES] = {
+		{ 0,	0,	MIC_COMPRESSOR_UNITY_GAIN },// Off
+		{ 8192,	1,	6144 },// 2:1 above -12dBFS, +3.5dB makeup
+		{ 4096,	2,	12288 }// 4:1 above -18dBFS, +9.5dB makeup
+};
+static int32_t micCompressorEnvelope = 0;
+static int32_t micCompressorGain = MIC_COMPRESSOR_UNITY_GAIN;// Compressor and makeup gain
+static int32_t micLimiterGain = MIC_COMPRESSOR_UNITY_GAIN;
+
 __attribute__((section(".data.$RAM2"))) int melody_generic[512];// Note. As we don't play long melodies, I think this value can be made smaller.
 #define DIT_LENGTH  60
 #define DAH_LENGTH  3 * DIT_LENGTH
@@ -150,6 +171,32 @@ void create_song(const uint8_t *melody)
 	}
 }
 
+uint32_t soundISqrt(uint32_t value)
+{
+	uint32_t result = 0;
+	uint32_t bit = (1UL << 30);
+
+	while (bit > value)
+	{
+		bit >>= 2;
+	}
+
+	while (bit != 0)
+	{
+		if (value >= (result + bit))
+		{
+			value -= (result + bit);
+			result = (result >> 1) + bit;
+		}
+		else
+		{
+			result >>= 1;
+		}
+		bit >>= 2;
+	}
+	return result;
+}
+
 void fw_init_beep_task(void)
 {
 	taskENTER_CRITICAL();
@@ -161,7 +208,7 @@ void fw_init_beep_task(void)
 				"fw beep task",                      /* task name for kernel awareness debugging */
 				1000L / sizeof(portSTACK_TYPE),      /* task stack size */
 				NULL,                      			 /* optional task startup argument */
-				5U,                                  /* initial priority */
+				4U,                                  /* initial priority */
 				fwBeepTaskHandle					 /* optional task handle to create */
 				);
 }
@@ -290,6 +337,39 @@ void send_sound_data(void)
 }
 
 
+static void micCompressorUpdate(const micCompressorProfile_t *profile, int32_t bufferMaxValue, int32_t appliedGain)
+{
+	int32_t gain = MIC_COMPRESSOR_UNITY_GAIN;
+
+	// The limiter gain is whatever was left at the end of the buffer, relative to the compressor gain. It releases over about 100mS
+	micLimiterGain = (appliedGain << 12) / micCompressorGain;
+	micLimiterGain += ((MIC_COMPRESSOR_UNITY_GAIN - micLimiterGain) >> 3);
+
+	// Peak envelope. Instant attack, release over about 100mS
+	if (bufferMaxValue > micCompressorEnvelope)
+	{
+		micCompressorEnvelope = bufferMaxValue;
+	}
+	else
+	{
+		micCompressorEnvelope -= ((micCompressorEnvelope - bufferMaxValue) >> 3);
+	}
+
+	// Above the threshold, the output is threshold * (envelope / threshold) ^ (1 / ratio), using a square root for each halving of the slope
+	if (micCompressorEnvelope > profile->threshold)
+	{
+		uint32_t overshoot = (micCompressorEnvelope << 12) / profile->threshold;// Q12
+
+		for (int i = 0; i < profile->ratioShift; i++)
+		{
+			overshoot = soundISqrt(overshoot << 12);
+		}
+		gain = ((profile->threshold * overshoot) / micCompressorEnvelope);
+	}
+
+	micCompressorGain = (gain * profile->makeupGain) >> 12;
+}
+
 // This function is used during transmission.
 void receive_sound_data(void)
 {
@@ -303,17 +383,49 @@ void receive_sound_data(void)
 		// spi_soundBuf == NULL  happens the first time through there is no previously sampled buffer to load into the wave buffer
 		if (spi_soundBuf!=NULL)
 		{
+			const micCompressorProfile_t *profile = &MIC_COMPRESSOR_PROFILES[nonVolatileSettings.micCompressor];
+			int32_t gain = (micCompressorGain * micLimiterGain) >> 12;
+			uint32_t bufferMaxValue = 0;
+
 			for (int i=0; i<(WAV_BUFFER_SIZE/2); i++)
 			{
 				swapper.bytes8[1] = *(spi_soundBuf +4*i +3);
-				audioAndHotspotDataBuffer.wavbuffer[wavbuffer_write_idx][2*i+1] = swapper.bytes8[1];
 				swapper.bytes8[0] = *(spi_soundBuf +4*i +2);
-				audioAndHotspotDataBuffer.wavbuffer[wavbuffer_write_idx][2*i] = swapper.bytes8[0];
-				if (abs(swapper.byte16) > runningMaxValue)
+				int32_t sample = swapper.byte16;
+				uint32_t level = abs(sample);
+
+				if (level > bufferMaxValue)
+				{
+					bufferMaxValue = level;
+				}
+
+				if (profile->ratioShift != 0)
 				{
-					runningMaxValue = abs(swapper.byte16);
+					sample = (sample * gain) >> 12;
+					if (abs(sample) > MIC_COMPRESSOR_LIMIT_LEVEL)
+					{
+						// Limiter. Reduce the gain so this sample is exactly at the ceiling, and keep it for the rest of the buffer
+						gain = (MIC_COMPRESSOR_LIMIT_LEVEL << 12) / level;
+						sample = (sample > 0) ? MIC_COMPRESSOR_LIMIT_LEVEL : -MIC_COMPRESSOR_LIMIT_LEVEL;
+					}
+					swapper.byte16 = sample;
 				}
+
+				audioAndHotspotDataBuffer.wavbuffer[wavbuffer_write_idx][2*i+1] = swapper.bytes8[1];
+				audioAndHotspotDataBuffer.wavbuffer[wavbuffer_write_idx][2*i] = swapper.bytes8[0];
 			}
+
+			// The level meter shows the mic level before the compressor, as it is used to set the mic gain
+			if (bufferMaxValue > runningMaxValue)
+			{
+				runningMaxValue = bufferMaxValue;
+			}
+
+			if (profile->ratioShift != 0)
+			{
+				micCompressorUpdate(profile, bufferMaxValue, gain);
+			}
+
 			if (micAudioAverageCounter-- == 0)
 			{
 				micAudioAverageCounter=MIC_AVERAGE_COUNTER_RELOAD;
@@ -438,6 +550,7 @@ void fw_beep_task(void *data)
     	taskEXIT_CRITICAL();
     	if (tmp_timer_beeptask==0)
     	{
+    		lock_SPI_bus();
         	taskENTER_CRITICAL();
         	timer_beeptask=10;
         	alive_beeptask=true;
@@ -481,6 +594,7 @@ void fw_beep_task(void *data)
     			}
     		}
     		taskEXIT_CRITICAL();
+    		unlock_SPI_bus();
     	}
 
 		vTaskDelay(0);
@@ -19,7 +19,9 @@
  */
 
 #include <EPL003.h>
+#include <HR-C6000.h>
 #include <settings.h>
+#include <SPI_Flash.h>
 #include <io/LEDs.h>
 #include <math.h>
 #include <stdio.h>
@@ -144,6 +146,71 @@ typedef struct
 
 static SpeechCurrentSequence_t ssSeq;
 
+#else
+
+// The other platforms use voice prompts stored in the Flash as AMBE bursts (27 bytes per 60mS), which are decoded by the codec.
+// The prompts are written by the CPS. They start with a header, followed by the table of the offset of each prompt
+// (relative to SPEECH_PROMPTS_FLASH_START, plus the end of the last prompt), then the bursts of the prompts.
+// The prompts are in the order of EPL003_Sequence_t. The image is made by tools/voice_prompts_builder.
+#define SPEECH_PROMPTS_MAX 128
+
+static const uint32_t SPEECH_PROMPTS_FLASH_START = 0xA0000;
+static const uint32_t SPEECH_PROMPTS_FLASH_SIZE  = 0x20000;
+static const uint32_t SPEECH_PROMPTS_MAGIC       = 0x50424D41;// "AMBP"
+
+typedef struct
+{
+	uint32_t magic;
+	uint32_t numPrompts;
+} SpeechPromptsHeader_t;
+
+typedef struct
+{
+	uint8_t  Buffer[SPEECH_SYNTHESIS_BUFFER_SIZE];
+	uint8_t  Pos;
+	uint8_t  Length;
+	bool     Started;
+	uint32_t Address;// Next burst of the current word
+	uint32_t EndAddress;
+} SpeechCurrentSequence_t;
+
+static SpeechCurrentSequence_t ssSeq;
+static uint32_t speechPromptOffsets[SPEECH_PROMPTS_MAX + 1];
+static uint32_t speechNumPrompts = 0;
+
+static void speechSynthesisLoadPromptsTable(void)
+{
+	SpeechPromptsHeader_t header;
+
+	speechNumPrompts = 0;
+
+	SPI_Flash_read(SPEECH_PROMPTS_FLASH_START, (uint8_t *)&header, sizeof(header));
+	if ((header.magic != SPEECH_PROMPTS_MAGIC) || (header.numPrompts == 0) || (header.numPrompts > SPEECH_PROMPTS_MAX))
+	{
+		return;
+	}
+
+	SPI_Flash_read(SPEECH_PROMPTS_FLASH_START + sizeof(header), (uint8_t *)speechPromptOffsets, (header.numPrompts + 1) * sizeof(uint32_t));
+
+	for (uint32_t i = 0; i < header.numPrompts; i++)
+	{
+		if ((speechPromptOffsets[i + 1] < speechPromptOffsets[i]) || (speechPromptOffsets[i + 1] > SPEECH_PROMPTS_FLASH_SIZE) ||
+				(((speechPromptOffsets[i + 1] - speechPromptOffsets[i]) % CODEC_AMBE_BURST_LENGTH) != 0))
+		{
+			return;// Corrupt table
+		}
+	}
+
+	speechNumPrompts = header.numPrompts;
+}
+
+// Prompts are only played while DMR is idle, as the audio goes through the codec
+static bool speechSynthesisCanPlay(void)
+{
+	return ((trxGetMode() == RADIO_MODE_DIGITAL) && (settingsUsbMode != USB_MODE_HOTSPOT) &&
+			(trxIsTransmitting == false) && (slot_state == DMR_STATE_IDLE));
+}
+
 #endif
 
 void speechSynthesisInit(void)
@@ -155,6 +222,11 @@ void speechSynthesisInit(void)
 	ssSeq.Pos = 0;
 	ssSeq.Length = 0;
 	ssSeq.EndsAt = 0;
+#else
+	ssSeq.Pos = 0;
+	ssSeq.Length = 0;
+	ssSeq.Started = false;
+	speechSynthesisLoadPromptsTable();
 #endif
 }
 
@@ -166,6 +238,23 @@ void speechSynthesisSpeak(uint8_t *sentence)
 		ssSeq.Pos = 0;
 		ssSeq.Length = sentence[0];
 
+		memcpy(&(ssSeq.Buffer[0]), &(sentence[1]), ssSeq.Length);
+	}
+#else
+	if ((nonVolatileSettings.voicePrompts != 0) && (speechNumPrompts != 0) && speechSynthesisCanPlay() &&
+			((sentence[0] > 0) && (sentence[0] <= sizeof(ssSeq.Buffer))))
+	{
+		// Cut off the sentence which is being spoken
+		if (ssSeq.Started)
+		{
+			codecPlaybackStop();
+		}
+
+		ssSeq.Pos = 0;
+		ssSeq.Length = sentence[0];
+		ssSeq.Started = false;
+		ssSeq.Address = ssSeq.EndAddress = 0;
+
 		memcpy(&(ssSeq.Buffer[0]), &(sentence[1]), ssSeq.Length);
 	}
 #endif
@@ -173,11 +262,7 @@ void speechSynthesisSpeak(uint8_t *sentence)
 
 bool speechSynthesisIsSpeaking(void)
 {
-#if defined(PLATFORM_GD77S)
 	return (ssSeq.Length != 0);
-#else
-	return false;
-#endif
 }
 
 void speechSynthesisTick(void)
@@ -245,6 +330,61 @@ void speechSynthesisTick(void)
 			ssSeq.Pos++;
 		}
 	}
+#else
+	if (ssSeq.Length == 0)
+	{
+		return;
+	}
+
+	if (speechSynthesisCanPlay() == false)
+	{
+		if (ssSeq.Started)
+		{
+			codecPlaybackStop();
+		}
+		ssSeq.Length = 0;
+		return;
+	}
+
+	if (ssSeq.Started == false)
+	{
+		// Wait for a recording, or the end of the previous sentence, to stop
+		if (codecPlaybackIsActive())
+		{
+			return;
+		}
+		ssSeq.Started = true;
+	}
+
+	// Keep the codec queue full, the words being concatenated without any gap
+	while (codecPlaybackGetSpace() > 0)
+	{
+		if (ssSeq.Address >= ssSeq.EndAddress)
+		{
+			if (ssSeq.Pos >= ssSeq.Length)
+			{
+				// The codec plays out what has already been queued
+				ssSeq.Length = 0;
+				ssSeq.Started = false;
+				return;
+			}
+
+			if (ssSeq.Buffer[ssSeq.Pos] < speechNumPrompts)
+			{
+				ssSeq.Address = SPEECH_PROMPTS_FLASH_START + speechPromptOffsets[ssSeq.Buffer[ssSeq.Pos]];
+				ssSeq.EndAddress = SPEECH_PROMPTS_FLASH_START + speechPromptOffsets[ssSeq.Buffer[ssSeq.Pos] + 1];
+			}
+			ssSeq.Pos++;
+		}
+		else
+		{
+			uint8_t ambeBurst[CODEC_AMBE_BURST_LENGTH];
+
+			SPI_Flash_read(ssSeq.Address, ambeBurst, CODEC_AMBE_BURST_LENGTH);
+			codecPlaybackPut(ambeBurst);
+			ssSeq.Address += CODEC_AMBE_BURST_LENGTH;
+		}
+	}
 #endif
 }
 
@@ -252,7 +392,6 @@ void speechSynthesisTick(void)
 uint8_t speechSynthesisBuildFromNumberInString(uint8_t *dest, uint8_t destSize, const char *str, bool enumerate)
 {
 	uint8_t   *pBuf = dest;
-#if defined(PLATFORM_GD77S)
 	char      *p = (char *)str;
 
 	// Just enumerates all numbers, plus '.', and sign
@@ -390,14 +529,12 @@ uint8_t speechSynthesisBuildFromNumberInString(uint8_t *dest, uint8_t destSize,
 				break;
 		}
 	}
-#endif
 
 	return (pBuf - dest);
 }
 
 uint8_t speechSynthesisBuildNumerical(uint8_t *dest, uint8_t destSize, float value, uint8_t numberOfDecimals, bool enumerate)
 {
-#if defined(PLATFORM_GD77S)
 	char str[16];
 	char *p = str;
 
@@ -448,7 +585,6 @@ uint8_t speechSynthesisBuildNumerical(uint8_t *dest, uint8_t destSize, float val
 			return (destPos + speechSynthesisBuildFromNumberInString((dest + destPos), (destSize - destPos), p, enumerate));
 		}
 	}
-#endif
 
 	return 0U;
 }
@@ -0,0 +1,163 @@
+/*
+ * Copyright (C)2019 Roger Clark. VK3KYY / G4KYF
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+ */
+
+#include <trace.h>
+#include <pit.h>
+
+#if defined(USE_SEGGER_RTT)
+#include <SeggerRTT/RTT/SEGGER_RTT.h>
+#endif
+
+// Binary event trace.
+//
+// Events are written as fixed size records into a RAM ring, from the ISRs and the tasks, without disabling the interrupts.
+// Each writer claims a record number with LDREX / STREX, so a writer which is pre-empted by another one still gets its own record.
+// The sequence of a record only matches its record number once the record is complete, so the reader can tell a record which is
+// still being written, or which has been overwritten while it was being read.
+//
+// The ring is only read by the main task, which sends the records as they are over RTT (channel 1) or USB.
+// The formatting is done on the host, by tools/trace_decoder.
+
+#define TRACE_RING_SIZE		128// Must be a power of 2
+#define TRACE_RING_MASK		(TRACE_RING_SIZE - 1)
+#define TRACE_RTT_CHANNEL	1
+
+__attribute__((section(".data.$RAM2"))) static volatile traceRecord_t traceRing[TRACE_RING_SIZE];
+static volatile uint32_t traceWriteIndex = 0;
+static uint32_t traceReadIndex = 0;
+static volatile traceSink_t traceSink = TRACE_SINK_DEFAULT;
+
+#if defined(USE_SEGGER_RTT)
+__attribute__((section(".data.$RAM2"))) static uint8_t traceRTTBuffer[512];
+static traceRecord_t traceRTTRecord;
+static bool traceRTTPending = false;
+#endif
+
+void traceInit(void)
+{
+	for (int i = 0; i < TRACE_RING_SIZE; i++)
+	{
+		traceRing[i].sequence = (uint16_t)~i;// Not written yet
+	}
+	traceReadIndex = traceWriteIndex;
+
+#if defined(USE_SEGGER_RTT)
+	SEGGER_RTT_ConfigUpBuffer(TRACE_RTT_CHANNEL, "Trace", traceRTTBuffer, sizeof(traceRTTBuffer), SEGGER_RTT_MODE_NO_BLOCK_SKIP);
+#endif
+}
+
+void traceEvent(traceEventId_t eventId, uint32_t arg1, uint32_t arg2)
+{
+	uint32_t index;
+	volatile traceRecord_t *record;
+
+	// If another writer claims a record between the LDREX and the STREX, the STREX fails and this is tried again
+	do
+	{
+		index = __LDREXW(&traceWriteIndex);
+	} while (__STREXW(index + 1, &traceWriteIndex) != 0);
+
+	record = &traceRing[index & TRACE_RING_MASK];
+	record->sequence = (uint16_t)~index;
+	__DMB();
+	record->timestamp = PITCounter;
+	record->eventId = eventId;
+	record->arg1 = arg1;
+	record->arg2 = arg2;
+	__DMB();
+	record->sequence = (uint16_t)index;
+}
+
+// Read the next record. When the writers have overwritten records which had not been read, a TRACE_EVENT_OVERFLOW record is returned instead
+bool traceRead(traceRecord_t *record)
+{
+	while (true)
+	{
+		uint32_t numUnread = traceWriteIndex - traceReadIndex;
+		volatile traceRecord_t *slot;
+
+		if (numUnread == 0)
+		{
+			return false;
+		}
+
+		if (numUnread > TRACE_RING_SIZE)
+		{
+			// Skip a bit more than what has been lost, as the oldest records are likely to be overwritten before they are read
+			uint32_t numLost = (numUnread - TRACE_RING_SIZE) + (TRACE_RING_SIZE / 4);
+
+			traceReadIndex += numLost;
+			record->timestamp = PITCounter;
+			record->eventId = TRACE_EVENT_OVERFLOW;
+			record->sequence = 0;
+			record->arg1 = numLost;
+			record->arg2 = 0;
+			return true;
+		}
+
+		slot = &traceRing[traceReadIndex & TRACE_RING_MASK];
+		if (slot->sequence != (uint16_t)traceReadIndex)
+		{
+			return false;// Still being written by a pre-empted writer
+		}
+
+		record->timestamp = slot->timestamp;
+		record->eventId = slot->eventId;
+		record->arg1 = slot->arg1;
+		record->arg2 = slot->arg2;
+		record->sequence = (uint16_t)traceReadIndex;
+		__DMB();
+
+		if (slot->sequence == (uint16_t)traceReadIndex)
+		{
+			traceReadIndex++;
+			return true;
+		}
+		// Overwritten while it was being copied. Go round again, to report the records which were lost
+	}
+}
+
+void traceSetSink(traceSink_t sink)
+{
+	traceSink = sink;
+}
+
+traceSink_t traceGetSink(void)
+{
+	return traceSink;
+}
+
+// Called from the main loop. The USB sink is handled by tick_com_request
+void traceTick(void)
+{
+#if defined(USE_SEGGER_RTT)
+	if (traceSink == TRACE_SINK_RTT)
+	{
+		// A record which doesn't fit in the RTT buffer is kept until the host has read some more
+		while (traceRTTPending || traceRead(&traceRTTRecord))
+		{
+			traceRTTPending = true;
+			if (SEGGER_RTT_Write(TRACE_RTT_CHANNEL, &traceRTTRecord, sizeof(traceRecord_t)) == 0)
+			{
+				break;
+			}
+			traceRTTPending = false;
+		}
+	}
+#endif
+}
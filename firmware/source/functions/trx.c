@@ -118,6 +118,11 @@ static volatile bool txPAEnabled=false;
 
 static int trxCurrentDMRTimeSlot;
 
+// Receiver state saved while it is fast tuned away from the current frequency (see trxFastTuneRx())
+static bool rxFastTuned = false;
+static int rxFastTuneSavedFrequency;
+static int rxFastTuneSavedBand;
+
 const int trxDTMFfreq1[] = { 1336, 1209, 1336, 1477, 1209, 1336, 1477, 1209, 1336, 1477, 1633, 1633, 1633, 1633, 1209, 1477 };
 const int trxDTMFfreq2[] = {  941,  697,  697,  697,  770,  770,  770,  852,  852,  852,  697,  770,  852,  941,  941,  941 };
 
@@ -141,6 +146,7 @@ void trxSetModeAndBandwidth(int mode, bool bandwidthIs25kHz)
 
 		currentBandWidthIs25kHz=bandwidthIs25kHz;
 
+		lock_SPI_bus();
 		taskENTER_CRITICAL();
 		switch(mode)
 		{
@@ -178,6 +184,7 @@ void trxSetModeAndBandwidth(int mode, bool bandwidthIs25kHz)
 			break;
 		}
 		taskEXIT_CRITICAL();
+		unlock_SPI_bus();
 	}
 }
 
@@ -279,6 +286,101 @@ bool trxCarrierDetected(void)
 	return (trxRxNoise < squelch);
 }
 
+// Compute everything needed to tune the receiver to fRx, using the channel squelch (sql) or the band default if sql is 0
+void trxFastTunePrepare(int fRx, uint8_t sql, trxFastTune_t *fastTune)
+{
+	uint32_t f = fRx * 0.16f;
+	int band = trxGetBandFromFrequency(fRx);
+
+	fastTune->fl_l = (f & 0x000000ff) >> 0;
+	fastTune->fl_h = (f & 0x0000ff00) >> 8;
+	fastTune->fh_l = (f & 0x00ff0000) >> 16;
+	fastTune->fh_h = (f & 0xff000000) >> 24;
+	fastTune->band = ((band == -1) ? RADIO_BAND_UHF : band);
+
+	if (sql != 0)
+	{
+		fastTune->squelch = TRX_SQUELCH_MAX - (((sql - 1) * 11) >> 2);
+	}
+	else
+	{
+		fastTune->squelch = TRX_SQUELCH_MAX - (((nonVolatileSettings.squelchDefaults[fastTune->band]) * 11) >> 2);
+	}
+}
+
+// Retune the receiver only, nothing else (calibration, HR-C6000, CTCSS) is changed.
+// The current frequency is invalidated, so the next call to trxSetFrequency() will fully retune the transceiver.
+void trxFastTuneRx(trxFastTune_t *fastTune)
+{
+	uint8_t bw = (currentBandWidthIs25kHz ? 0x70 : 0x40);
+
+	taskENTER_CRITICAL();
+	if (!rxFastTuned)
+	{
+		rxFastTuneSavedFrequency = currentRxFrequency;
+		rxFastTuneSavedBand = trxCurrentBand[TRX_RX_FREQ_BAND];
+		rxFastTuned = true;
+	}
+
+	I2C_AT1846S_write_reg_2byte(0x30, bw, 0x06 | squelch); // RX off
+	I2C_AT1846S_write_reg_2byte(0x29, fastTune->fh_h, fastTune->fh_l);
+	I2C_AT1846S_write_reg_2byte(0x2a, fastTune->fl_h, fastTune->fl_l);
+	I2C_AT1846S_write_reg_2byte(0x30, bw, 0x26 | squelch); // RX on
+
+	if ((!txPAEnabled) && (trxCurrentBand[TRX_RX_FREQ_BAND] != fastTune->band))
+	{
+		GPIO_PinWrite(GPIO_VHF_RX_amp_power, Pin_VHF_RX_amp_power, (fastTune->band == RADIO_BAND_VHF));
+		GPIO_PinWrite(GPIO_UHF_RX_amp_power, Pin_UHF_RX_amp_power, (fastTune->band != RADIO_BAND_VHF));
+		trxCurrentBand[TRX_RX_FREQ_BAND] = fastTune->band;
+	}
+
+	currentRxFrequency = 0;
+	taskEXIT_CRITICAL();
+}
+
+static void trxFastTuneEnd(void)
+{
+	if (rxFastTuned)
+	{
+		currentRxFrequency = rxFastTuneSavedFrequency;
+		trxCurrentBand[TRX_RX_FREQ_BAND] = rxFastTuneSavedBand;
+		rxFastTuned = false;
+	}
+}
+
+// Tune the receiver back to the current frequency, after trxFastTuneRx() has been used
+void trxFastTuneRestore(void)
+{
+	uint8_t bw = (currentBandWidthIs25kHz ? 0x70 : 0x40);
+
+	if (!rxFastTuned)
+	{
+		return;
+	}
+
+	taskENTER_CRITICAL();
+	trxFastTuneEnd();
+
+	I2C_AT1846S_write_reg_2byte(0x30, bw, 0x06 | squelch); // RX off
+	I2C_AT1846S_write_reg_2byte(0x29, rx_fh_h, rx_fh_l);
+	I2C_AT1846S_write_reg_2byte(0x2a, rx_fl_h, rx_fl_l);
+	I2C_AT1846S_write_reg_2byte(0x30, bw, 0x26 | squelch); // RX on
+
+	if (!txPAEnabled)
+	{
+		GPIO_PinWrite(GPIO_VHF_RX_amp_power, Pin_VHF_RX_amp_power, (trxCurrentBand[TRX_RX_FREQ_BAND] == RADIO_BAND_VHF));
+		GPIO_PinWrite(GPIO_UHF_RX_amp_power, Pin_UHF_RX_amp_power, (trxCurrentBand[TRX_RX_FREQ_BAND] != RADIO_BAND_VHF));
+	}
+	taskEXIT_CRITICAL();
+}
+
+bool trxFastTuneCarrierDetected(trxFastTune_t *fastTune)
+{
+	trxReadRSSIAndNoise();
+
+	return (trxRxNoise < fastTune->squelch);
+}
+
 void trxCheckDigitalSquelch(void)
 {
 	trx_measure_count++;
@@ -360,7 +462,8 @@ void trxCheckAnalogSquelch(void)
 
 
 
-		if((trxRxNoise < squelch) && (((rxCTCSSactive) && (trxCheckCTCSSFlag())) || (!rxCTCSSactive)))
+		// Keep the audio muted while the receiver is fast tuned (scanning or band scope)
+		if((trxRxNoise < squelch) && (!rxFastTuned) && (((rxCTCSSactive) && (trxCheckCTCSSFlag())) || (!rxCTCSSactive)))
 		{
 			GPIO_PinWrite(GPIO_RX_audio_mux, Pin_RX_audio_mux, 1);// Set the audio path to AT1846 -> audio amp.
 			enableAudioAmp(AUDIO_AMP_MODE_RF);
@@ -380,7 +483,9 @@ void trxCheckAnalogSquelch(void)
 
 void trxSetFrequency(int fRx,int fTx, int dmrMode)
 {
+	lock_SPI_bus();
 	taskENTER_CRITICAL();
+	rxFastTuned = false;// currentRxFrequency is 0 if the receiver was fast tuned, so it will be fully retuned here
 	if (currentRxFrequency!=fRx || currentTxFrequency!=fTx)
 	{
 		trxCurrentBand[TRX_RX_FREQ_BAND] = trxGetBandFromFrequency(fRx);
@@ -433,28 +538,28 @@ void trxSetFrequency(int fRx,int fTx, int dmrMode)
 		if (currentBandWidthIs25kHz)
 		{
 			// 25 kHz settings
-			write_I2C_reg_2byte(I2C_MASTER_SLAVE_ADDR_7BIT, 0x30, 0x70, 0x06 | squelch); // RX off
+			I2C_AT1846S_write_reg_2byte(0x30, 0x70, 0x06 | squelch); // RX off
 		}
 		else
 		{
 			// 12.5 kHz settings
-			write_I2C_reg_2byte(I2C_MASTER_SLAVE_ADDR_7BIT, 0x30, 0x40, 0x06 | squelch); // RX off
+			I2C_AT1846S_write_reg_2byte(0x30, 0x40, 0x06 | squelch); // RX off
 		}
-		write_I2C_reg_2byte(I2C_MASTER_SLAVE_ADDR_7BIT, 0x05, 0x87, 0x63); // select 'normal' frequency mode
+		I2C_AT1846S_write_reg_2byte(0x05, 0x87, 0x63); // select 'normal' frequency mode
 
-		write_I2C_reg_2byte(I2C_MASTER_SLAVE_ADDR_7BIT, 0x29, rx_fh_h, rx_fh_l);
-		write_I2C_reg_2byte(I2C_MASTER_SLAVE_ADDR_7BIT, 0x2a, rx_fl_h, rx_fl_l);
-		write_I2C_reg_2byte(I2C_MASTER_SLAVE_ADDR_7BIT, 0x49, 0x0C, 0x15); // setting SQ open and shut threshold
+		I2C_AT1846S_write_reg_2byte(0x29, rx_fh_h, rx_fh_l);
+		I2C_AT1846S_write_reg_2byte(0x2a, rx_fl_h, rx_fl_l);
+		I2C_AT1846S_write_reg_2byte(0x49, 0x0C, 0x15); // setting SQ open and shut threshold
 
 		if (currentBandWidthIs25kHz)
 		{
 			// 25 kHz settings
-			write_I2C_reg_2byte(I2C_MASTER_SLAVE_ADDR_7BIT, 0x30, 0x70, 0x26 | squelch); // RX on
+			I2C_AT1846S_write_reg_2byte(0x30, 0x70, 0x26 | squelch); // RX on
 		}
 		else
 		{
 			// 12.5 kHz settings
-			write_I2C_reg_2byte(I2C_MASTER_SLAVE_ADDR_7BIT, 0x30, 0x40, 0x26 | squelch); // RX on
+			I2C_AT1846S_write_reg_2byte(0x30, 0x40, 0x26 | squelch); // RX on
 		}
 
 		trxUpdateC6000Calibration();
@@ -484,6 +589,7 @@ void trxSetFrequency(int fRx,int fTx, int dmrMode)
 		}
 	}
 	taskEXIT_CRITICAL();
+	unlock_SPI_bus();
 }
 
 int trxGetFrequency(void)
@@ -526,12 +632,12 @@ void trx_setTX(void)
 
 void trxAT1846RxOff(void)
 {
-	set_clear_I2C_reg_2byte_with_mask(0x30, 0xFF, 0xDF, 0x00, 0x00);
+	I2C_AT1846S_set_clear_reg_2byte_with_mask(0x30, 0xFF, 0xDF, 0x00, 0x00);
 }
 
 void trxAT1846RxOn(void)
 {
-	set_clear_I2C_reg_2byte_with_mask(0x30, 0xFF, 0xFF, 0x00, 0x20);
+	I2C_AT1846S_set_clear_reg_2byte_with_mask(0x30, 0xFF, 0xFF, 0x00, 0x20);
 }
 
 void trxActivateRx(void)
@@ -545,6 +651,8 @@ void trxActivateRx(void)
 
 	txPAEnabled=false;
 
+	trxFastTuneEnd();// The receiver is going back on the current frequency
+
     if (trxCurrentBand[TRX_RX_FREQ_BAND] == RADIO_BAND_VHF)
 	{
 		GPIO_PinWrite(GPIO_VHF_RX_amp_power, Pin_VHF_RX_amp_power, 1);// VHF pre-amp on
@@ -558,42 +666,42 @@ void trxActivateRx(void)
 
 	if (currentBandWidthIs25kHz)
 	{
-		write_I2C_reg_2byte(I2C_MASTER_SLAVE_ADDR_7BIT, 0x30, 0x70, 0x06); 		// 25 kHz settings // RX off
+		I2C_AT1846S_write_reg_2byte(0x30, 0x70, 0x06); 		// 25 kHz settings // RX off
 	}
 	else
 	{
-		write_I2C_reg_2byte(I2C_MASTER_SLAVE_ADDR_7BIT, 0x30, 0x40, 0x06); 		// 12.5 kHz settings // RX off
+		I2C_AT1846S_write_reg_2byte(0x30, 0x40, 0x06); 		// 12.5 kHz settings // RX off
 	}
 
-	write_I2C_reg_2byte(I2C_MASTER_SLAVE_ADDR_7BIT, 0x29, rx_fh_h, rx_fh_l);
-	write_I2C_reg_2byte(I2C_MASTER_SLAVE_ADDR_7BIT, 0x2a, rx_fl_h, rx_fl_l);
+	I2C_AT1846S_write_reg_2byte(0x29, rx_fh_h, rx_fh_l);
+	I2C_AT1846S_write_reg_2byte(0x2a, rx_fl_h, rx_fl_l);
 
 	if (currentBandWidthIs25kHz)
 	{
-		write_I2C_reg_2byte(I2C_MASTER_SLAVE_ADDR_7BIT, 0x30, 0x70, 0x26); // 25 kHz settings // RX on
+		I2C_AT1846S_write_reg_2byte(0x30, 0x70, 0x26); // 25 kHz settings // RX on
 	}
 	else
 	{
-		write_I2C_reg_2byte(I2C_MASTER_SLAVE_ADDR_7BIT, 0x30, 0x40, 0x26); // 12.5 kHz settings // RX on
+		I2C_AT1846S_write_reg_2byte(0x30, 0x40, 0x26); // 12.5 kHz settings // RX on
 	}
 }
 
 void trxActivateTx(void)
 {
 	txPAEnabled=true;
-	write_I2C_reg_2byte(I2C_MASTER_SLAVE_ADDR_7BIT, 0x29, tx_fh_h, tx_fh_l);
-	write_I2C_reg_2byte(I2C_MASTER_SLAVE_ADDR_7BIT, 0x2a, tx_fl_h, tx_fl_l);
+	I2C_AT1846S_write_reg_2byte(0x29, tx_fh_h, tx_fh_l);
+	I2C_AT1846S_write_reg_2byte(0x2a, tx_fl_h, tx_fl_l);
 
-	set_clear_I2C_reg_2byte_with_mask(0x30, 0xFF, 0x1F, 0x00, 0x00); // Clear Tx and Rx bits
+	I2C_AT1846S_set_clear_reg_2byte_with_mask(0x30, 0xFF, 0x1F, 0x00, 0x00); // Clear Tx and Rx bits
 	if (currentMode == RADIO_MODE_ANALOG)
 	{
-		set_clear_I2C_reg_2byte_with_mask(0x30, 0xFF, 0x1F, 0x00, 0x40); // analog TX
+		I2C_AT1846S_set_clear_reg_2byte_with_mask(0x30, 0xFF, 0x1F, 0x00, 0x40); // analog TX
 		trxSelectVoiceChannel(AT1846_VOICE_CHANNEL_MIC);// For 1750 tone burst
 		setMicGainFM(nonVolatileSettings.micGainFM);
 	}
 	else
 	{
-		set_clear_I2C_reg_2byte_with_mask(0x30, 0xFF, 0x1F, 0x00, 0xC0); // digital TX
+		I2C_AT1846S_set_clear_reg_2byte_with_mask(0x30, 0xFF, 0x1F, 0x00, 0xC0); // digital TX
 	}
 
 	// TX PA on
@@ -705,6 +813,7 @@ void trxUpdateC6000Calibration(void)
 {
 	uint32_t band_offset=0x00000000;
 	uint32_t freq_offset=0x00000000;
+	const calibrationBandValues_t *calibration;
 
 	if (nonVolatileSettings.useCalibration==false)
 	{
@@ -712,37 +821,29 @@ void trxUpdateC6000Calibration(void)
 	}
 
 	trxCalcBandAndFrequencyOffset(&band_offset, &freq_offset);
+	calibration = calibrationGetBandValues(trxCurrentBand[TRX_RX_FREQ_BAND]);
 
 	write_SPI_page_reg_byte_SPI0(0x04, 0x00, 0x3F); // Reset HR-C6000 state
-
-	uint8_t val_shift;
-	read_val_DACDATA_shift(band_offset,&val_shift);
-	write_SPI_page_reg_byte_SPI0(0x04, 0x37, val_shift); // DACDATA shift (LIN_VOL)
-
-	uint8_t val_0x04;
-	read_val_Q_MOD2_offset(band_offset,&val_0x04);
-	write_SPI_page_reg_byte_SPI0(0x04, 0x04, val_0x04); // MOD2 offset
-
-	uint8_t val_0x46;
-	read_val_phase_reduce(band_offset+freq_offset,&val_0x46);
-	write_SPI_page_reg_byte_SPI0(0x04, 0x46, val_0x46); // phase reduce
-
-	uint8_t val_0x47;
-	uint8_t val_0x48;
-	read_val_twopoint_mod(band_offset,&val_0x47, &val_0x48);
-	write_SPI_page_reg_byte_SPI0(0x04, 0x48, val_0x48); // bit 0 to 1 = upper 2 bits of 10-bit twopoint mod
-	write_SPI_page_reg_byte_SPI0(0x04, 0x47, val_0x47); // bit 0 to 7 = lower 8 bits of 10-bit twopoint mod
+	write_SPI_page_reg_byte_SPI0(0x04, 0x37, calibration->DACDataShift); // DACDATA shift (LIN_VOL)
+	write_SPI_page_reg_byte_SPI0(0x04, 0x04, calibration->QMod2Offset); // MOD2 offset
+	write_SPI_page_reg_byte_SPI0(0x04, 0x46, calibration->phaseReduce[freq_offset]); // phase reduce
+	write_SPI_page_reg_byte_SPI0(0x04, 0x48, calibration->twoPointMod48); // bit 0 to 1 = upper 2 bits of 10-bit twopoint mod
+	write_SPI_page_reg_byte_SPI0(0x04, 0x47, calibration->twoPointMod47); // bit 0 to 7 = lower 8 bits of 10-bit twopoint mod
 }
 
 void I2C_AT1846_set_register_with_mask(uint8_t reg, uint16_t mask, uint16_t value, uint8_t shift)
 {
-	set_clear_I2C_reg_2byte_with_mask(reg, (mask & 0xff00) >> 8, (mask & 0x00ff) >> 0, ((value << shift) & 0xff00) >> 8, ((value << shift) & 0x00ff) >> 0);
+	I2C_AT1846S_set_clear_reg_2byte_with_mask(reg, (mask & 0xff00) >> 8, (mask & 0x00ff) >> 0, ((value << shift) & 0xff00) >> 8, ((value << shift) & 0x00ff) >> 0);
 }
 
 void trxUpdateAT1846SCalibration(void)
 {
 	uint32_t band_offset=0x00000000;
 	uint32_t freq_offset=0x00000000;
+	const calibrationBandValues_t *calibration;
+	int bw = (currentBandWidthIs25kHz ? CALIBRATION_WIDEBAND : CALIBRATION_NARROWBAND);
+	uint8_t dac_vgain_analog;
+	uint8_t volume_analog;
 
 	if (nonVolatileSettings.useCalibration==false)
 	{
@@ -750,42 +851,14 @@ void trxUpdateAT1846SCalibration(void)
 	}
 
 	trxCalcBandAndFrequencyOffset(&band_offset, &freq_offset);
+	calibration = calibrationGetBandValues(trxCurrentBand[TRX_RX_FREQ_BAND]);
 
-	uint8_t val_pga_gain;
-	uint8_t gain_tx;
-	uint8_t padrv_ibit;
-
-	uint16_t xmitter_dev;
-
-	uint8_t dac_vgain_analog;
-	uint8_t volume_analog;
-
-	uint16_t noise1_th;
-	uint16_t noise2_th;
-	uint16_t rssi3_th;
-
-	uint16_t squelch_th;
-
-	read_val_pga_gain(band_offset, &val_pga_gain);
-	read_val_voice_gain_tx(band_offset, &voice_gain_tx);
-	read_val_gain_tx(band_offset, &gain_tx);
-	read_val_padrv_ibit(band_offset, &padrv_ibit);
-
-	if (currentBandWidthIs25kHz)
-	{
-		// 25 kHz settings
-		read_val_xmitter_dev_wideband(band_offset, &xmitter_dev);
-	}
-	else
-	{
-		// 12.5 kHz settings
-		read_val_xmitter_dev_narrowband(band_offset, &xmitter_dev);
-	}
+	voice_gain_tx = calibration->voiceGainTx;
 
 	if (currentMode == RADIO_MODE_ANALOG)
 	{
-		read_val_dac_vgain_analog(band_offset, &dac_vgain_analog);
-		read_val_volume_analog(band_offset, &volume_analog);
+		dac_vgain_analog = calibration->dacVgainAnalog;
+		volume_analog = calibration->volumeAnalog;
 	}
 	else
 	{
@@ -793,45 +866,24 @@ void trxUpdateAT1846SCalibration(void)
 		volume_analog = 0x0C;
 	}
 
-	if (currentBandWidthIs25kHz)
-	{
-		// 25 kHz settings
-		read_val_noise1_th_wideband(band_offset, &noise1_th);
-		read_val_noise2_th_wideband(band_offset, &noise2_th);
-		read_val_rssi3_th_wideband(band_offset, &rssi3_th);
-
-		read_val_squelch_th(band_offset+freq_offset, 0, &squelch_th);
-	}
-	else
-	{
-		// 12.5 kHz settings
-		read_val_noise1_th_narrowband(band_offset, &noise1_th);
-		read_val_noise2_th_narrowband(band_offset, &noise2_th);
-		read_val_rssi3_th_narrowband(band_offset, &rssi3_th);
-
-		read_val_squelch_th(band_offset+freq_offset, 3, &squelch_th);
-	}
-
-	I2C_AT1846_set_register_with_mask(0x0A, 0xF83F, val_pga_gain, 6);
+	// Fields which share the same register are combined, so that each register is only read and written once
+	I2C_AT1846_set_register_with_mask(0x0A, 0x803F, (calibration->padrvIbit << 5) | calibration->pgaGain, 6);// padrv_ibit bits 11-14, pga_gain bits 6-10
 	I2C_AT1846_set_register_with_mask(0x41, 0xFF80, voice_gain_tx, 0);
-	I2C_AT1846_set_register_with_mask(0x44, 0xF0FF, gain_tx, 8);
-
-	I2C_AT1846_set_register_with_mask(0x59, 0x003f, xmitter_dev, 6);
-	I2C_AT1846_set_register_with_mask(0x44, 0xFF0F, dac_vgain_analog, 4);
-	I2C_AT1846_set_register_with_mask(0x44, 0xFFF0, volume_analog, 0);
-
-	I2C_AT1846_set_register_with_mask(0x48, 0x0000, noise1_th, 0);
-	I2C_AT1846_set_register_with_mask(0x60, 0x0000, noise2_th, 0);
-	I2C_AT1846_set_register_with_mask(0x3f, 0x0000, rssi3_th, 0);
-
-	I2C_AT1846_set_register_with_mask(0x0A, 0x87FF, padrv_ibit, 11);
-
-	I2C_AT1846_set_register_with_mask(0x49, 0x0000, squelch_th, 0);
+	I2C_AT1846_set_register_with_mask(0x44, 0xF000, (calibration->gainTx << 8) | (dac_vgain_analog << 4) | volume_analog, 0);
+	I2C_AT1846_set_register_with_mask(0x59, 0x003f, calibration->xmitterDev[bw], 6);
+
+	// Whole register values, no need to read them first
+	I2C_AT1846S_write_reg_2byte(0x48, (calibration->noise1Th[bw] >> 8), (calibration->noise1Th[bw] & 0xff));
+	I2C_AT1846S_write_reg_2byte(0x60, (calibration->noise2Th[bw] >> 8), (calibration->noise2Th[bw] & 0xff));
+	I2C_AT1846S_write_reg_2byte(0x3f, (calibration->rssi3Th[bw] >> 8), (calibration->rssi3Th[bw] & 0xff));
+	I2C_AT1846S_write_reg_2byte(0x49, (calibration->squelchTh[freq_offset][bw] >> 8), (calibration->squelchTh[freq_offset][bw] & 0xff));
 }
 
 void trxSetDMRColourCode(int colourCode)
 {
+	lock_SPI_bus();
 	write_SPI_page_reg_byte_SPI0(0x04, 0x1F, (colourCode << 4)); // DMR Colour code in upper 4 bits.
+	unlock_SPI_bus();
 	currentCC = colourCode;
 }
 
@@ -898,16 +950,16 @@ void trxSetTxCTCSS(int toneFreqX10)
 	if (!codeplugChannelToneIsCTCSS(toneFreqX10))
 	{
 		// tone value of 0xffff in the codeplug seem to be a flag that no tone has been selected
-        write_I2C_reg_2byte(I2C_MASTER_SLAVE_ADDR_7BIT, 0x4a, 0x00,0x00); //Zero the CTCSS1 Register
-		set_clear_I2C_reg_2byte_with_mask(0x4e,0xF9,0xFF,0x00,0x00);    //disable the transmit CTCSS
+        I2C_AT1846S_write_reg_2byte(0x4a, 0x00,0x00); //Zero the CTCSS1 Register
+		I2C_AT1846S_set_clear_reg_2byte_with_mask(0x4e,0xF9,0xFF,0x00,0x00);    //disable the transmit CTCSS
 	}
 	else
 	{
 		toneFreqX10 = toneFreqX10*10;// value that is stored is 100 time the tone freq but its stored in the codeplug as freq times 10
-		write_I2C_reg_2byte(I2C_MASTER_SLAVE_ADDR_7BIT,	0x4a, (toneFreqX10 >> 8) & 0xff,	(toneFreqX10 & 0xff));
-		write_I2C_reg_2byte(I2C_MASTER_SLAVE_ADDR_7BIT,	0x4b, 0x00, 0x00); // init cdcss_code
-		write_I2C_reg_2byte(I2C_MASTER_SLAVE_ADDR_7BIT,	0x4c, 0x0A, 0xE3); // init cdcss_code
-		set_clear_I2C_reg_2byte_with_mask(0x4e,0xF9,0xFF,0x06,0x00);    //enable the transmit CTCSS
+		I2C_AT1846S_write_reg_2byte(0x4a, (toneFreqX10 >> 8) & 0xff,	(toneFreqX10 & 0xff));
+		I2C_AT1846S_write_reg_2byte(0x4b, 0x00, 0x00); // init cdcss_code
+		I2C_AT1846S_write_reg_2byte(0x4c, 0x0A, 0xE3); // init cdcss_code
+		I2C_AT1846S_set_clear_reg_2byte_with_mask(0x4e,0xF9,0xFF,0x06,0x00);    //enable the transmit CTCSS
 	}
 	taskEXIT_CRITICAL();
 }
@@ -918,7 +970,7 @@ void trxSetRxCTCSS(int toneFreqX10)
 	if (!codeplugChannelToneIsCTCSS(toneFreqX10))
 	{
 		// tone value of 0xffff in the codeplug seem to be a flag that no tone has been selected
-        write_I2C_reg_2byte(I2C_MASTER_SLAVE_ADDR_7BIT, 0x4d, 0x00,0x00); //Zero the CTCSS2 Register
+        I2C_AT1846S_write_reg_2byte(0x4d, 0x00,0x00); //Zero the CTCSS2 Register
         rxCTCSSactive=false;
 	}
 	else
@@ -926,9 +978,9 @@ void trxSetRxCTCSS(int toneFreqX10)
 		int threshold=(2500-toneFreqX10)/100;   //adjust threshold value to match tone frequency.
 		if(toneFreqX10>2400) threshold=1;
 		toneFreqX10 = toneFreqX10*10;// value that is stored is 100 time the tone freq but its stored in the codeplug as freq times 10
-		write_I2C_reg_2byte(I2C_MASTER_SLAVE_ADDR_7BIT,	0x4d, (toneFreqX10 >> 8) & 0xff,	(toneFreqX10 & 0xff));
-		write_I2C_reg_2byte(I2C_MASTER_SLAVE_ADDR_7BIT, 0x5b,(threshold & 0xFF),(threshold & 0xFF)); //set the detection thresholds
-		set_clear_I2C_reg_2byte_with_mask(0x3a,0xFF,0xE0,0x00,0x08);    //set detection to CTCSS2
+		I2C_AT1846S_write_reg_2byte(0x4d, (toneFreqX10 >> 8) & 0xff,	(toneFreqX10 & 0xff));
+		I2C_AT1846S_write_reg_2byte(0x5b,(threshold & 0xFF),(threshold & 0xFF)); //set the detection thresholds
+		I2C_AT1846S_set_clear_reg_2byte_with_mask(0x3a,0xFF,0xE0,0x00,0x08);    //set detection to CTCSS2
 		rxCTCSSactive=true;
 	}
 	taskEXIT_CRITICAL();
@@ -987,21 +1039,21 @@ void trxSelectVoiceChannel(uint8_t channel) {
 	case AT1846_VOICE_CHANNEL_TONE1:
 	case AT1846_VOICE_CHANNEL_TONE2:
 	case AT1846_VOICE_CHANNEL_DTMF:
-		set_clear_I2C_reg_2byte_with_mask(0x79, 0xff, 0xff, 0xc0, 0x00); // Select single tone
-		set_clear_I2C_reg_2byte_with_mask(0x57, 0xff, 0xfe, 0x00, 0x01); // Audio feedback on
+		I2C_AT1846S_set_clear_reg_2byte_with_mask(0x79, 0xff, 0xff, 0xc0, 0x00); // Select single tone
+		I2C_AT1846S_set_clear_reg_2byte_with_mask(0x57, 0xff, 0xfe, 0x00, 0x01); // Audio feedback on
 
-		read_I2C_reg_2byte(I2C_MASTER_SLAVE_ADDR_7BIT, 0x41, &valh, &trxSaveVoiceGainTx);
+		I2C_AT1846S_read_reg_2byte(0x41, &valh, &trxSaveVoiceGainTx);
 		trxSaveVoiceGainTx &= 0x7f;
 
-		read_I2C_reg_2byte(I2C_MASTER_SLAVE_ADDR_7BIT, 0x59, &valh, &vall);
+		I2C_AT1846S_read_reg_2byte(0x59, &valh, &vall);
 		trxSaveDeviation = (vall + (valh<<8)) >> 6;
 
 		trxUpdateDeviation(channel);
 
-		set_clear_I2C_reg_2byte_with_mask(0x41, 0xff, 0x80, 0x00, 0x05);
+		I2C_AT1846S_set_clear_reg_2byte_with_mask(0x41, 0xff, 0x80, 0x00, 0x05);
 		break;
 	default:
-		set_clear_I2C_reg_2byte_with_mask(0x57, 0xff, 0xfe, 0x00, 0x00); // Audio feedback off
+		I2C_AT1846S_set_clear_reg_2byte_with_mask(0x57, 0xff, 0xfe, 0x00, 0x00); // Audio feedback off
 		if (trxSaveVoiceGainTx != 0xff)
 		{
 			I2C_AT1846_set_register_with_mask(0x41, 0xFF80, trxSaveVoiceGainTx, 0);
@@ -1012,7 +1064,7 @@ void trxSelectVoiceChannel(uint8_t channel) {
 		}
 		break;
 	}
-	set_clear_I2C_reg_2byte_with_mask(0x3a, 0x8f, 0xff, channel, 0x00);
+	I2C_AT1846S_set_clear_reg_2byte_with_mask(0x3a, 0x8f, 0xff, channel, 0x00);
 	taskEXIT_CRITICAL();
 }
 
@@ -1021,7 +1073,7 @@ void trxSetTone1(int toneFreq)
 
 	toneFreq = toneFreq * 10;
 	taskENTER_CRITICAL();
-	write_I2C_reg_2byte(I2C_MASTER_SLAVE_ADDR_7BIT, 0x35, (toneFreq >> 8) & 0xff,	(toneFreq & 0xff));   // tone1_freq
+	I2C_AT1846S_write_reg_2byte(0x35, (toneFreq >> 8) & 0xff,	(toneFreq & 0xff));   // tone1_freq
 	taskEXIT_CRITICAL();
 }
 
@@ -1029,7 +1081,7 @@ void trxSetTone2(int toneFreq)
 {
 	toneFreq = toneFreq * 10;
 	taskENTER_CRITICAL();
-	write_I2C_reg_2byte(I2C_MASTER_SLAVE_ADDR_7BIT, 0x36, (toneFreq >> 8) & 0xff,	(toneFreq & 0xff));   // tone2_freq
+	I2C_AT1846S_write_reg_2byte(0x36, (toneFreq >> 8) & 0xff,	(toneFreq & 0xff));   // tone2_freq
 	taskEXIT_CRITICAL();
 }
 
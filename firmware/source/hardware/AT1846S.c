@@ -143,12 +143,120 @@ const uint8_t AT1846DMRSettings[][AT1846_BYTES_PER_COMMAND] = {
 		{0x3A, 0x40, 0xC2}  // modu_det_sel (SQ setting)
 		};
 
+// RAM copy of the page 0 registers written by the firmware, so that masked updates don't need to read
+// the register first, and writes which would not change the register value can be skipped.
+#define AT1846S_NUM_REGISTERS 128
+static uint16_t AT1846SShadowRegisters[AT1846S_NUM_REGISTERS];
+static uint32_t AT1846SShadowValid[AT1846S_NUM_REGISTERS / 32];
+static bool AT1846SPage1Selected = false;
+
+static inline bool AT1846SShadowIsValid(uint8_t reg)
+{
+	return ((reg < AT1846S_NUM_REGISTERS) && (AT1846SShadowValid[reg >> 5] & (1U << (reg & 0x1F))));
+}
+
+static inline void AT1846SShadowInvalidate(uint8_t reg)
+{
+	if (reg < AT1846S_NUM_REGISTERS)
+	{
+		AT1846SShadowValid[reg >> 5] &= ~(1U << (reg & 0x1F));
+	}
+}
+
+void I2C_AT1846S_invalidate_shadow_registers(void)
+{
+	memset(AT1846SShadowValid, 0, sizeof(AT1846SShadowValid));
+	AT1846SPage1Selected = false;
+}
+
+int I2C_AT1846S_write_reg_2byte(uint8_t reg, uint8_t val1, uint8_t val2)
+{
+	uint16_t value = (val1 << 8) | val2;
+	bool isClashing = (isI2cInUse != 0);
+	int status;
+
+	if (reg == 0x7F)
+	{
+		AT1846SPage1Selected = (value != 0);
+		return write_I2C_reg_2byte(I2C_MASTER_SLAVE_ADDR_7BIT, reg, val1, val2);
+	}
+
+	// Page 1 registers are not cached
+	if (AT1846SPage1Selected || (reg >= AT1846S_NUM_REGISTERS))
+	{
+		return write_I2C_reg_2byte(I2C_MASTER_SLAVE_ADDR_7BIT, reg, val1, val2);
+	}
+
+	if ((reg == 0x30) && (val2 & 0x01))
+	{
+		// Soft reset, all the registers go back to their default values
+		I2C_AT1846S_invalidate_shadow_registers();
+		return write_I2C_reg_2byte(I2C_MASTER_SLAVE_ADDR_7BIT, reg, val1, val2);
+	}
+
+	// Register 0x30 (Rx/Tx control) is always written, as writing it (re)starts the receiver or transmitter
+	if ((reg != 0x30) && AT1846SShadowIsValid(reg) && (AT1846SShadowRegisters[reg] == value))
+	{
+		return kStatus_Success;
+	}
+
+	status = write_I2C_reg_2byte(I2C_MASTER_SLAVE_ADDR_7BIT, reg, val1, val2);
+
+	if ((status == kStatus_Success) && !isClashing)
+	{
+		AT1846SShadowRegisters[reg] = value;
+		AT1846SShadowValid[reg >> 5] |= (1U << (reg & 0x1F));
+	}
+	else
+	{
+		AT1846SShadowInvalidate(reg);
+	}
+
+	return status;
+}
+
+int I2C_AT1846S_set_clear_reg_2byte_with_mask(uint8_t reg, uint8_t mask1, uint8_t mask2, uint8_t val1, uint8_t val2)
+{
+	uint8_t tmp_val1;
+	uint8_t tmp_val2;
+	int status;
+
+	if (!AT1846SPage1Selected && AT1846SShadowIsValid(reg))
+	{
+		tmp_val1 = (AT1846SShadowRegisters[reg] >> 8);
+		tmp_val2 = (AT1846SShadowRegisters[reg] & 0xFF);
+	}
+	else
+	{
+		status = read_I2C_reg_2byte(I2C_MASTER_SLAVE_ADDR_7BIT, reg, &tmp_val1, &tmp_val2);
+		if (status != kStatus_Success)
+		{
+			return status;
+		}
+	}
+
+	return I2C_AT1846S_write_reg_2byte(reg, val1 | (tmp_val1 & mask1), val2 | (tmp_val2 & mask2));
+}
+
+// Only for registers written by the firmware, status registers (like RSSI/Noise or flags) must be read directly.
+int I2C_AT1846S_read_reg_2byte(uint8_t reg, uint8_t *val1, uint8_t *val2)
+{
+	if (!AT1846SPage1Selected && AT1846SShadowIsValid(reg))
+	{
+		*val1 = (AT1846SShadowRegisters[reg] >> 8);
+		*val2 = (AT1846SShadowRegisters[reg] & 0xFF);
+		return kStatus_Success;
+	}
+
+	return read_I2C_reg_2byte(I2C_MASTER_SLAVE_ADDR_7BIT, reg, val1, val2);
+}
+
 void I2C_AT1846S_send_Settings(const uint8_t settings[][3],int numSettings)
 {
 	taskENTER_CRITICAL();
 	for(int i=0;i<numSettings;i++)
 	{
-		write_I2C_reg_2byte(I2C_MASTER_SLAVE_ADDR_7BIT,	settings[i][0], settings[i][1],	settings[i][2]);
+		I2C_AT1846S_write_reg_2byte(settings[i][0], settings[i][1],	settings[i][2]);
 	}
 	taskEXIT_CRITICAL();
 }
@@ -157,23 +265,23 @@ void I2C_AT1846S_init(void)
 {
 	// --- start of AT1846_init()
 	taskENTER_CRITICAL();
-	write_I2C_reg_2byte(I2C_MASTER_SLAVE_ADDR_7BIT, 0x30, 0x00, 0x01); // Soft reset
+	I2C_AT1846S_write_reg_2byte(0x30, 0x00, 0x01); // Soft reset
 	vTaskDelay(portTICK_PERIOD_MS * 50);
 
 	I2C_AT1846S_send_Settings(AT1846InitSettings,sizeof(AT1846InitSettings)/AT1846_BYTES_PER_COMMAND);
 	vTaskDelay(portTICK_PERIOD_MS * 50);
 
-	write_I2C_reg_2byte(I2C_MASTER_SLAVE_ADDR_7BIT, 0x30, 0x40, 0xA6); // chip_cal_en Enable calibration
+	I2C_AT1846S_write_reg_2byte(0x30, 0x40, 0xA6); // chip_cal_en Enable calibration
 	vTaskDelay(portTICK_PERIOD_MS * 100);
 
-	write_I2C_reg_2byte(I2C_MASTER_SLAVE_ADDR_7BIT, 0x30, 0x40, 0x06); // chip_cal_en Disable calibration
+	I2C_AT1846S_write_reg_2byte(0x30, 0x40, 0x06); // chip_cal_en Disable calibration
 	vTaskDelay(portTICK_PERIOD_MS * 10);
 	// Calibration end
 	// --- end of AT1846_init()
 
 	I2C_AT1846S_send_Settings(AT1846FM12P5kHzSettings, sizeof(AT1846FM12P5kHzSettings)/AT1846_BYTES_PER_COMMAND);// initially set the bandwidth for 12.5 kHz
 
-	set_clear_I2C_reg_2byte_with_mask(0x4e, 0xff, 0x3f, 0x00, 0x80); // Select cdcss mode for tx
+	I2C_AT1846S_set_clear_reg_2byte_with_mask(0x4e, 0xff, 0x3f, 0x00, 0x80); // Select cdcss mode for tx
 	taskEXIT_CRITICAL();
 	vTaskDelay(portTICK_PERIOD_MS * 200);
 }
@@ -189,15 +297,15 @@ void I2C_AT1846_SetBandwidth(void)
 	{
 		// 25 kHz settings
 		I2C_AT1846S_send_Settings(AT1846FM25kHzSettings,sizeof(AT1846FM25kHzSettings)/AT1846_BYTES_PER_COMMAND);
-		set_clear_I2C_reg_2byte_with_mask(0x30,0xCF,0x9F,0x30,0x00); // Set the 25Khz Bits and turn off the Rx and Tx
-		set_clear_I2C_reg_2byte_with_mask(0x30,0xFF,0x9F,0x00,0x20); // Turn the Rx On
+		I2C_AT1846S_set_clear_reg_2byte_with_mask(0x30,0xCF,0x9F,0x30,0x00); // Set the 25Khz Bits and turn off the Rx and Tx
+		I2C_AT1846S_set_clear_reg_2byte_with_mask(0x30,0xFF,0x9F,0x00,0x20); // Turn the Rx On
 	}
 	else
 	{
 		// 12.5 kHz settings
 		I2C_AT1846S_send_Settings(AT1846FM12P5kHzSettings, sizeof(AT1846FM12P5kHzSettings)/AT1846_BYTES_PER_COMMAND);
-		set_clear_I2C_reg_2byte_with_mask(0x30,0xCF,0x9F,0x00,0x00); // Clear the 25Khz Bits and turn off the Rx and Tx
-		set_clear_I2C_reg_2byte_with_mask(0x30,0xFF,0x9F,0x00,0x20); // Turn the Rx On
+		I2C_AT1846S_set_clear_reg_2byte_with_mask(0x30,0xCF,0x9F,0x00,0x00); // Clear the 25Khz Bits and turn off the Rx and Tx
+		I2C_AT1846S_set_clear_reg_2byte_with_mask(0x30,0xFF,0x9F,0x00,0x20); // Turn the Rx On
 	}
 }
 
@@ -209,12 +317,12 @@ void I2C_AT1846_SetMode(void)
 		if (trxGetBandwidthIs25kHz())
 		{
 			// 25 kHz settings
-			write_I2C_reg_2byte(I2C_MASTER_SLAVE_ADDR_7BIT, 0x3A, 0x40, 0xCB);
+			I2C_AT1846S_write_reg_2byte(0x3A, 0x40, 0xCB);
 		}
 		else
 		{
 			// 12.5 kHz settings
-			write_I2C_reg_2byte(I2C_MASTER_SLAVE_ADDR_7BIT, 0x3A, 0x44, 0xCB);
+			I2C_AT1846S_write_reg_2byte(0x3A, 0x44, 0xCB);
 		}
 	}
 	else
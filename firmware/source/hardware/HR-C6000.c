@@ -19,9 +19,12 @@
  */
 
 #include <hotspot/dmrDefines.h>
+#include <ambeRecorder.h>
+#include <dmrData.h>
 #include <HR-C6000.h>
 #include <settings.h>
 #include <SeggerRTT/RTT/SEGGER_RTT.h>
+#include <trace.h>
 #include <trx.h>
 #include <hotspot/uiHotspot.h>
 #include <user_interface/uiUtilities.h>
@@ -39,6 +42,14 @@ static const int SYS_INT_PHYSICAL_LAYER			= 0x01;
 static const int WAKEUP_RETRY_PERIOD			= 500;
 
 TaskHandle_t fwhrc6000TaskHandle;
+TaskHandle_t fwhrc6000IrqTaskHandle = NULL;
+
+// Interrupts latched by PORTC_IRQHandler, for fw_hrc6000_irq_task
+#define HRC6000_IRQ_SYS		0x01
+#define HRC6000_IRQ_TS		0x02
+#define HRC6000_IRQ_RF_RX	0x04
+#define HRC6000_IRQ_RF_TX	0x08
+static volatile uint32_t hrc6000PendingInterrupts = 0;
 
 const uint8_t TG_CALL_FLAG = 0x00;
 const uint8_t PC_CALL_FLAG = 0x03;
@@ -72,13 +83,22 @@ volatile uint8_t tmp_val_0x86;
 volatile uint8_t tmp_val_0x90;
 volatile uint8_t tmp_val_0x98;
 
-volatile bool hasEncodedAudio=false;
-volatile bool hotspotDMRTxFrameBufferEmpty=false;
-volatile bool hotspotDMRRxFrameBufferAvailable=false;
-
 volatile uint8_t DMR_frame_buffer[DMR_FRAME_BUFFER_SIZE];
 volatile uint8_t deferredUpdateBuffer[DMR_FRAME_BUFFER_SIZE];
 
+// Received frames, passed from the ISR to the codec or the hotspot in the foreground.
+// The ISR only writes the write index and the foreground only writes the read index
+typedef struct
+{
+	uint32_t timestamp;// PITCounter when the frame was received
+	uint8_t data[DMR_FRAME_BUFFER_SIZE];// Same layout as DMR_frame_buffer. LC, audio, then the hotspot command, sequence number and timeslot
+} dmrRxFrame_t;
+
+static dmrRxFrame_t dmrRxFrameQueue[DMR_RX_FRAME_QUEUE_SIZE];
+static volatile uint8_t dmrRxFrameQueueWriteIdx = 0;
+static volatile uint8_t dmrRxFrameQueueReadIdx = 0;
+volatile dmrRxFrameQueueStats_t dmrRxFrameQueueStats;
+
 
 static volatile int int_timeout;
 
@@ -322,7 +342,9 @@ void SPI_C6000_postinit(void)
 
 void setMicGainDMR(uint8_t gain)
 {
+	lock_SPI_bus();
 	write_SPI_page_reg_byte_SPI0(0x04, 0xE4, 0x40 + gain);  //CODEC   LineOut Gain 2dB, Mic Stage 1 Gain 0dB, Mic Stage 2 Gain default is 11 =  33dB
+	unlock_SPI_bus();
 }
 
 static inline bool checkTimeSlotFilter(void)
@@ -369,14 +391,22 @@ bool checkTalkGroupFilter(void)
 			break;
 		case DMR_FILTER_CC_TS_RXG:
 			{
-				for(int i=0; i< currentRxGroupData.NOT_IN_CODEPLUG_numTGsInGroup;i++)
+				// Binary search of the sorted TGs. Branch free, so the time taken is the same for every burst
+				const uint32_t *base = currentRxGroupData.NOT_IN_CODEPLUG_sortedTGs;
+				int n = currentRxGroupData.NOT_IN_CODEPLUG_numTGsInGroup;
+				uint32_t tg = receivedTgOrPcId;
+
+				if (n == 0)
 				{
-					if (currentRxGroupData.NOT_IN_CODEPLUG_contactsTG[i]==receivedTgOrPcId)
-					{
-						return true;
-					}
+					return false;
 				}
-				return false;
+				while (n > 1)
+				{
+					int half = n / 2;
+					base = (base[half] <= tg) ? (base + half) : base;
+					n -= half;
+				}
+				return (*base == tg);
 			}
 			break;
 		default:
@@ -443,33 +473,86 @@ void transmitTalkerAlias(void)
 
 void PORTC_IRQHandler(void)
 {
+	BaseType_t higherPriorityTaskWoken = pdFALSE;
+	uint32_t pending = 0;
+
+	// Only latch which interrupts are pending. The SPI work is done by fw_hrc6000_irq_task
     if ((1U << Pin_INT_C6000_SYS) & PORT_GetPinsInterruptFlags(Port_INT_C6000_SYS))
     {
-    	HRC6000SysInterruptHandler();
+    	pending |= HRC6000_IRQ_SYS;
         PORT_ClearPinsInterruptFlags(Port_INT_C6000_SYS, (1U << Pin_INT_C6000_SYS));
     }
     if ((1U << Pin_INT_C6000_TS) & PORT_GetPinsInterruptFlags(Port_INT_C6000_TS))
     {
-    	HRC6000TimeslotInterruptHandler();
+    	pending |= HRC6000_IRQ_TS;
         PORT_ClearPinsInterruptFlags(Port_INT_C6000_TS, (1U << Pin_INT_C6000_TS));
     }
     if ((1U << Pin_INT_C6000_RF_RX) & PORT_GetPinsInterruptFlags(Port_INT_C6000_RF_RX))
     {
-    	HRC6000RxInterruptHandler();
+    	pending |= HRC6000_IRQ_RF_RX;
         PORT_ClearPinsInterruptFlags(Port_INT_C6000_RF_RX, (1U << Pin_INT_C6000_RF_RX));
     }
     if ((1U << Pin_INT_C6000_RF_TX) & PORT_GetPinsInterruptFlags(Port_INT_C6000_RF_TX))
     {
-    	HRC6000TxInterruptHandler();
-
+    	pending |= HRC6000_IRQ_RF_TX;
         PORT_ClearPinsInterruptFlags(Port_INT_C6000_RF_TX, (1U << Pin_INT_C6000_RF_TX));
     }
 
-    int_timeout=0;
+    hrc6000PendingInterrupts |= pending;
+    if ((pending != 0) && (fwhrc6000IrqTaskHandle != NULL))
+    {
+    	vTaskNotifyGiveFromISR(fwhrc6000IrqTaskHandle, &higherPriorityTaskWoken);
+    }
 
     /* Add for ARM errata 838869, affects Cortex-M4, Cortex-M4F Store immediate overlapping
     exception return operation might vector to incorrect interrupt */
     __DSB();
+
+    portYIELD_FROM_ISR(higherPriorityTaskWoken);
+}
+
+// Bottom half of PORTC_IRQHandler. Runs at the highest task priority, so it pre-empts everything except interrupts
+void fw_hrc6000_irq_task(void *data)
+{
+	uint32_t pending;
+
+	while (1U)
+	{
+		lock_SPI_bus();
+
+		// Fetched once the bus is ours, so that anything cleared by terminate_digital() in the meantime is not handled
+		taskENTER_CRITICAL();
+		pending = hrc6000PendingInterrupts;
+		hrc6000PendingInterrupts = 0;
+		taskEXIT_CRITICAL();
+
+		if (pending & HRC6000_IRQ_SYS)
+		{
+			HRC6000SysInterruptHandler();
+		}
+		if (pending & HRC6000_IRQ_TS)
+		{
+			HRC6000TimeslotInterruptHandler();
+		}
+		if (pending & HRC6000_IRQ_RF_RX)
+		{
+			HRC6000RxInterruptHandler();
+		}
+		if (pending & HRC6000_IRQ_RF_TX)
+		{
+			HRC6000TxInterruptHandler();
+		}
+
+		unlock_SPI_bus();
+
+		if (pending != 0)
+		{
+			int_timeout=0;
+		}
+
+		// Waiting at the end of the loop handles anything PORTC_IRQHandler latched before this task was created, when it couldn't be notified
+		ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+	}
 }
 
 
@@ -479,7 +562,7 @@ inline static void HRC6000SysSendRejectedInt(void)
 		Bit7: In DMR mode: indicates that the transmission request rejects the interrupt without a sub-status register.
 		In DMR mode, it indicates that this transmission request is rejected because the channel is busy;
 	 */
-//	SEGGER_RTT_printf(0, "%d SYS_INT_SEND_REQUEST_REJECTED\n",PITCounter);
+	TRACE(TRACE_EVENT_DMR_SEND_REJECTED, 0, 0);
 }
 
 inline static void HRC6000SysSendStartInt(void)
@@ -491,7 +574,7 @@ inline static void HRC6000SysSendStartInt(void)
 
 	read_SPI_page_reg_byte_SPI0(0x04, 0x84, &tmp_val_0x84);  //Read sub status register
 
-//	SEGGER_RTT_printf(0, "%d SYS_INT_SEND_START 0x%02x 0x%02x\n",PITCounter,tmp_val_0x84);
+	TRACE(TRACE_EVENT_DMR_SEND_START, tmp_val_0x84, 0);
 
 	/*
 		The sub-status registers indicate
@@ -527,7 +610,7 @@ inline static void HRC6000SysSendEndInt(void)
 	*/
 //	read_SPI_page_reg_byte_SPI0(0x04, 0x86, &tmp_val_0x86);  //Read Interrupt Flag Register2
 
-//	SEGGER_RTT_printf(0, "%d SYS_INT_SEND_END 0x%02x\n",PITCounter,tmp_val_0x86);
+	TRACE(TRACE_EVENT_DMR_SEND_END, 0, 0);
 	/*
 		In DMR mode, there is a sub-status register 0x86 at the end of the transmission, and the
 		corresponding interrupt can be masked by 0x87. The sub-status register indicates six interrupts that
@@ -562,6 +645,32 @@ inline static void HRC6000SysSendEndInt(void)
 	*/
 }
 
+// Queue a received frame for the foreground, with the current LC. The audio is read from the HR-C6000 when readAudio is true
+static inline void dmrRxFrameQueuePut(uint8_t hotspotCommand, uint8_t sequenceNumber, bool readAudio)
+{
+	dmrRxFrame_t *frame;
+
+	if ((uint8_t)(dmrRxFrameQueueWriteIdx - dmrRxFrameQueueReadIdx) >= DMR_RX_FRAME_QUEUE_SIZE)
+	{
+		dmrRxFrameQueueStats.dropped++;
+		return;
+	}
+
+	frame = &dmrRxFrameQueue[dmrRxFrameQueueWriteIdx & (DMR_RX_FRAME_QUEUE_SIZE - 1)];
+	frame->timestamp = PITCounter;
+	memcpy(frame->data, (uint8_t *)DMR_frame_buffer, 0x0C);
+	if (readAudio)
+	{
+		read_SPI_page_reg_bytearray_SPI1(0x03, 0x00, frame->data + 0x0C, 27);
+	}
+	frame->data[27 + 0x0c] = hotspotCommand;
+	frame->data[27 + 0x0c + 1] = sequenceNumber;
+	frame->data[27 + 0x0c + 2] = timeCode;
+
+	dmrRxFrameQueueWriteIdx++;
+	dmrRxFrameQueueStats.received++;
+}
+
 inline static void HRC6000SysPostAccessInt(void)
 {
 	/*
@@ -578,7 +687,8 @@ inline static void HRC6000SysPostAccessInt(void)
 	// Late entry into ongoing RX
 	if (slot_state == DMR_STATE_IDLE)
 {
-		init_codec();
+		init_codec();// Resets the BER of the new call
+		codecAGCReset();
 		GPIO_PinWrite(GPIO_LEDgreen, Pin_LEDgreen, 1);
 
 		write_SPI_page_reg_byte_SPI0(0x04, 0x41, 0x50);     //Receive only in next timeslot
@@ -589,8 +699,7 @@ inline static void HRC6000SysPostAccessInt(void)
 
 		if (settingsUsbMode == USB_MODE_HOTSPOT)
 		{
-			DMR_frame_buffer[27 + 0x0c] = HOTSPOT_RX_START_LATE;
-			hotspotDMRRxFrameBufferAvailable=true;
+			dmrRxFrameQueuePut(HOTSPOT_RX_START_LATE, 0, false);
 		}
 	}
 }
@@ -598,7 +707,6 @@ inline static void HRC6000SysPostAccessInt(void)
 
 inline static void HRC6000SysReceivedDataInt(void)
 {
-	//SEGGER_RTT_printf(0, "%d SYS_INT_RECEIVED_DATA\n",PITCounter);
 	/*
 		Bit3: 	In DMR mode: indicates that the control frame parsing completion interrupt;
 				In MSK mode: indicates the receive interrupt.
@@ -633,7 +741,7 @@ inline static void HRC6000SysReceivedDataInt(void)
 	rxColorCode 	= (tmp_val_0x52 >> 4) & 0x0f;
 	timeCode =  ((tmp_val_0x52 & 0x04) >> 2);
 */
-	//SEGGER_RTT_printf(0, "\t\tRXDT\taf:%d\tsc:%02x\tcrc:%02x\trpi:%02x\tcc:%d\ttc:%d\t\n",(rxDataType&0x07),rxSyncClass,rxCRCStatus,rpi,rxColorCode,timeCode);
+	TRACE(TRACE_EVENT_DMR_RX_DATA, (rxDataType & 0x07) | (rxSyncClass << 8) | (rxCRCStatus << 16) | (rpi << 24), (rxColorCode & 0xFF) | ((timeCode & 0xFF) << 8));
 
 	if ((slot_state == DMR_STATE_RX_1 || slot_state == DMR_STATE_RX_2) && ( rpi!=0 || rxCRCStatus != true || !checkColourCodeFilter()))
 	{
@@ -659,15 +767,14 @@ inline static void HRC6000SysReceivedDataInt(void)
 
 	if (rxSyncClass==SYNC_CLASS_DATA  && rxDataType == 2)        //Terminator with LC
 	{
-		//SEGGER_RTT_printf(0, "RX_STOP\tTC:%d\n",timeCode);
+		TRACE(TRACE_EVENT_DMR_RX_STOP, timeCode, 0);
 		if (trxDMRMode == DMR_MODE_ACTIVE && callAcceptFilter())
 		{
 			slot_state = DMR_STATE_RX_END;
 
 			if (settingsUsbMode == USB_MODE_HOTSPOT)
 			{
-				DMR_frame_buffer[27 + 0x0c] = HOTSPOT_RX_STOP;
-				hotspotDMRRxFrameBufferAvailable=true;
+				dmrRxFrameQueuePut(HOTSPOT_RX_STOP, 0, false);
 			}
 			return;
 		}
@@ -686,6 +793,16 @@ inline static void HRC6000SysReceivedDataInt(void)
 		skip_count--;
 	}
 
+	// Data Headers and data blocks are passed to the data call receive engine. The HR-C6000 has already removed the FEC
+	if ((rxSyncClass==SYNC_CLASS_DATA) && (rxCRCStatus==true) && (rpi==0) && (settingsUsbMode != USB_MODE_HOTSPOT) &&
+			(dmrDataBurstLength(rxDataType) > 0) && ((trxDMRMode == DMR_MODE_ACTIVE) || checkTimeSlotFilter()) && checkColourCodeFilter())
+	{
+		uint8_t dataBuf[DMR_DATA_BURST_MAX_LENGTH];
+
+		read_SPI_page_reg_bytearray_SPI0(0x02, 0x00, dataBuf, dmrDataBurstLength(rxDataType));
+		dmrDataQueueBurst(rxDataType, timeCode, dataBuf);
+	}
+
 	// Check for correct received packet
 	if ((rxCRCStatus==true) && (rpi==0) &&  (slot_state < DMR_STATE_TX_START_1))
 	{
@@ -694,7 +811,8 @@ inline static void HRC6000SysReceivedDataInt(void)
 		{
 			if (checkColourCodeFilter())// Voice LC Header
 			{
-				init_codec();
+				init_codec();// Resets the BER of the new call
+				codecAGCReset();
 				GPIO_PinWrite(GPIO_LEDgreen, Pin_LEDgreen, 1);
 
 				write_SPI_page_reg_byte_SPI0(0x04, 0x41, 0x50);     //Receive only in next timeslot
@@ -705,8 +823,7 @@ inline static void HRC6000SysReceivedDataInt(void)
 
 				if (settingsUsbMode == USB_MODE_HOTSPOT)
 				{
-					DMR_frame_buffer[27 + 0x0c] = HOTSPOT_RX_START;
-					hotspotDMRRxFrameBufferAvailable=true;
+					dmrRxFrameQueuePut(HOTSPOT_RX_START, 0, false);
 				}
 			}
 			else
@@ -731,19 +848,9 @@ inline static void HRC6000SysReceivedDataInt(void)
 				{
 					triggerQSOdataDisplay();
 				}
-				read_SPI_page_reg_bytearray_SPI1(0x03, 0x00, DMR_frame_buffer+0x0C, 27);
-				if (settingsUsbMode == USB_MODE_HOTSPOT)
+				if ((settingsUsbMode == USB_MODE_HOTSPOT) || (settingsPrivateCallMuteMode == false))
 				{
-					DMR_frame_buffer[27 + 0x0c] = HOTSPOT_RX_AUDIO_FRAME;
-					DMR_frame_buffer[27 + 0x0c + 1] = (rxDataType & 0x07);// audio sequence number
-					hotspotDMRRxFrameBufferAvailable=true;
-				}
-				else
-				{
-					if (settingsPrivateCallMuteMode == false)
-					{
-						hasEncodedAudio=true;// tell foreground that there is audio to encode
-					}
+					dmrRxFrameQueuePut(HOTSPOT_RX_AUDIO_FRAME, sequenceNumber, true);// tell foreground that there is audio to decode
 				}
 			}
 		}
@@ -759,7 +866,7 @@ inline static void HRC6000SysReceivedInformationInt(void)
 inline static void HRC6000SysAbnormalExitInt(void)
 {
 	read_SPI_page_reg_byte_SPI0(0x04, 0x98, &tmp_val_0x98);
-//	SEGGER_RTT_printf(0, "%d SYS_INT_ABNORMAL_EXIT 0x%02x\n",PITCounter,tmp_val_0x98);
+	TRACE(TRACE_EVENT_DMR_ABNORMAL_EXIT, tmp_val_0x98, 0);
 	/*
 		Bit1: In DMR mode: indicates that the voice is abnormally exited;
 		In DMR mode, the cause of the abnormality in DMR mode is the unexpected abnormal voice
@@ -785,7 +892,7 @@ inline static void HRC6000SysInterruptHandler(void)
 {
 	uint8_t reg0x52;
 	read_SPI_page_reg_byte_SPI0(0x04, 0x82, &tmp_val_0x82);  //Read Interrupt Flag Register1
-	//SEGGER_RTT_printf(0, "SYS\t0x%02x\n",tmp_val_0x82);
+	TRACE(TRACE_EVENT_DMR_SYS_INT, tmp_val_0x82, slot_state);
 	read_SPI_page_reg_byte_SPI0(0x04, 0x52, &reg0x52);  //Read Received CC and CACH
 	rxColorCode 	= (reg0x52 >> 4) & 0x0f;
 
@@ -920,7 +1027,7 @@ static void HRC6000TransitionToTx(void)
 
 inline static void HRC6000TimeslotInterruptHandler(void)
 {
-	//SEGGER_RTT_printf(0, "TS\tS:%d\tTC:%d\n",slot_state,timeCode);
+	TRACE(TRACE_EVENT_DMR_TIMESLOT, slot_state, timeCode);
 	uint8_t reg0x52;
 	read_SPI_page_reg_byte_SPI0(0x04, 0x52, &reg0x52);  	//Read CACH Register to get the timecode (TS number)
     receivedTimeCode = ((reg0x52 & 0x04) >> 2);				// extract the timecode from the CACH register
@@ -1088,14 +1195,19 @@ inline static void HRC6000TimeslotInterruptHandler(void)
                 }
                 else
                 {
-					if(tx_sequence==0)
-					{
-						write_SPI_page_reg_bytearray_SPI0(0x02, 0x00, (uint8_t*)deferredUpdateBuffer, 0x0c);// put LC into hardware
-					}
-        			write_SPI_page_reg_bytearray_SPI1(0x03, 0x00, (uint8_t*)(deferredUpdateBuffer+0x0C), 27);// send the audio bytes to the hardware
-
-        			hotspotDMRTxFrameBufferEmpty=true;// we have finished with the current frame data from the hotspot
-
+                	// The hotspot frames are taken from the queue of the timeslot being transmitted, at the timeslot rate
+                	if (hotspotTxFrameGet((uint8_t*)deferredUpdateBuffer, true))
+                	{
+                		if(tx_sequence==0)
+                		{
+                			write_SPI_page_reg_bytearray_SPI0(0x02, 0x00, (uint8_t*)deferredUpdateBuffer, 0x0c);// put LC into hardware
+                		}
+                		write_SPI_page_reg_bytearray_SPI1(0x03, 0x00, (uint8_t*)(deferredUpdateBuffer+0x0C), 27);// send the audio bytes to the hardware
+                	}
+                	else
+                	{
+                		write_SPI_page_reg_bytearray_SPI1(0x03, 0x00, (uint8_t*)SILENCE_AUDIO, 27);// queue underrun
+                	}
                 }
 			}
 			else
@@ -1237,13 +1349,13 @@ inline static void HRC6000TimeslotInterruptHandler(void)
 
 void HRC6000RxInterruptHandler(void)
 {
-	//SEGGER_RTT_printf(0, "RxISR\t%d\n",PITCounter);
+	TRACE(TRACE_EVENT_DMR_RX_ISR, 0, 0);
 	trxActivateRx();
 }
 
 void HRC6000TxInterruptHandler(void)
 {
-	//SEGGER_RTT_printf(0, "TxISR\t%d \n",PITCounter);
+	TRACE(TRACE_EVENT_DMR_TX_ISR, 0, 0);
 	trxActivateTx();
 }
 
@@ -1296,6 +1408,10 @@ void terminate_digital(void)
     GPIO_PinWrite(GPIO_LEDgreen, Pin_LEDgreen, 0);
 	init_digital_state();
     NVIC_DisableIRQ(PORTC_IRQn);
+
+	taskENTER_CRITICAL();
+	hrc6000PendingInterrupts = 0;
+	taskEXIT_CRITICAL();
 }
 
 
@@ -1327,6 +1443,14 @@ void init_hrc6000_task(void)
 				4U,                                  /* initial priority */
 				fwhrc6000TaskHandle					 /* optional task handle to create */
 				);
+
+	xTaskCreate(fw_hrc6000_irq_task,                    /* pointer to the task */
+				"fw hrc6000 irq task",                  /* task name for kernel awareness debugging */
+				2000L / sizeof(portSTACK_TYPE),      /* task stack size */
+				NULL,                      			 /* optional task startup argument */
+				5U,                                  /* initial priority */
+				&fwhrc6000IrqTaskHandle				 /* optional task handle to create */
+				);
 }
 
 void fw_hrc6000_task(void *data)
@@ -1349,6 +1473,7 @@ void fw_hrc6000_task(void *data)
 			}
 			else
 			{
+				tick_codec_playback(false);
 				if (trxGetMode() == RADIO_MODE_ANALOG && melody_play==NULL)
 				{
 					taskENTER_CRITICAL();
@@ -1430,15 +1555,12 @@ void tick_HR_C6000(void)
 	{
 		if (slot_state == DMR_STATE_IDLE)
 		{
-			// Because the ISR's also write to the SPI we need to disable interrupts on Port C when doing any SPI transfers.
-			// Otherwise there could be clashes in the SPI subsystem.
-			// This is possibly not the ideal solution, and a better solution may be found at a later date
-			// But at least it should prevent things going too badly wrong
-			NVIC_DisableIRQ(PORTC_IRQn);
+			// The interrupt task also uses the SPI, so the bus must be locked for any SPI transfers
+			lock_SPI_bus();
 			write_SPI_page_reg_byte_SPI0(0x04, 0x40, 0xE3); // TX and RX enable, Active Timing.
 			write_SPI_page_reg_byte_SPI0(0x04, 0x21, 0xA2); // Set Polite to Color Code and Reset vocoder encodingbuffer
 			write_SPI_page_reg_byte_SPI0(0x04, 0x22, 0x86); // Start Vocoder Encode, I2S mode
-			NVIC_EnableIRQ(PORTC_IRQn);
+			unlock_SPI_bus();
 
 			if (trxDMRMode == DMR_MODE_ACTIVE)
 			{
@@ -1448,12 +1570,13 @@ void tick_HR_C6000(void)
 				}
 				else
 				{
-					// Note. We don't increment the buffer indexes, becuase this is also the first frame of audio and we need it later
-					NVIC_DisableIRQ(PORTC_IRQn);
-					write_SPI_page_reg_bytearray_SPI0(0x02, 0x00, (uint8_t *)&audioAndHotspotDataBuffer.hotspotBuffer[wavbuffer_read_idx], 0x0c);// put LC into hardware
-					NVIC_EnableIRQ(PORTC_IRQn);
-					memcpy((uint8_t *)deferredUpdateBuffer,(uint8_t *)&audioAndHotspotDataBuffer.hotspotBuffer[wavbuffer_read_idx],27+0x0C);
-					hotspotDMRTxFrameBufferEmpty=false;
+					// Note. We don't remove the frame from the queue, becuase this is also the first frame of audio and we need it later
+					if (hotspotTxFrameGet((uint8_t *)deferredUpdateBuffer, false))
+					{
+						lock_SPI_bus();
+						write_SPI_page_reg_bytearray_SPI0(0x02, 0x00, (uint8_t *)deferredUpdateBuffer, 0x0c);// put LC into hardware
+						unlock_SPI_bus();
+					}
 				}
 				slot_state = DMR_STATE_TX_START_1;
 			}
@@ -1487,7 +1610,9 @@ void tick_HR_C6000(void)
 			int_timeout++;
 			if (int_timeout==TIMEOUT)
 			{
+				lock_SPI_bus();
 				init_digital();// sets 	int_timeout=0;
+				unlock_SPI_bus();
 				clearActiveDMRID();
 				menuDisplayQSODataState= QSO_DISPLAY_DEFAULT_SCREEN;
 				slot_state = DMR_STATE_IDLE;
@@ -1502,6 +1627,7 @@ void tick_HR_C6000(void)
 
 	if (trxIsTransmitting)
 	{
+		tick_codec_playback(false);
 		if (isWaking == WAKING_MODE_WAITING)
 		{
 			if (repeaterWakeupResponseTimeout > 0)
@@ -1510,11 +1636,11 @@ void tick_HR_C6000(void)
 			}
 			else
 			{
-				NVIC_DisableIRQ(PORTC_IRQn);
+				lock_SPI_bus();
 				write_SPI_page_reg_byte_SPI0(0x04, 0x40, 0xE3); // TX and RX enable, Active Timing.
 				write_SPI_page_reg_byte_SPI0(0x04, 0x21, 0xA2); // Set Polite to Color Code and Reset vocoder encodingbuffer
 				write_SPI_page_reg_byte_SPI0(0x04, 0x22, 0x86); // Start Vocoder Encode, I2S mode
-				NVIC_EnableIRQ(PORTC_IRQn);
+				unlock_SPI_bus();
 				repeaterWakeupResponseTimeout=WAKEUP_RETRY_PERIOD;
 				slot_state = DMR_STATE_REPEATER_WAKE_1;
 			}
@@ -1523,25 +1649,8 @@ void tick_HR_C6000(void)
 		else
 		{
 			// normal operation. Not waking the repeater
-			if (settingsUsbMode == USB_MODE_HOTSPOT)
-			{
-				if (hotspotDMRTxFrameBufferEmpty == true && (wavbuffer_count > 0))
-				{
-					memcpy((uint8_t *)deferredUpdateBuffer,(uint8_t *)&audioAndHotspotDataBuffer.hotspotBuffer[wavbuffer_read_idx],27+0x0C);
-					wavbuffer_read_idx++;
-					if (wavbuffer_read_idx > (HOTSPOT_BUFFER_COUNT-1))
-					{
-						wavbuffer_read_idx=0;
-					}
-
-					if (wavbuffer_count>0)
-					{
-						wavbuffer_count--;
-					}
-					hotspotDMRTxFrameBufferEmpty=false;
-				}
-			}
-			else
+			// In hotspot mode the frames are fetched by the TS ISR
+			if (settingsUsbMode != USB_MODE_HOTSPOT)
 			{
 				// Once there are 6 buffers available they can be encoded into one DMR frame
 				// The will happen  prior to the data being needed in the TS ISR, so that by the time tick_codec_encode encodes complete,
@@ -1549,6 +1658,7 @@ void tick_HR_C6000(void)
 				if (wavbuffer_count >= 6)
 				{
 					tick_codec_encode((uint8_t *)deferredUpdateBuffer);
+					ambeRecorderQueueBurst((uint8_t *)deferredUpdateBuffer, true);
 				}
 			}
 		}
@@ -1560,23 +1670,35 @@ void tick_HR_C6000(void)
 		{
 			trxCheckDigitalSquelch();
 		}
-		// receiving RF DMR
-		if (settingsUsbMode == USB_MODE_HOTSPOT)
+		tick_codec_playback(slot_state == DMR_STATE_IDLE);// Playing a recording, when not receiving
+
+		// receiving RF DMR. Handle all the frames queued by the ISR since the last tick, oldest first
+		while (dmrRxFrameQueueReadIdx != dmrRxFrameQueueWriteIdx)
 		{
-			if (hotspotDMRRxFrameBufferAvailable == true)
+			dmrRxFrame_t *frame = &dmrRxFrameQueue[dmrRxFrameQueueReadIdx & (DMR_RX_FRAME_QUEUE_SIZE - 1)];
+			uint32_t latency = (PITCounter - frame->timestamp);
+
+			if (latency > dmrRxFrameQueueStats.maxLatency)
 			{
-				hotspotRxFrameHandler((uint8_t *)DMR_frame_buffer);
-				hotspotDMRRxFrameBufferAvailable = false;
+				dmrRxFrameQueueStats.maxLatency = latency;
 			}
-		}
-		else
-		{
-			if (hasEncodedAudio)
+
+			if (settingsUsbMode == USB_MODE_HOTSPOT)
 			{
-				hasEncodedAudio=false;
-				tick_codec_decode((uint8_t *)DMR_frame_buffer+0x0C);
+				if (frame->data[27 + 0x0c] == HOTSPOT_RX_AUDIO_FRAME)
+				{
+					codecBERCountFrames(frame->data + 0x0C);
+				}
+				hotspotRxFrameHandler(frame->data);
+			}
+			else
+			{
+				tick_codec_decode(frame->data + 0x0C);
 				tick_RXsoundbuffer();
+				ambeRecorderQueueBurst(frame->data + 0x0C, false);
 			}
+
+			dmrRxFrameQueueReadIdx++;
 		}
 
 		if (qsodata_timer>0)
@@ -35,6 +35,8 @@ void UC1701_setCommandMode();
 void UC1701_setDataMode();
 void UC1701_transfer(register uint8_t data1);
 
+volatile uint8_t ucRenderedRowsMask = 0;// One bit per row sent to the display, used by the screen streaming
+
 #if ! defined(PLATFORM_GD77S)
 void UC1701_setCommandMode()
 {
@@ -47,47 +49,71 @@ void UC1701_setDataMode()
 }
 #endif // ! PLATFORM_GD77S
 
-void ucRenderRows(int16_t startRow, int16_t endRow)
-{
 #if ! defined(PLATFORM_GD77S)
-	uint8_t *rowPos = (screenBuf + startRow*128);
+// Transfer part of a row (startColumn to endColumn - 1) of the screen buffer to the display
+static void ucRenderRowColumns(int16_t row, int16_t startColumn, int16_t endColumn)
+{
+	uint8_t *rowPos = (screenBuf + row*128 + startColumn);
+#if defined(PLATFORM_RD5R)
+	int16_t x = startColumn;
+#else
+	int16_t x = startColumn + 4;// Note there are 4 pixels at the left which are no in the hardware of the LCD panel, but are in the RAM buffer of the controller
+#endif
 
-	for(int16_t row=startRow;row<endRow;row++)
+	UC1701_setCommandMode();
+	UC1701_transfer(0xb0 | row); // set Y
+	UC1701_transfer(0x10 | ((x >> 4) & 0x0F)); // set X (high MSB)
+	UC1701_transfer(0x00 | (x & 0x0F)); // set X (low MSB).
+
+	UC1701_setDataMode();
+	uint8_t data1;
+	for(int16_t line=startColumn;line<endColumn;line++)
 	{
-		UC1701_setCommandMode();
-		UC1701_transfer(0xb0 | row); // set Y
-		UC1701_transfer(0x10 | 0); // set X (high MSB)
+		data1= *rowPos;
+		for (register int i=0; i<8; i++)
+		{
 
-// Note there are 4 pixels at the left which are no in the hardware of the LCD panel, but are in the RAM buffer of the controller
-#if !defined(PLATFORM_RD5R)
-		UC1701_transfer(0x00 | 4); // set X (low MSB).
-#endif
+			GPIO_Display_SCK->PCOR = 1U << Pin_Display_SCK;
 
-		UC1701_setDataMode();
-		uint8_t data1;
-		for(int16_t line=0;line<128;line++)
-		{
-			data1= *rowPos;
-			for (register int i=0; i<8; i++)
+			if ((data1&0x80) == 0U)
 			{
+				GPIO_Display_SDA->PCOR = 1U << Pin_Display_SDA;// Hopefully the compiler will optimise this to a value rather than using a shift
+			}
+			else
+			{
+				GPIO_Display_SDA->PSOR = 1U << Pin_Display_SDA;// Hopefully the compiler will optimise this to a value rather than using a shift
+			}
 
-				GPIO_Display_SCK->PCOR = 1U << Pin_Display_SCK;
+			GPIO_Display_SCK->PSOR = 1U << Pin_Display_SCK;// Hopefully the compiler will optimise this to a value rather than using a shift
 
-				if ((data1&0x80) == 0U)
-				{
-					GPIO_Display_SDA->PCOR = 1U << Pin_Display_SDA;// Hopefully the compiler will optimise this to a value rather than using a shift
-				}
-				else
-				{
-					GPIO_Display_SDA->PSOR = 1U << Pin_Display_SDA;// Hopefully the compiler will optimise this to a value rather than using a shift
-				}
+			data1=data1<<1;
+		}
+		rowPos++;
+	}
+}
+#endif // ! PLATFORM_GD77S
 
-				GPIO_Display_SCK->PSOR = 1U << Pin_Display_SCK;// Hopefully the compiler will optimise this to a value rather than using a shift
+void ucRenderRows(int16_t startRow, int16_t endRow)
+{
+#if ! defined(PLATFORM_GD77S)
+	ucRenderedRowsMask |= ((1 << endRow) - 1) & ~((1 << startRow) - 1);
 
-				data1=data1<<1;
-			}
-			rowPos++;
-		}
+	for(int16_t row=startRow;row<endRow;row++)
+	{
+		ucRenderRowColumns(row, 0, 128);
+	}
+#endif // ! PLATFORM_GD77S
+}
+
+// Only transfer part of the rows (startColumn to endColumn - 1), for small areas of the screen which are updated often
+void ucRenderColumns(int16_t startRow, int16_t endRow, int16_t startColumn, int16_t endColumn)
+{
+#if ! defined(PLATFORM_GD77S)
+	ucRenderedRowsMask |= ((1 << endRow) - 1) & ~((1 << startRow) - 1);
+
+	for(int16_t row=startRow;row<endRow;row++)
+	{
+		ucRenderRowColumns(row, startColumn, endColumn);
 	}
 #endif // ! PLATFORM_GD77S
 }
@@ -0,0 +1,225 @@
+/*
+ *   Copyright (C) 2016 by Jonathan Naylor G4KLX
+ *
+ *   Ported to OpenGD77 by Roger Clark VK3KYY / G4KYF
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+ */
+
+#include <hotspot/Trellis34.h>
+
+// Rate 3/4 Trellis code (ETSI TS 102 361-1 B.2).
+// 48 tribits of payload plus a zero tribit to flush the encoder, each tribit giving one of 16 constellation points (2 dibits).
+// The encoder state is the previous tribit, so there are 8 states and the next state is the input tribit.
+
+#define TRELLIS34_NUM_TRIBITS	49
+#define TRELLIS34_NUM_DIBITS	98
+#define TRELLIS34_NUM_STATES	8
+#define TRELLIS34_MAX_ERRORS	6// Bit errors in the 196 bits, above which the burst is rejected. Random bursts decode with 7 or more
+
+static const unsigned char TRELLIS34_INTERLEAVE_TABLE[TRELLIS34_NUM_DIBITS] = {
+	0U, 1U, 8U,   9U, 16U, 17U, 24U, 25U, 32U, 33U, 40U, 41U, 48U, 49U, 56U, 57U, 64U, 65U, 72U, 73U, 80U, 81U, 88U, 89U, 96U, 97U,
+	2U, 3U, 10U, 11U, 18U, 19U, 26U, 27U, 34U, 35U, 42U, 43U, 50U, 51U, 58U, 59U, 66U, 67U, 74U, 75U, 82U, 83U, 90U, 91U,
+	4U, 5U, 12U, 13U, 20U, 21U, 28U, 29U, 36U, 37U, 44U, 45U, 52U, 53U, 60U, 61U, 68U, 69U, 76U, 77U, 84U, 85U, 92U, 93U,
+	6U, 7U, 14U, 15U, 22U, 23U, 30U, 31U, 38U, 39U, 46U, 47U, 54U, 55U, 62U, 63U, 70U, 71U, 78U, 79U, 86U, 87U, 94U, 95U};
+
+// Constellation point for [state][tribit]
+static const unsigned char TRELLIS34_ENCODE_TABLE[TRELLIS34_NUM_STATES * 8] = {
+	0U,  8U, 4U, 12U, 2U, 10U, 6U, 14U,
+	4U, 12U, 2U, 10U, 6U, 14U, 0U,  8U,
+	1U,  9U, 5U, 13U, 3U, 11U, 7U, 15U,
+	5U, 13U, 3U, 11U, 7U, 15U, 1U,  9U,
+	3U, 11U, 7U, 15U, 1U,  9U, 5U, 13U,
+	7U, 15U, 1U,  9U, 5U, 13U, 3U, 11U,
+	2U, 10U, 6U, 14U, 0U,  8U, 4U, 12U,
+	6U, 14U, 0U,  8U, 4U, 12U, 2U, 10U};
+
+// The 4 bits (2 dibits) sent for each constellation point. Dibit +1 is 00, +3 is 01, -1 is 10 and -3 is 11
+static const unsigned char TRELLIS34_POINT_BITS[16] = {
+	0x2U, 0xAU, 0x7U, 0xFU, 0xEU, 0x6U, 0xBU, 0x3U,
+	0xDU, 0x5U, 0x8U, 0x0U, 0x1U, 0x9U, 0x4U, 0xCU};
+
+static const unsigned char TRELLIS34_BIT_COUNT[16] = { 0U, 1U, 1U, 2U, 1U, 2U, 2U, 3U, 1U, 2U, 2U, 3U, 2U, 3U, 3U, 4U };
+
+// Viterbi decisions (the previous state) for [step][state], packed 4 states per word
+__attribute__((section(".data.$RAM2"))) static uint32_t Trellis34_decisions[TRELLIS34_NUM_TRIBITS][TRELLIS34_NUM_STATES / 4];
+
+// The 196 bits of the payload are split around the 68 bits of the sync / embedded signalling in the middle of the burst
+static inline unsigned int Trellis34_burstBitPosition(unsigned int n)
+{
+	return ((n >= 98U) ? (n + 68U) : n);
+}
+
+static inline unsigned int Trellis34_readBit(const unsigned char* data, unsigned int n)
+{
+	return ((data[n >> 3] >> (7U - (n & 7U))) & 0x01U);
+}
+
+static inline void Trellis34_writeBit(unsigned char* data, unsigned int n, unsigned int bit)
+{
+	if (bit)
+	{
+		data[n >> 3] |= (0x80U >> (n & 7U));
+	}
+	else
+	{
+		data[n >> 3] &= ~(0x80U >> (n & 7U));
+	}
+}
+
+// Per byte of the packed metrics: keep the smaller of best and candidate, and record the decision for the bytes which changed.
+// This is 3 instructions for 4 states on the Cortex-M4
+static inline void Trellis34_selectMin(uint32_t *best, uint32_t candidate, uint32_t *decision, uint32_t decisionValue)
+{
+#if defined(__ARM_FEATURE_SIMD32)
+	__USUB8(candidate, *best);// Sets GE for each byte where candidate >= best
+	*best = __SEL(*best, candidate);
+	*decision = __SEL(*decision, decisionValue);
+#else
+	for (int i = 0; i < 32; i += 8)
+	{
+		if (((candidate >> i) & 0xFFU) < ((*best >> i) & 0xFFU))
+		{
+			*best = (*best & ~(0xFFU << i)) | (candidate & (0xFFU << i));
+			*decision = (*decision & ~(0xFFU << i)) | (decisionValue & (0xFFU << i));
+		}
+	}
+#endif
+}
+
+static inline uint32_t Trellis34_addSaturate(uint32_t a, uint32_t b)
+{
+#if defined(__ARM_FEATURE_SIMD32)
+	return __UQADD8(a, b);
+#else
+	uint32_t result = 0;
+	for (int i = 0; i < 32; i += 8)
+	{
+		uint32_t sum = ((a >> i) & 0xFFU) + ((b >> i) & 0xFFU);
+		result |= (((sum > 0xFFU) ? 0xFFU : sum) << i);
+	}
+	return result;
+#endif
+}
+
+bool Trellis34_decode(const unsigned char* in, unsigned char* out)
+{
+	unsigned char points[TRELLIS34_NUM_TRIBITS];// Received 4 bit values, in constellation point order
+	unsigned char tribits[TRELLIS34_NUM_TRIBITS];
+	uint32_t metrics[TRELLIS34_NUM_STATES / 4];
+
+	memset(points, 0, sizeof(points));
+
+	// De-interleave the received dibits
+	for (unsigned int i = 0U; i < TRELLIS34_NUM_DIBITS; i++)
+	{
+		unsigned int dibit = (Trellis34_readBit(in, Trellis34_burstBitPosition(i * 2U)) << 1) | Trellis34_readBit(in, Trellis34_burstBitPosition(i * 2U + 1U));
+		unsigned int n = TRELLIS34_INTERLEAVE_TABLE[i];
+
+		points[n >> 1] |= (dibit << (((n & 1U) == 0U) ? 2U : 0U));
+	}
+
+	// The encoder always starts in state 0
+	metrics[0] = 0x80808000U;
+	metrics[1] = 0x80808080U;
+
+	for (unsigned int step = 0U; step < TRELLIS34_NUM_TRIBITS; step++)
+	{
+		unsigned char branchMetric[16];
+		uint32_t newMetrics[TRELLIS34_NUM_STATES / 4] = { 0xFFFFFFFFU, 0xFFFFFFFFU };
+		uint32_t *decisions = Trellis34_decisions[step];
+
+		for (unsigned int point = 0U; point < 16U; point++)
+		{
+			branchMetric[point] = TRELLIS34_BIT_COUNT[points[step] ^ TRELLIS34_POINT_BITS[point]];
+		}
+
+		decisions[0] = decisions[1] = 0U;
+
+		// For each previous state, extend its path to all 8 next states at once
+		for (unsigned int prevState = 0U; prevState < TRELLIS34_NUM_STATES; prevState++)
+		{
+			const unsigned char *encode = &TRELLIS34_ENCODE_TABLE[prevState * 8U];
+			uint32_t prevMetric = ((metrics[prevState >> 2] >> ((prevState & 3U) * 8U)) & 0xFFU) * 0x01010101U;
+			uint32_t decisionValue = prevState * 0x01010101U;
+
+			for (unsigned int w = 0U; w < (TRELLIS34_NUM_STATES / 4); w++)
+			{
+				uint32_t branch = branchMetric[encode[w * 4U + 0U]] |
+								(branchMetric[encode[w * 4U + 1U]] << 8) |
+								(branchMetric[encode[w * 4U + 2U]] << 16) |
+								(branchMetric[encode[w * 4U + 3U]] << 24);
+
+				Trellis34_selectMin(&newMetrics[w], Trellis34_addSaturate(prevMetric, branch), &decisions[w], decisionValue);
+			}
+		}
+
+		metrics[0] = newMetrics[0];
+		metrics[1] = newMetrics[1];
+	}
+
+	// The flush tribit is 0, so the path must end in state 0
+	if ((metrics[0] & 0xFFU) > TRELLIS34_MAX_ERRORS)
+	{
+		return false;
+	}
+
+	// Trace back. The state after each step is the tribit which was sent in that step
+	unsigned int state = 0U;
+	for (int step = TRELLIS34_NUM_TRIBITS - 1; step >= 0; step--)
+	{
+		tribits[step] = state;
+		state = (Trellis34_decisions[step][state >> 2] >> ((state & 3U) * 8U)) & 0xFFU;
+	}
+
+	memset(out, 0, 18U);
+	for (unsigned int i = 0U; i < (TRELLIS34_NUM_TRIBITS - 1U); i++)
+	{
+		Trellis34_writeBit(out, i * 3U + 0U, tribits[i] & 0x04U);
+		Trellis34_writeBit(out, i * 3U + 1U, tribits[i] & 0x02U);
+		Trellis34_writeBit(out, i * 3U + 2U, tribits[i] & 0x01U);
+	}
+
+	return true;
+}
+
+void Trellis34_encode(const unsigned char* in, unsigned char* out)
+{
+	unsigned char points[TRELLIS34_NUM_TRIBITS];
+	unsigned int state = 0U;
+
+	for (unsigned int i = 0U; i < TRELLIS34_NUM_TRIBITS; i++)
+	{
+		unsigned int tribit = 0U;// The last tribit flushes the encoder
+
+		if (i < (TRELLIS34_NUM_TRIBITS - 1U))
+		{
+			tribit = (Trellis34_readBit(in, i * 3U) << 2) | (Trellis34_readBit(in, i * 3U + 1U) << 1) | Trellis34_readBit(in, i * 3U + 2U);
+		}
+
+		points[i] = TRELLIS34_POINT_BITS[TRELLIS34_ENCODE_TABLE[state * 8U + tribit]];
+		state = tribit;
+	}
+
+	// Interleave the dibits into the burst, leaving the sync / embedded signalling untouched
+	for (unsigned int i = 0U; i < TRELLIS34_NUM_DIBITS; i++)
+	{
+		unsigned int n = TRELLIS34_INTERLEAVE_TABLE[i];
+		unsigned int dibit = (points[n >> 1] >> (((n & 1U) == 0U) ? 2U : 0U)) & 0x03U;
+
+		Trellis34_writeBit(out, Trellis34_burstBitPosition(i * 2U), dibit & 0x02U);
+		Trellis34_writeBit(out, Trellis34_burstBitPosition(i * 2U + 1U), dibit & 0x01U);
+	}
+}
@@ -124,6 +124,7 @@ M: 2020-01-07 09:52:15.246 DMR Slot 2, received network end of voice transmissio
 #define PROTOCOL_VERSION    1U
 
 #define MMDVM_HEADER_LENGTH 4U
+#define MMDVM_FRAME_MIN_LENGTH 3U
 
 #define HOTSPOT_VERSION_STRING "OpenGD77_HS v0.1.3"
 #define concat(a, b) a " GitID #" b ""
@@ -150,8 +151,26 @@ static uint8_t colorCode = 1;
 static uint8_t rf_power = 255;
 static uint32_t tx_delay = 0;
 static uint32_t savedTGorPC;
-static uint8_t hotspotTxLC[9];
 static bool startedEmbeddedSearch = false;
+static int embeddedSearchSlot = 1;
+static bool duplexMode = false;
+
+// Net (TX) frame queues, one per timeslot, over the hotspot buffers.
+// In simplex all the buffers belong to TS2, which is the only slot MMDVMHost uses. In duplex they are split between TS1 and TS2
+typedef struct
+{
+	volatile int readIdx;
+	volatile int writeIdx;
+	volatile int count;
+	int firstBuffer;
+	int numBuffers;
+	uint8_t LC[9];// Hotspot uses LC Data bytes rather than the src and dst ID's for the embed data
+} hotspotTxQueue_t;
+
+static hotspotTxQueue_t txQueues[2];// TS1, TS2
+static volatile int txSlot = 1;// Queue currently being transmitted
+static bool duplexTxStarted = false;// MMDVM_DMR_START state, net frames are only accepted when it's on (duplex only)
+static int rfRxSlot = 1;// Timeslot of the last RF frame
 
 // USB TX read/write positions and count
 volatile uint16_t usbComSendBufWritePosition = 0;
@@ -175,6 +194,7 @@ static const uint32_t MMDVMHOST_TIMEOUT = 20000; // 20s timeout (MMDVMHost mode
 static bool mmdvmHostIsConnected = false;
 
 static bool displayFWVersion;
+static uint8_t mmdvmRequestCommand;// Command of the frame being handled, for the ACK / NAK
 static uint8_t currentRxCommandState;
 
 static DMRLC_T rxedDMR_LC; // used to stored LC info from RXed frames
@@ -320,10 +340,14 @@ static bool handleEvent(uiEvent_t *ev);
 static void hotspotExit(void);
 static void hotspotStateMachine(void);
 static void processUSBDataQueue(void);
-static void handleHotspotRequest(void);
+static void processUSBRxStream(void);
+static void handleHotspotRequest(volatile const uint8_t *com_requestbuffer);
 static void disableTransmission(void);
 static void cwReset(void);
 static void cwProcess(void);
+static void txQueuesReset(void);
+static void txQueueFlush(int slot);
+static bool rfIsReceivingOnSlot(int slot);
 
 #if defined(MMDVM_SEND_DEBUG)
 static void sendDebug1(const char *text);
@@ -362,6 +386,10 @@ int menuHotspotMode(uiEvent_t *ev, bool isFirstRun)
 
 		memset(&rxedDMR_LC, 0, sizeof(DMRLC_T));// clear automatic variable
 
+		duplexMode = false;
+		duplexTxStarted = false;
+		txQueuesReset();
+
 		// Clear RF buffers
 		rfFrameBufCount = 0;
 		rfFrameBufReadIdx = 0;
@@ -440,11 +468,7 @@ int menuHotspotMode(uiEvent_t *ev, bool isFirstRun)
 	}
 
 	processUSBDataQueue();
-	if (com_request == 1)
-	{
-		handleHotspotRequest();
-		com_request = 0;
-	}
+	processUSBRxStream();
 	hotspotStateMachine();
 
 	// CW beaconing
@@ -751,6 +775,7 @@ static void hotspotExit(void)
 
 	trxDMRID = codeplugGetUserDMRID();
 	settingsUsbMode = USB_MODE_CPS;
+	reset_streambuffer();
 	mmdvmHostIsConnected = false;
 	menuHotspotRestoreSettings();
 	menuSystemPopAllAndDisplayRootMenu();
@@ -854,6 +879,12 @@ static void swapWithFakeTA(uint8_t *lc)
 	}
 }
 
+// In duplex, RF frames are sent to MMDVMHost on the timeslot they were received on
+static uint8_t getRFFrameCommand(volatile const uint8_t *receivedDMRDataAndAudio)
+{
+	return ((duplexMode && (receivedDMRDataAndAudio[27 + 0x0c + 2] == 0)) ? MMDVM_DMR_DATA1 : MMDVM_DMR_DATA2);
+}
+
 static void setRSSIToFrame(uint8_t *frameData)
 {
 	frameData[DMR_FRAME_LENGTH_BYTES + MMDVM_HEADER_LENGTH]      = (trxRxSignal >> 8) & 0xFFU;
@@ -862,7 +893,7 @@ static void setRSSIToFrame(uint8_t *frameData)
 
 static void hotspotSendVoiceFrame(volatile const uint8_t *receivedDMRDataAndAudio)
 {
-	uint8_t frameData[DMR_FRAME_LENGTH_BYTES + MMDVM_HEADER_LENGTH + 2U] = {MMDVM_FRAME_START, (DMR_FRAME_LENGTH_BYTES + MMDVM_HEADER_LENGTH + 2U), MMDVM_DMR_DATA2};
+	uint8_t frameData[DMR_FRAME_LENGTH_BYTES + MMDVM_HEADER_LENGTH + 2U] = {MMDVM_FRAME_START, (DMR_FRAME_LENGTH_BYTES + MMDVM_HEADER_LENGTH + 2U), getRFFrameCommand(receivedDMRDataAndAudio)};
 	uint8_t embData[DMR_FRAME_LENGTH_BYTES];
 	int i;
 	int sequenceNumber = receivedDMRDataAndAudio[27 + 0x0c + 1] - 1;
@@ -898,7 +929,7 @@ static void hotspotSendVoiceFrame(volatile const uint8_t *receivedDMRDataAndAudi
 
 static void sendVoiceHeaderLC_Frame(volatile const uint8_t *receivedDMRDataAndAudio)
 {
-	uint8_t frameData[DMR_FRAME_LENGTH_BYTES + MMDVM_HEADER_LENGTH + 2U] = {MMDVM_FRAME_START, (DMR_FRAME_LENGTH_BYTES + MMDVM_HEADER_LENGTH + 2U), MMDVM_DMR_DATA2, DMR_SYNC_DATA | DT_VOICE_LC_HEADER};
+	uint8_t frameData[DMR_FRAME_LENGTH_BYTES + MMDVM_HEADER_LENGTH + 2U] = {MMDVM_FRAME_START, (DMR_FRAME_LENGTH_BYTES + MMDVM_HEADER_LENGTH + 2U), getRFFrameCommand(receivedDMRDataAndAudio), DMR_SYNC_DATA | DT_VOICE_LC_HEADER};
 
 	DMRLC_T lc;
 
@@ -935,7 +966,7 @@ static void sendVoiceHeaderLC_Frame(volatile const uint8_t *receivedDMRDataAndAu
 
 static void sendTerminator_LC_Frame(volatile const uint8_t *receivedDMRDataAndAudio)
 {
-	uint8_t frameData[DMR_FRAME_LENGTH_BYTES + MMDVM_HEADER_LENGTH + 2U] = {MMDVM_FRAME_START, (DMR_FRAME_LENGTH_BYTES + MMDVM_HEADER_LENGTH + 2U), MMDVM_DMR_DATA2, DMR_SYNC_DATA | DT_TERMINATOR_WITH_LC};
+	uint8_t frameData[DMR_FRAME_LENGTH_BYTES + MMDVM_HEADER_LENGTH + 2U] = {MMDVM_FRAME_START, (DMR_FRAME_LENGTH_BYTES + MMDVM_HEADER_LENGTH + 2U), getRFFrameCommand(receivedDMRDataAndAudio), DMR_SYNC_DATA | DT_TERMINATOR_WITH_LC};
 	DMRLC_T lc;
 
 	memset(&lc, 0, sizeof(DMRLC_T));// clear automatic variable
@@ -967,16 +998,17 @@ static void sendTerminator_LC_Frame(volatile const uint8_t *receivedDMRDataAndAu
 void hotspotRxFrameHandler(uint8_t* frameBuf)
 {
 	taskENTER_CRITICAL();
-	memcpy((uint8_t *)&audioAndHotspotDataBuffer.hotspotBuffer[rfFrameBufWriteIdx], frameBuf, 27 + 0x0c  + 2);// 27 audio + 0x0c header + 2 hotspot signalling bytes
+	memcpy((uint8_t *)&audioAndHotspotDataBuffer.hotspotBuffer[rfFrameBufWriteIdx], frameBuf, 27 + 0x0c  + 3);// 27 audio + 0x0c header + 3 hotspot signalling bytes
 	rfFrameBufCount++;
 	rfFrameBufWriteIdx = ((rfFrameBufWriteIdx + 1) % HOTSPOT_BUFFER_COUNT);
 	taskEXIT_CRITICAL();
 }
 
-static bool getEmbeddedData(volatile const uint8_t *com_requestbuffer)
+static bool getEmbeddedData(volatile const uint8_t *com_requestbuffer, int slot)
 {
 	int             lcss;
 	unsigned char   DMREMB[2U];
+	uint8_t         *hotspotTxLC = txQueues[slot].LC;
 	// the following is used for fake TA
 	static uint32_t oldTrxDMRID = 0;
 	static uint8_t  rawDataCount = 0;
@@ -998,6 +1030,12 @@ static bool getEmbeddedData(volatile const uint8_t *com_requestbuffer)
 	{
 		DMREmbeddedData_initEmbeddedDataBuffers();
 		startedEmbeddedSearch = true;
+		embeddedSearchSlot = slot;
+	}
+	else if (slot != embeddedSearchSlot)
+	{
+		// The embedded data of the other timeslot is being assembled, this slot gets its LC from the Voice Header
+		return false;
 	}
 
 	if (DMREmbeddedData_addData((uint8_t *)com_requestbuffer + MMDVM_HEADER_LENGTH, lcss))
@@ -1113,9 +1151,11 @@ static bool getEmbeddedData(volatile const uint8_t *com_requestbuffer)
 	return false;
 }
 
-static void storeNetFrame(volatile const uint8_t *com_requestbuffer)
+static void storeNetFrame(volatile const uint8_t *com_requestbuffer, int slot)
 {
+	hotspotTxQueue_t *txQueue = &txQueues[slot];
 	bool foundEmbedded;
+	int bufIdx;
 
 	if (memcmp((uint8_t *)&com_requestbuffer[18], END_FRAME_PATTERN, 6) == 0)
 	{
@@ -1127,13 +1167,16 @@ static void storeNetFrame(volatile const uint8_t *com_requestbuffer)
 		return;
 	}
 
-	foundEmbedded = getEmbeddedData(com_requestbuffer);
+	foundEmbedded = getEmbeddedData(com_requestbuffer, slot);
 
+	// While the other timeslot is being transmitted, this slot's frames are only queued
 	if (	(foundEmbedded || (nonVolatileSettings.hotspotType == HOTSPOT_TYPE_BLUEDV))
 			&&
-			(hotspotTxLC[0] == TG_CALL_FLAG || hotspotTxLC[0] == PC_CALL_FLAG) &&
-			(hotspotState != HOTSPOT_STATE_TX_START_BUFFERING && hotspotState != HOTSPOT_STATE_TRANSMITTING))
+			(txQueue->LC[0] == TG_CALL_FLAG || txQueue->LC[0] == PC_CALL_FLAG) &&
+			(hotspotState != HOTSPOT_STATE_TX_START_BUFFERING && hotspotState != HOTSPOT_STATE_TRANSMITTING) &&
+			((slot == txSlot) || (hotspotState != HOTSPOT_STATE_TX_SHUTDOWN)))
 	{
+		txSlot = slot;
 		timeoutCounter = TX_BUFFERING_TIMEOUT;// set buffering timeout
 		hotspotState = HOTSPOT_STATE_TX_START_BUFFERING;
 	}
@@ -1142,19 +1185,22 @@ static void storeNetFrame(volatile const uint8_t *com_requestbuffer)
 		hotspotState == HOTSPOT_STATE_TX_SHUTDOWN  ||
 		hotspotState == HOTSPOT_STATE_TX_START_BUFFERING)
 	{
-		if (wavbuffer_count >= HOTSPOT_BUFFER_COUNT)
+		if (txQueue->count >= txQueue->numBuffers)
 		{
 			// Buffer overflow
+			return;
 		}
 
+		bufIdx = txQueue->firstBuffer + txQueue->writeIdx;
+
 		taskENTER_CRITICAL();
-		memcpy((uint8_t *)&audioAndHotspotDataBuffer.hotspotBuffer[wavbuffer_write_idx][0x0C], (uint8_t *)com_requestbuffer + 4, 13);//copy the first 13, whole bytes of audio
-		audioAndHotspotDataBuffer.hotspotBuffer[wavbuffer_write_idx][0x0C + 13] = (com_requestbuffer[17] & 0xF0) | (com_requestbuffer[23] & 0x0F);
-		memcpy((uint8_t *)&audioAndHotspotDataBuffer.hotspotBuffer[wavbuffer_write_idx][0x0C + 14], (uint8_t *)&com_requestbuffer[24], 13);//copy the last 13, whole bytes of audio
+		memcpy((uint8_t *)&audioAndHotspotDataBuffer.hotspotBuffer[bufIdx][0x0C], (uint8_t *)com_requestbuffer + 4, 13);//copy the first 13, whole bytes of audio
+		audioAndHotspotDataBuffer.hotspotBuffer[bufIdx][0x0C + 13] = (com_requestbuffer[17] & 0xF0) | (com_requestbuffer[23] & 0x0F);
+		memcpy((uint8_t *)&audioAndHotspotDataBuffer.hotspotBuffer[bufIdx][0x0C + 14], (uint8_t *)&com_requestbuffer[24], 13);//copy the last 13, whole bytes of audio
 
-		memcpy((uint8_t *)&audioAndHotspotDataBuffer.hotspotBuffer[wavbuffer_write_idx], hotspotTxLC, 9);// copy the current LC into the data (mainly for use with the embedded data);
-		wavbuffer_count++;
-		wavbuffer_write_idx = ((wavbuffer_write_idx + 1) % HOTSPOT_BUFFER_COUNT);
+		memcpy((uint8_t *)&audioAndHotspotDataBuffer.hotspotBuffer[bufIdx], txQueue->LC, 9);// copy the current LC into the data (mainly for use with the embedded data);
+		txQueue->count++;
+		txQueue->writeIdx = ((txQueue->writeIdx + 1) % txQueue->numBuffers);
 		taskEXIT_CRITICAL();
 	}
 
@@ -1162,6 +1208,7 @@ static void storeNetFrame(volatile const uint8_t *com_requestbuffer)
 
 static uint8_t hotspotModeReceiveNetFrame(volatile const uint8_t *com_requestbuffer, uint8_t timeSlot)
 {
+	int slot = (timeSlot - 1U);
 	DMRLC_T lc;
 
 	if (!mmdvmHostIsConnected)
@@ -1171,6 +1218,13 @@ static uint8_t hotspotModeReceiveNetFrame(volatile const uint8_t *com_requestbuf
 		updateScreen(HOTSPOT_RX_IDLE);
 	}
 
+	// In duplex MMDVMHost repeats the RF frames back on the slot they were received on, but the radio can't transmit while it receives.
+	// Nothing is queued either until MMDVMHost has switched the transmitter on.
+	if (duplexMode && ((duplexTxStarted == false) || rfIsReceivingOnSlot(slot)))
+	{
+		return 0U;
+	}
+
 	lc.srcId = 0;// zero these values as they are checked later in the function, but only updated if the data type is DT_VOICE_LC_HEADER
 	lc.dstId = 0;
 
@@ -1221,20 +1275,26 @@ static uint8_t hotspotModeReceiveNetFrame(volatile const uint8_t *com_requestbuf
 		trxTalkGroupOrPcId  = lc.dstId | (lc.FLCO << 24);
 		trxDMRID = lc.srcId;
 
-		if (hotspotState != HOTSPOT_STATE_TX_START_BUFFERING)
+		if ((hotspotState != HOTSPOT_STATE_TX_START_BUFFERING) || (slot != txSlot))
 		{
-			memcpy(hotspotTxLC, lc.rawData, 9);//Hotspot uses LC Data bytes rather than the src and dst ID's for the embed data
+			memcpy(txQueues[slot].LC, lc.rawData, 9);//Hotspot uses LC Data bytes rather than the src and dst ID's for the embed data
 
-			lastHeardListUpdate(hotspotTxLC, true);
+			lastHeardListUpdate(txQueues[slot].LC, true);
 
-			// the Src and Dst Id's have been sent, and we are in RX mode then an incoming Net normally arrives next
-			timeoutCounter = TX_BUFFERING_TIMEOUT;
-			hotspotState = HOTSPOT_STATE_TX_START_BUFFERING;
+			// The other timeslot is being transmitted, this call will be sent when it has finished
+			if ((slot == txSlot) ||
+					((hotspotState != HOTSPOT_STATE_TX_START_BUFFERING) && (hotspotState != HOTSPOT_STATE_TRANSMITTING) && (hotspotState != HOTSPOT_STATE_TX_SHUTDOWN)))
+			{
+				// the Src and Dst Id's have been sent, and we are in RX mode then an incoming Net normally arrives next
+				txSlot = slot;
+				timeoutCounter = TX_BUFFERING_TIMEOUT;
+				hotspotState = HOTSPOT_STATE_TX_START_BUFFERING;
+			}
 		}
 	}
 	else
 	{
-		storeNetFrame(com_requestbuffer);
+		storeNetFrame(com_requestbuffer, slot);
 	}
 
 	return 0U;
@@ -1357,13 +1417,13 @@ static void sendDebug5(const char *text, int16_t n1, int16_t n2, int16_t n3, int
 }
 #endif
 
-static void sendDMRLost(void)
+static void sendDMRLost(int slot)
 {
 	uint8_t buf[3U];
 
 	buf[0U] = MMDVM_FRAME_START;
 	buf[1U] = 3U;
-	buf[2U] = MMDVM_DMR_LOST2;
+	buf[2U] = ((duplexMode && (slot == 0)) ? MMDVM_DMR_LOST1 : MMDVM_DMR_LOST2);
 
 	enqueueUSBData(buf, buf[1U]);
 }
@@ -1375,7 +1435,7 @@ static void sendACK(void)
 	buf[0U] = MMDVM_FRAME_START;
 	buf[1U] = 4U;
 	buf[2U] = MMDVM_ACK;
-	buf[3U] = com_requestbuffer[2U];
+	buf[3U] = mmdvmRequestCommand;
 
 	enqueueUSBData(buf, buf[1U]);
 }
@@ -1387,12 +1447,67 @@ static void sendNAK(uint8_t err)
 	buf[0U] = MMDVM_FRAME_START;
 	buf[1U] = 5U;
 	buf[2U] = MMDVM_NAK;
-	buf[3U] = com_requestbuffer[2U];
+	buf[3U] = mmdvmRequestCommand;
 	buf[4U] = err;
 
 	enqueueUSBData(buf, buf[1U]);
 }
 
+static void txQueuesReset(void)
+{
+	taskENTER_CRITICAL();
+	for (int i = 0; i < 2; i++)
+	{
+		txQueues[i].readIdx = 0;
+		txQueues[i].writeIdx = 0;
+		txQueues[i].count = 0;
+	}
+
+	txQueues[0].firstBuffer = 0;
+	txQueues[0].numBuffers = (duplexMode ? (HOTSPOT_BUFFER_COUNT / 2) : 0);
+	txQueues[1].firstBuffer = txQueues[0].numBuffers;
+	txQueues[1].numBuffers = (HOTSPOT_BUFFER_COUNT - txQueues[0].numBuffers);
+	txSlot = 1;
+	taskEXIT_CRITICAL();
+}
+
+static void txQueueFlush(int slot)
+{
+	taskENTER_CRITICAL();
+	txQueues[slot].readIdx = 0;
+	txQueues[slot].writeIdx = 0;
+	txQueues[slot].count = 0;
+	taskEXIT_CRITICAL();
+}
+
+static bool rfIsReceivingOnSlot(int slot)
+{
+	return ((hotspotState == HOTSPOT_STATE_RX_PROCESS) && (rfRxSlot == slot) &&
+			((lastRxState == HOTSPOT_RX_START) || (lastRxState == HOTSPOT_RX_START_LATE) || (lastRxState == HOTSPOT_RX_AUDIO_FRAME)));
+}
+
+// Called by the HR-C6000 to get the next frame to transmit, from the queue of the timeslot on air.
+// If remove is false the frame stays in the queue
+bool hotspotTxFrameGet(uint8_t *frameBuf, bool remove)
+{
+	hotspotTxQueue_t *txQueue = &txQueues[txSlot];
+
+	if (txQueue->count == 0)
+	{
+		return false;
+	}
+
+	memcpy(frameBuf, (uint8_t *)&audioAndHotspotDataBuffer.hotspotBuffer[txQueue->firstBuffer + txQueue->readIdx], 27 + 0x0C);
+
+	if (remove)
+	{
+		txQueue->readIdx = ((txQueue->readIdx + 1) % txQueue->numBuffers);
+		txQueue->count--;
+	}
+
+	return true;
+}
+
 static void hotspotStateMachine(void)
 {
 	static uint32_t rxFrameTime = 0;
@@ -1420,7 +1535,7 @@ static void hotspotStateMachine(void)
 				if ((nonVolatileSettings.hotspotType == HOTSPOT_TYPE_MMDVM) &&
 						((fw_millis() - mmdvmHostLastActiveTime) > MMDVMHOST_TIMEOUT))
 				{
-					wavbuffer_count = 0;
+					txQueuesReset();
 
 					hotspotExit();
 					break;
@@ -1429,9 +1544,7 @@ static void hotspotStateMachine(void)
 			break;
 
 		case HOTSPOT_STATE_INITIALISE:
-			wavbuffer_read_idx = 0;
-			wavbuffer_write_idx = 0;
-			wavbuffer_count = 0;
+			txQueuesReset();
 			rfFrameBufCount = 0;
 
 			overriddenLCAvailable = false;
@@ -1447,9 +1560,7 @@ static void hotspotStateMachine(void)
 				disableTransmission();
 			}
 
-			wavbuffer_read_idx = 0;
-			wavbuffer_write_idx = 0;
-			wavbuffer_count = 0;
+			txQueuesReset();
 			rxFrameTime = fw_millis();
 
 			hotspotState = HOTSPOT_STATE_RX_PROCESS;
@@ -1465,7 +1576,7 @@ static void hotspotStateMachine(void)
 					mmdvmHostIsConnected = false;
 					hotspotState = HOTSPOT_STATE_NOT_CONNECTED;
 					rfFrameBufCount = 0;
-					wavbuffer_count = 0;
+					txQueuesReset();
 
 					hotspotExit();
 					break;
@@ -1475,7 +1586,7 @@ static void hotspotStateMachine(void)
 			{
 				hotspotState = HOTSPOT_STATE_NOT_CONNECTED;
 				rfFrameBufCount = 0;
-				wavbuffer_count = 0;
+				txQueuesReset();
 
 				if (trxIsTransmitting)
 				{
@@ -1500,6 +1611,8 @@ static void hotspotStateMachine(void)
 				{
 					uint8_t rx_command = audioAndHotspotDataBuffer.hotspotBuffer[rfFrameBufReadIdx][27 + 0x0c];
 
+					rfRxSlot = audioAndHotspotDataBuffer.hotspotBuffer[rfFrameBufReadIdx][27 + 0x0c + 2];
+
 					switch(rx_command)
 					{
 						case HOTSPOT_RX_IDLE:
@@ -1528,6 +1641,9 @@ static void hotspotStateMachine(void)
 						case HOTSPOT_RX_STOP:
 							updateScreen(rx_command);
 							sendTerminator_LC_Frame(audioAndHotspotDataBuffer.hotspotBuffer[rfFrameBufReadIdx]);
+#if defined(MMDVM_SEND_DEBUG)
+							sendDebug3("RF BER x0.1%, call / last second", codecGetBER(true), codecGetBER(false));
+#endif
 							lastRxState = HOTSPOT_RX_STOP;
 							hotspotState = HOTSPOT_STATE_RX_END;
 							break;
@@ -1575,7 +1691,7 @@ static void hotspotStateMachine(void)
 				if (((lastRxState == HOTSPOT_RX_AUDIO_FRAME) || (lastRxState == HOTSPOT_RX_START)) &&
 						((fw_millis() - rxFrameTime) > 300)) // 300ms
 				{
-					sendDMRLost();
+					sendDMRLost(rfRxSlot);
 					updateScreen(HOTSPOT_RX_IDLE);
 					lastRxState = HOTSPOT_RX_STOP;
 					hotspotState = HOTSPOT_STATE_RX_END;
@@ -1609,7 +1725,7 @@ static void hotspotStateMachine(void)
 			}
 			else
 			{
-				if (wavbuffer_count > TX_BUFFER_MIN_BEFORE_TRANSMISSION)
+				if (txQueues[txSlot].count > TX_BUFFER_MIN_BEFORE_TRANSMISSION)
 				{
 					if (cwKeying == false)
 					{
@@ -1622,7 +1738,7 @@ static void hotspotStateMachine(void)
 				{
 					if (--timeoutCounter == 0)
 					{
-						sendDMRLost();
+						sendDMRLost(txSlot);
 						hotspotState = HOTSPOT_STATE_INITIALISE;
 					}
 				}
@@ -1631,7 +1747,7 @@ static void hotspotStateMachine(void)
 
 		case HOTSPOT_STATE_TRANSMITTING:
 			// Stop transmitting when there is no data in the buffer or if MMDVMHost sends the idle command
-			if (wavbuffer_count == 0 || modemState == STATE_IDLE)
+			if (txQueues[txSlot].count == 0 || modemState == STATE_IDLE)
 			{
 				hotspotState = HOTSPOT_STATE_TX_SHUTDOWN;
 				trxIsTransmitting = false;
@@ -1643,7 +1759,14 @@ static void hotspotStateMachine(void)
 			if (txstopdelay > 0)
 			{
 				txstopdelay--;
-				if (wavbuffer_count > 0)
+
+				// Alternate between the timeslots, so that a call waiting on the other slot goes next
+				if (txQueues[(txSlot == 0) ? 1 : 0].count > 0)
+				{
+					txSlot = ((txSlot == 0) ? 1 : 0);
+				}
+
+				if (txQueues[txSlot].count > 0)
 				{
 					// restart
 					enableTransmission();
@@ -1751,7 +1874,8 @@ static bool hasRXOverflow(void)
 
 static bool hasTXOverflow(void)
 {
-	return ((HOTSPOT_BUFFER_COUNT - wavbuffer_count) <= 0);
+	return (((txQueues[0].numBuffers > 0) && ((txQueues[0].numBuffers - txQueues[0].count) <= 0)) ||
+			((txQueues[1].numBuffers - txQueues[1].count) <= 0));
 }
 
 static void getStatus(void)
@@ -1781,8 +1905,16 @@ static void getStatus(void)
 
 	buf[6U]  = 0U; // No DSTAR space
 
-	buf[7U]  = 10U; // DMR Simplex
-	buf[8U]  = (HOTSPOT_BUFFER_COUNT - wavbuffer_count); // DMR space
+	if (duplexMode)
+	{
+		buf[7U]  = (txQueues[0].numBuffers - txQueues[0].count); // DMR TS1 space
+		buf[8U]  = (txQueues[1].numBuffers - txQueues[1].count); // DMR TS2 space
+	}
+	else
+	{
+		buf[7U]  = 10U; // DMR Simplex
+		buf[8U]  = (txQueues[1].numBuffers - txQueues[1].count); // DMR space
+	}
 
 	buf[9U]  = 0U; // No YSF space
 	buf[10U] = 0U; // No P25 space
@@ -1815,6 +1947,16 @@ static uint8_t setConfig(volatile const uint8_t *data, uint8_t length)
 
 	tx_delay = tempTXDelay;
 
+	// MMDVMHost sets the simplex flag unless Duplex=1. BlueDV is always simplex
+	bool duplex = ((nonVolatileSettings.hotspotType == HOTSPOT_TYPE_MMDVM) && ((data[0U] & 0x80U) == 0U));
+
+	if (duplex != duplexMode)
+	{
+		duplexMode = duplex;
+		duplexTxStarted = false;
+		txQueuesReset();// The buffers are shared differently between the timeslots
+	}
+
 	// Only supported mode are DMR, CWID, POCSAG and IDLE
 	switch (data[3U])
 	{
@@ -2199,13 +2341,57 @@ static uint8_t handlePOCSAG(volatile const uint8_t *data, uint8_t length)
 }
 #endif
 
-static void handleHotspotRequest(void)
+// MMDVMHost can send several frames in one USB transfer, or split a frame over several transfers.
+// Each complete frame is handled in place in the USB stream buffer, bytes which are not part of a frame are skipped
+static void processUSBRxStream(void)
+{
+	int available;
+
+	while ((available = (com_streambuffer_write_idx - com_streambuffer_read_idx)) > 0)
+	{
+		volatile const uint8_t *frame = &com_streambuffer[com_streambuffer_read_idx];
+
+		if (frame[0U] != MMDVM_FRAME_START)
+		{
+			consume_from_streambuffer(1);// resync
+			continue;
+		}
+
+		if (available < 2)
+		{
+			break;
+		}
+
+		if (frame[1U] < MMDVM_FRAME_MIN_LENGTH)
+		{
+			consume_from_streambuffer(1);// not a valid length, resync
+			continue;
+		}
+
+		if (available < frame[1U])
+		{
+			break;// wait for the rest of the frame
+		}
+
+		handleHotspotRequest(frame);
+		consume_from_streambuffer(frame[1U]);
+	}
+
+	// The USB receive is held until there is room, make some by moving the partial frame to the start of the buffer
+	if (com_streambuffer_stalled)
+	{
+		consume_from_streambuffer(0);
+	}
+}
+
+static void handleHotspotRequest(volatile const uint8_t *com_requestbuffer)
 {
 	if (com_requestbuffer[0] == MMDVM_FRAME_START)
 	{
 		uint8_t err = 2U;
 
 		mmdvmHostLastActiveTime = fw_millis();
+		mmdvmRequestCommand = com_requestbuffer[2U];
 
 		switch(com_requestbuffer[2U])
 		{
@@ -2295,9 +2481,24 @@ static void handleHotspotRequest(void)
 				sendNAK(err);
 				break;
 
-			case MMDVM_DMR_DATA1: // We are a simplex hotspot, no TS1 support
-				//hotspotModeReceiveNetFrame((uint8_t *)com_requestbuffer, 1U);
-				sendNAK(err);
+			case MMDVM_DMR_DATA1: // TS1 is only used in duplex
+				if (com_requestbuffer[1U] < (MMDVM_HEADER_LENGTH + DMR_FRAME_LENGTH_BYTES))
+				{
+					err = 4U;
+				}
+				else if (duplexMode)
+				{
+					err = hotspotModeReceiveNetFrame(com_requestbuffer, 1U);
+				}
+
+				if (err == 0U)
+				{
+					sendACK();
+				}
+				else
+				{
+					sendNAK(err);
+				}
 				break;
 
 			case MMDVM_DMR_DATA2:
@@ -2309,7 +2510,15 @@ static void handleHotspotRequest(void)
 					modemState = STATE_DMR;
 				}
 
-				err = hotspotModeReceiveNetFrame(com_requestbuffer, 2U);
+				if (com_requestbuffer[1U] < (MMDVM_HEADER_LENGTH + DMR_FRAME_LENGTH_BYTES))
+				{
+					err = 4U;
+				}
+				else
+				{
+					err = hotspotModeReceiveNetFrame(com_requestbuffer, 2U);
+				}
+
 				if (err == 0U)
 				{
 					sendACK();
@@ -2320,8 +2529,16 @@ static void handleHotspotRequest(void)
 				}
 				break;
 
-			case MMDVM_DMR_START: // Only for duplex
-				sendACK();
+			case MMDVM_DMR_START: // Only for duplex, transmitter on (1) or off (0)
+				if (com_requestbuffer[1U] < 4U)
+				{
+					sendNAK(4U);
+				}
+				else
+				{
+					duplexTxStarted = (com_requestbuffer[3U] != 0U);
+					sendACK();
+				}
 				break;
 
 			case MMDVM_DMR_SHORTLC:
@@ -2336,8 +2553,16 @@ static void handleHotspotRequest(void)
 				}
 				break;
 
-			case MMDVM_DMR_ABORT: // Only for duplex
-				sendACK();
+			case MMDVM_DMR_ABORT: // Only for duplex, drop what is queued for the slot (1 or 2)
+				if ((com_requestbuffer[1U] < 4U) || (com_requestbuffer[3U] < 1U) || (com_requestbuffer[3U] > 2U))
+				{
+					sendNAK(4U);
+				}
+				else
+				{
+					txQueueFlush(com_requestbuffer[3U] - 1U);
+					sendACK();
+				}
 				break;
 
 #if 0  // Serial passthrough (a.k.a Nextion serial port), unhandled
@@ -2396,8 +2621,6 @@ static void handleHotspotRequest(void)
 				sendNAK(1U);
 				break;
 		}
-
-		com_requestbuffer[0U] = 0xFFU; // Invalidate this one
 	}
 	else
 	{
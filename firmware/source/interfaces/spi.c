@@ -23,6 +23,8 @@ __attribute__((section(".data.$RAM2"))) uint8_t SPI_masterSendBuffer_SPI0[SPI_DA
 __attribute__((section(".data.$RAM2"))) uint8_t spi_masterReceiveBuffer_SPI1[SPI_DATA_LENGTH] = {0};
 __attribute__((section(".data.$RAM2"))) uint8_t SPI_masterSendBuffer_SPI1[SPI_DATA_LENGTH] = {0};
 
+static SemaphoreHandle_t spiBusMutex = NULL;
+
 void init_SPI(void)
 {
     /* PORTD0 is configured as SPI0_CS0 */
@@ -51,6 +53,22 @@ void init_SPI(void)
 
     NVIC_SetPriority(SPI0_IRQn, 3);
     NVIC_SetPriority(SPI1_IRQn, 3);
+
+	spiBusMutex = xSemaphoreCreateRecursiveMutex();
+	if (spiBusMutex == NULL)
+	{
+		while(true); // Something better maybe ?
+	}
+}
+
+void lock_SPI_bus(void)
+{
+	xSemaphoreTakeRecursive(spiBusMutex, portMAX_DELAY);
+}
+
+void unlock_SPI_bus(void)
+{
+	xSemaphoreGiveRecursive(spiBusMutex);
 }
 
 void setup_SPI0(void)
@@ -70,7 +70,7 @@ void init_watchdog(batteryHistoryCallback_t cb)
 				"fw watchdog task",                      /* task name for kernel awareness debugging */
 				1000L / sizeof(portSTACK_TYPE),      /* task stack size */
 				NULL,                      			 /* optional task startup argument */
-				5U,                                  /* initial priority */
+				4U,                                  /* initial priority */
 				fwwatchdogTaskHandle					 /* optional task handle to create */
 				);
 }
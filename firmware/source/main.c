@@ -17,6 +17,10 @@
  */
 
 #include <codeplug.h>
+#include <ambeRecorder.h>
+#include <bootProfiler.h>
+#include <trace.h>
+#include <dmrData.h>
 #include <main.h>
 #include <settings.h>
 #include <ticks.h>
@@ -52,7 +56,7 @@ void fw_init(void)
 				"fw main task",                      /* task name for kernel awareness debugging */
 				5000L / sizeof(portSTACK_TYPE),      /* task stack size */
 				NULL,                      			 /* optional task startup argument */
-				6U,                                  /* initial priority */
+				4U,                                  /* initial priority */
 				fwMainTaskHandle					 /* optional task handle to create */
 				);
 
@@ -72,6 +76,10 @@ void fw_powerOffFinalStage(void)
 
 	menuHotspotRestoreSettings();
 
+	lastheardLogFlush();
+	dmrDataFlush();
+	ambeRecorderFlush();
+
 	m = fw_millis();
 	settingsSaveSettings(true);
 
@@ -121,7 +129,9 @@ void fw_main_task(void *data)
 	int function_event;
 	uiEvent_t ev = { .buttons = 0, .keys = NO_KEYCODE, .rotary = 0, .function = 0, .events = NO_EVENT, .hasEvent = false, .time = 0 };
 	bool keyOrButtonChanged = false;
+	bool contactsCacheReady = false;
 
+	traceInit();
     USB_DeviceApplicationInit();
 
     // Init I2C
@@ -132,6 +142,7 @@ void fw_main_task(void *data)
 	fw_init_LEDs();
 	fw_init_keyboard();
 	init_rotary_switch();
+	bootProfilerMark("IO");
 
 	fw_check_button_event(&buttons, &button_event);// Read button state and event
 	if (buttons & BUTTON_SK2)
@@ -140,8 +151,10 @@ void fw_main_task(void *data)
 	}
 
     settingsLoadSettings();
+    bootProfilerMark("Settings");
 
 	fw_init_display(nonVolatileSettings.displayInverseVideo);
+	bootProfilerMark("Display");
 
     // Init SPI
     init_SPI();
@@ -159,8 +172,9 @@ void fw_main_task(void *data)
     dac_init();
 
     SPI_Flash_init();
+    bootProfilerMark("SPI/I2S");
 
-    if (!checkAndCopyCalibrationToCommonLocation())
+    if (!checkAndCopyCalibrationToCommonLocation() || !calibrationInit())
 	{
 		showErrorMessage("CAL DATA ERROR");
 		while(1U)
@@ -168,9 +182,11 @@ void fw_main_task(void *data)
 			tick_com_request();
 		};
 	}
+    bootProfilerMark("Calibration");
 
     // Init AT1846S
     I2C_AT1846S_init();
+    bootProfilerMark("AT1846S");
 
     // Init HR-C6000
     SPI_HR_C6000_init();
@@ -181,9 +197,11 @@ void fw_main_task(void *data)
 
     // Init HR-C6000 interrupts
     init_HR_C6000_interrupts();
+    bootProfilerMark("HR-C6000");
 
     // Speech Synthesis (GD77S Only)
     speechSynthesisInit();
+    bootProfilerMark("Speech");
 
 
     // Small startup delay after initialization to stabilize system
@@ -208,6 +226,7 @@ void fw_main_task(void *data)
 	init_watchdog(menuBatteryPushBackVoltage);
 
     fw_init_beep_task();
+    bootProfilerMark("Tasks");
 
 #if defined(USE_SEGGER_RTT)
     SEGGER_RTT_ConfigUpBuffer(0, NULL, NULL, 0, SEGGER_RTT_MODE_NO_BLOCK_TRIM);
@@ -215,9 +234,16 @@ void fw_main_task(void *data)
 #endif
 
     lastheardInitList();
-    codeplugInitContactsCache();
+    bootProfilerMark("Last heard");
+    dmrDataInit();
+    bootProfilerMark("Data inbox");
+    ambeRecorderInit();
+    bootProfilerMark("Recorder");
+    codeplugInitContactsCache();// Only starts the cache, which is built in the background once the first screen is shown
     dmrIDCacheInit();
+    bootProfilerMark("DMR IDs");
     menuInitMenuSystem();
+    bootProfilerMark("Menus");
 
 #if defined(PLATFORM_GD77S)
     // Change hotspot modem type setting
@@ -500,6 +526,24 @@ void fw_main_task(void *data)
     			updateLastHeard=false;
     		}
 
+    		if (!trxIsTransmitting && (slot_state != DMR_STATE_IDLE))
+    		{
+    			lastheardUpdateBER();
+    		}
+
+    		lastheardLogTick();
+    		dmrDataTick();
+    		ambeRecorderTick();
+    		traceTick();
+
+    		// The names of the restored last heard items are looked up once the contacts cache has been built
+    		if (!contactsCacheReady && codeplugContactsCacheTick())
+    		{
+    			contactsCacheReady = true;
+    			lastheardUpdateRestoredNames();
+    			bootProfilerMark("Contacts");
+    		}
+
     		if ((nonVolatileSettings.hotspotType == HOTSPOT_TYPE_OFF) ||
     				((nonVolatileSettings.hotspotType != HOTSPOT_TYPE_OFF) && (settingsUsbMode != USB_MODE_HOTSPOT))) // Do not filter anything in HS mode.
     		{
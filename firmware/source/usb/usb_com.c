@@ -15,8 +15,11 @@
  * along with this program; if not, write to the Free Software
  * Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
  */
+#include <bootProfiler.h>
+#include <calibration.h>
 #include <hotspot/uiHotspot.h>
 #include <settings.h>
+#include <trace.h>
 #include <user_interface/uiUtilities.h>
 #include <user_interface/menuSystem.h>
 #include <stdarg.h>
@@ -24,6 +27,7 @@
 #include <wdog.h>
 
 static void handleCPSRequest(void);
+static void cpsSendReply(int length);
 
 __attribute__((section(".data.$RAM2"))) volatile uint8_t com_buffer[COM_BUFFER_SIZE];
 int com_buffer_write_idx = 0;
@@ -32,36 +36,269 @@ volatile int com_buffer_cnt = 0;
 volatile int com_request = 0;
 __attribute__((section(".data.$RAM2"))) volatile uint8_t com_requestbuffer[COM_REQUESTBUFFER_SIZE];
 __attribute__((section(".data.$RAM2"))) USB_DMA_NONINIT_DATA_ALIGN(USB_DATA_ALIGN_SIZE) uint8_t usbComSendBuf[COM_BUFFER_SIZE];//DATA_BUFF_SIZE
+
+// Hotspot (MMDVM) receive stream. Each USB transfer is appended by the receive callback, and the frames are parsed in place by the hotspot.
+// The next USB receive is only scheduled when there is room for a full packet, otherwise it is stalled until the hotspot has consumed some data
+__attribute__((section(".data.$RAM2"))) volatile uint8_t com_streambuffer[COM_STREAMBUFFER_SIZE];
+volatile int com_streambuffer_write_idx = 0;
+volatile int com_streambuffer_read_idx = 0;
+volatile bool com_streambuffer_stalled = false;
 int sector = -1;
 static bool flashingDMRIDs = false;
 
+// The CPS replies share the bulk IN endpoint with the screen and trace streams. A reply which can't be sent because a stream packet
+// is still being transferred is kept here, and sent before any other stream packet. No other request is handled until it has been sent.
+static int cpsReplyLength = 0;
+
+// Screen streaming. Once enabled by the host (command 'C' 7), each frame sent to the display is pushed to the host,
+// as a delta against the previous frame: only the rows which changed are sent, as a run length encoding of the
+// XOR between the new and the previous row.
+//
+// Frame: 'S', frame number, mask of the rows which follow, then for each row: encoded length, encoded data.
+// Encoded data: 0x00-0x7F: (n + 1) XOR bytes follow, 0x80-0xFF: ((n & 0x7F) + 1) unchanged bytes.
+#define SCREEN_STREAM_NUM_ROWS 8
+#define SCREEN_STREAM_ROW_SIZE 128
+#define SCREEN_STREAM_BUFFER_SIZE (3 + (SCREEN_STREAM_NUM_ROWS * (1 + SCREEN_STREAM_ROW_SIZE + 2)))
+
+static bool screenStreamEnabled = false;
+static bool screenStreamPending = false;
+static uint8_t screenStreamFrameNumber = 0;
+static int screenStreamLength = 0;
+__attribute__((section(".data.$RAM2"))) static uint8_t screenStreamPreviousFrame[SCREEN_STREAM_NUM_ROWS * SCREEN_STREAM_ROW_SIZE];
+__attribute__((section(".data.$RAM2"))) USB_DMA_NONINIT_DATA_ALIGN(USB_DATA_ALIGN_SIZE) static uint8_t screenStreamSendBuf[SCREEN_STREAM_BUFFER_SIZE];
+
+static void screenStreamTick(void);
+
+// Trace streaming. Once enabled by the host (command 'C' 8), the trace records are sent as they are read from the ring,
+// instead of over RTT. Packet: 'T', number of records, then the 16 byte records (see traceRecord_t).
+// It can't be enabled while the screen is streamed ('!' reply), as the host couldn't tell the trace packets from the screen data.
+#define TRACE_STREAM_MAX_RECORDS 8
+#define TRACE_STREAM_BUFFER_SIZE (2 + (TRACE_STREAM_MAX_RECORDS * sizeof(traceRecord_t)))
+
+static int traceStreamLength = 0;
+__attribute__((section(".data.$RAM2"))) USB_DMA_NONINIT_DATA_ALIGN(USB_DATA_ALIGN_SIZE) static uint8_t traceStreamSendBuf[TRACE_STREAM_BUFFER_SIZE];
+
+static bool traceStreamEnable(bool enable);
+static void traceStreamTick(void);
+
 
 void tick_com_request(void)
 {
 		switch (settingsUsbMode)
 		{
 			case USB_MODE_CPS:
-				if (com_request==1)
+				// MMDVM data has been received, it will be handled by the hotspot
+				if (com_streambuffer_write_idx > 0)
+				{
+					cpsReplyLength = 0;
+					screenStreamEnabled = false;
+					traceSetSink(TRACE_SINK_DEFAULT);
+					settingsUsbMode = USB_MODE_HOTSPOT;
+					menuSystemPushNewMenu(UI_HOTSPOT_MODE);
+					return;
+				}
+
+				if (cpsReplyLength > 0)
 				{
-					if ((nonVolatileSettings.hotspotType != HOTSPOT_TYPE_OFF) && (com_requestbuffer[0] == 0xE0U /* MMDVM_FRAME_START */))
+					if ((s_cdcVcom.attach == 0) ||
+							(USB_DeviceCdcAcmSend(s_cdcVcom.cdcAcmHandle, USB_CDC_VCOM_BULK_IN_ENDPOINT, usbComSendBuf, cpsReplyLength) == kStatus_USB_Success))
 					{
-						settingsUsbMode = USB_MODE_HOTSPOT;
-						menuSystemPushNewMenu(UI_HOTSPOT_MODE);
-						return;
+						cpsReplyLength = 0;
 					}
+					break;
+				}
+
+				if (com_request==1)
+				{
 					taskENTER_CRITICAL();
 					handleCPSRequest();
 					taskEXIT_CRITICAL();
 					com_request=0;
+
+					if (cpsReplyLength > 0)
+					{
+						break;
+					}
 				}
 
+				screenStreamTick();
+				traceStreamTick();
 				break;
 			case USB_MODE_HOTSPOT:
 				break;
 	}
 }
 
-enum CPS_ACCESS_AREA { CPS_ACCESS_FLASH = 1,CPS_ACCESS_EEPROM = 2, CPS_ACCESS_MCU_ROM=5,CPS_ACCESS_DISPLAY_BUFFER=6};
+static void screenStreamEnable(bool enable)
+{
+	if (enable && (traceGetSink() == TRACE_SINK_USB))
+	{
+		traceStreamEnable(false);
+	}
+
+	screenStreamEnabled = enable;
+	screenStreamPending = false;
+	screenStreamFrameNumber = 0;
+
+	// The host starts from a blank screen too, so the first frame will contain the whole screen
+	memset(screenStreamPreviousFrame, 0, sizeof(screenStreamPreviousFrame));
+	ucRenderedRowsMask = (1 << SCREEN_STREAM_NUM_ROWS) - 1;
+}
+
+// Single unchanged bytes are included in the literal runs, so that the encoded row is never more than 2 bytes larger than the raw row
+static int screenStreamEncodeRow(const uint8_t *newRow, uint8_t *previousRow, uint8_t *out)
+{
+	int pos = 0;
+	int i = 0;
+
+	while (i < SCREEN_STREAM_ROW_SIZE)
+	{
+		int start = i;
+
+		if (newRow[i] == previousRow[i])
+		{
+			while ((i < SCREEN_STREAM_ROW_SIZE) && (newRow[i] == previousRow[i]))
+			{
+				i++;
+			}
+			out[pos++] = 0x80 | ((i - start) - 1);
+		}
+		else
+		{
+			while ((i < SCREEN_STREAM_ROW_SIZE) &&
+					((newRow[i] != previousRow[i]) || (((i + 1) < SCREEN_STREAM_ROW_SIZE) && (newRow[i + 1] != previousRow[i + 1]))))
+			{
+				i++;
+			}
+			out[pos++] = (i - start) - 1;
+
+			for (int j = start; j < i; j++)
+			{
+				out[pos++] = newRow[j] ^ previousRow[j];
+			}
+		}
+	}
+
+	memcpy(previousRow, newRow, SCREEN_STREAM_ROW_SIZE);
+
+	return pos;
+}
+
+static void screenStreamTick(void)
+{
+	uint8_t renderedRows;
+	uint8_t rowsMask = 0;
+	int pos = 3;
+
+	if (!screenStreamEnabled)
+	{
+		return;
+	}
+
+	if (s_cdcVcom.attach == 0)
+	{
+		screenStreamEnabled = false;
+		return;
+	}
+
+	// Nothing new is encoded until the previous frame has been accepted by the USB stack
+	if (!screenStreamPending)
+	{
+		if (ucRenderedRowsMask == 0)
+		{
+			return;
+		}
+
+		renderedRows = ucRenderedRowsMask;
+		ucRenderedRowsMask = 0;
+
+		for (int row = 0; row < SCREEN_STREAM_NUM_ROWS; row++)
+		{
+			uint8_t *newRow = &screenBuf[row * SCREEN_STREAM_ROW_SIZE];
+			uint8_t *previousRow = &screenStreamPreviousFrame[row * SCREEN_STREAM_ROW_SIZE];
+
+			if ((renderedRows & (1 << row)) && (memcmp(newRow, previousRow, SCREEN_STREAM_ROW_SIZE) != 0))
+			{
+				int length = screenStreamEncodeRow(newRow, previousRow, &screenStreamSendBuf[pos + 1]);
+
+				screenStreamSendBuf[pos] = length;
+				pos += (length + 1);
+				rowsMask |= (1 << row);
+			}
+		}
+
+		if (rowsMask == 0)
+		{
+			return;
+		}
+
+		screenStreamSendBuf[0] = 'S';
+		screenStreamSendBuf[1] = screenStreamFrameNumber++;
+		screenStreamSendBuf[2] = rowsMask;
+		screenStreamLength = pos;
+		screenStreamPending = true;
+	}
+
+	if (USB_DeviceCdcAcmSend(s_cdcVcom.cdcAcmHandle, USB_CDC_VCOM_BULK_IN_ENDPOINT, screenStreamSendBuf, screenStreamLength) == kStatus_USB_Success)
+	{
+		screenStreamPending = false;
+	}
+}
+
+static bool traceStreamEnable(bool enable)
+{
+	if (enable && screenStreamEnabled)
+	{
+		return false;
+	}
+
+	traceStreamLength = 0;
+	traceSetSink(enable ? TRACE_SINK_USB : TRACE_SINK_DEFAULT);
+	return true;
+}
+
+static void traceStreamTick(void)
+{
+	traceRecord_t record;
+	int numRecords = 0;
+
+	if (traceGetSink() != TRACE_SINK_USB)
+	{
+		return;
+	}
+
+	if (s_cdcVcom.attach == 0)
+	{
+		traceStreamEnable(false);
+		return;
+	}
+
+	// As for the screen streaming, the packet is kept until the USB stack accepts it
+	if (traceStreamLength == 0)
+	{
+		while ((numRecords < TRACE_STREAM_MAX_RECORDS) && traceRead(&record))
+		{
+			memcpy(&traceStreamSendBuf[2 + (numRecords * sizeof(traceRecord_t))], &record, sizeof(traceRecord_t));
+			numRecords++;
+		}
+
+		if (numRecords == 0)
+		{
+			return;
+		}
+
+		traceStreamSendBuf[0] = 'T';
+		traceStreamSendBuf[1] = numRecords;
+		traceStreamLength = 2 + (numRecords * sizeof(traceRecord_t));
+	}
+
+	if (USB_DeviceCdcAcmSend(s_cdcVcom.cdcAcmHandle, USB_CDC_VCOM_BULK_IN_ENDPOINT, traceStreamSendBuf, traceStreamLength) == kStatus_USB_Success)
+	{
+		traceStreamLength = 0;
+	}
+}
+
+enum CPS_ACCESS_AREA { CPS_ACCESS_FLASH = 1,CPS_ACCESS_EEPROM = 2, CPS_ACCESS_MCU_ROM=5,CPS_ACCESS_DISPLAY_BUFFER=6,CPS_ACCESS_BOOT_PROFILER=7,CPS_ACCESS_LAST_HEARD_LOG=8};
 
 static void handleCPSRequest(void)
 {
@@ -96,6 +333,18 @@ static void handleCPSRequest(void)
 				memcpy(&usbComSendBuf[3],&screenBuf[address],length);
 				result = true;
 				break;
+			case CPS_ACCESS_BOOT_PROFILER:// The bootProfiler_t, i.e. the number of stages then the time in uS and name of each
+				if ((address + length) <= sizeof(bootProfiler_t))
+				{
+					memcpy(&usbComSendBuf[3],((uint8_t *)&bootProfiler) + address,length);
+					result = true;
+				}
+				break;
+			case CPS_ACCESS_LAST_HEARD_LOG:// The whole last heard log, newest record first (see lastheardLogRead())
+				taskEXIT_CRITICAL();
+				result = lastheardLogRead(address, &usbComSendBuf[3], length);
+				taskENTER_CRITICAL();
+				break;
 		}
 
 		if (result)
@@ -103,12 +352,12 @@ static void handleCPSRequest(void)
 			usbComSendBuf[0] = com_requestbuffer[0];
 			usbComSendBuf[1]=(length>>8)&0xFF;
 			usbComSendBuf[2]=(length>>0)&0xFF;
-			USB_DeviceCdcAcmSend(s_cdcVcom.cdcAcmHandle, USB_CDC_VCOM_BULK_IN_ENDPOINT, usbComSendBuf, length+3);
+			cpsSendReply(length+3);
 		}
 		else
 		{
 			usbComSendBuf[0] = '-';
-			USB_DeviceCdcAcmSend(s_cdcVcom.cdcAcmHandle, USB_CDC_VCOM_BULK_IN_ENDPOINT, usbComSendBuf, 1);
+			cpsSendReply(1);
 		}
 	}
 	// Handle Write
@@ -172,6 +421,20 @@ static void handleCPSRequest(void)
 							break;
 						}
 					}
+
+					// Keep the RAM copy of the calibration in sync
+					if (ok && calibrationIsInCalibrationSector(sector*4096))
+					{
+						taskEXIT_CRITICAL();
+						calibrationInit();
+						taskENTER_CRITICAL();
+					}
+
+					// The channel and zone data may have changed, so the RAM copy is reloaded when its next needed
+					if (ok)
+					{
+						codeplugChannelsCacheInvalidate();
+					}
 				}
 				sector=-1;
 			}
@@ -186,25 +449,34 @@ static void handleCPSRequest(void)
 			}
 
 			ok = EEPROM_Write(address, (uint8_t*)com_requestbuffer+8, length);
+			if (ok)
+			{
+				codeplugChannelsCacheInvalidate();
+			}
 		}
 
 		if (ok)
 		{
 			usbComSendBuf[0] = com_requestbuffer[0];
 			usbComSendBuf[1] = com_requestbuffer[1];
-			USB_DeviceCdcAcmSend(s_cdcVcom.cdcAcmHandle, USB_CDC_VCOM_BULK_IN_ENDPOINT, usbComSendBuf, 2);
+			cpsSendReply(2);
 		}
 		else
 		{
 			sector=-1;
 			usbComSendBuf[0] = '-';
-			USB_DeviceCdcAcmSend(s_cdcVcom.cdcAcmHandle, USB_CDC_VCOM_BULK_IN_ENDPOINT, usbComSendBuf, 1);
+			cpsSendReply(1);
 		}
 	}
 	// Handle a "Command"
 	else if (com_requestbuffer[0]=='C')
 	{
 		int command = com_requestbuffer[1];
+
+		// Send something generic back.
+		// Probably need to send a response code in the future
+		usbComSendBuf[0] = '-';
+
 		switch(command)
 		{
 			case 0:
@@ -267,20 +539,37 @@ static void handleCPSRequest(void)
 					}
 				}
 				break;
+			case 7:
+				// Start (1) or stop (0) the screen streaming
+				screenStreamEnable(com_requestbuffer[2] != 0);
+				break;
+			case 8:
+				// Start (1) or stop (0) the trace streaming
+				if (traceStreamEnable(com_requestbuffer[2] != 0) == false)
+				{
+					usbComSendBuf[0] = '!';
+				}
+				break;
 			default:
 				break;
 		}
-		// Send something generic back.
-		// Probably need to send a response code in the future
-		usbComSendBuf[0] = '-';
-		USB_DeviceCdcAcmSend(s_cdcVcom.cdcAcmHandle, USB_CDC_VCOM_BULK_IN_ENDPOINT, usbComSendBuf, 1);
+		cpsSendReply(1);
 	}
 	else
 	{
 		usbComSendBuf[0] = '-';
-		USB_DeviceCdcAcmSend(s_cdcVcom.cdcAcmHandle, USB_CDC_VCOM_BULK_IN_ENDPOINT, usbComSendBuf, 1);
+		cpsSendReply(1);
+	}
+}
+
+static void cpsSendReply(int length)
+{
+	if (USB_DeviceCdcAcmSend(s_cdcVcom.cdcAcmHandle, USB_CDC_VCOM_BULK_IN_ENDPOINT, usbComSendBuf, length) != kStatus_USB_Success)
+	{
+		cpsReplyLength = length;// Sent by tick_com_request() once the endpoint is free
 	}
 }
+
 #if false
 void send_packet(uint8_t val_0x82, uint8_t val_0x86, int ram)
 {
@@ -342,6 +631,78 @@ void add_to_commbuffer(uint8_t value)
 	}
 }
 #endif
+
+// Called from the USB receive callback. Returns false if the data is not for the hotspot.
+// In CPS mode, a transfer starting with an MMDVM frame start begins the stream, and switches the USB mode to hotspot
+bool add_to_streambuffer(const uint8_t *data, int length)
+{
+	if ((settingsUsbMode != USB_MODE_HOTSPOT) &&
+			((nonVolatileSettings.hotspotType == HOTSPOT_TYPE_OFF) || ((data[0] != 0xE0U /* MMDVM_FRAME_START */) && (com_streambuffer_write_idx == 0))))
+	{
+		return false;
+	}
+
+	if (length > (COM_STREAMBUFFER_SIZE - com_streambuffer_write_idx))
+	{
+		// Should not happen, as the receive is not scheduled unless there is room for a full packet
+		return true;
+	}
+
+	memcpy((uint8_t *)&com_streambuffer[com_streambuffer_write_idx], data, length);
+	com_streambuffer_write_idx += length;
+	com_streambuffer_stalled = ((COM_STREAMBUFFER_SIZE - com_streambuffer_write_idx) < DATA_BUFF_SIZE);
+
+	return true;
+}
+
+// Called by the hotspot once it has handled length bytes, from com_streambuffer_read_idx.
+// Any partial frame is only moved back to the start of the buffer when there is no room left for another USB packet
+void consume_from_streambuffer(int length)
+{
+	bool restartReceive = false;
+
+	taskENTER_CRITICAL();
+	com_streambuffer_read_idx += length;
+
+	if (com_streambuffer_read_idx >= com_streambuffer_write_idx)
+	{
+		com_streambuffer_read_idx = 0;
+		com_streambuffer_write_idx = 0;
+	}
+	else if ((COM_STREAMBUFFER_SIZE - com_streambuffer_write_idx) < DATA_BUFF_SIZE)
+	{
+		memmove((uint8_t *)com_streambuffer, (uint8_t *)&com_streambuffer[com_streambuffer_read_idx], (com_streambuffer_write_idx - com_streambuffer_read_idx));
+		com_streambuffer_write_idx -= com_streambuffer_read_idx;
+		com_streambuffer_read_idx = 0;
+	}
+
+	if (com_streambuffer_stalled && ((COM_STREAMBUFFER_SIZE - com_streambuffer_write_idx) >= DATA_BUFF_SIZE))
+	{
+		com_streambuffer_stalled = false;
+		restartReceive = true;
+	}
+	taskEXIT_CRITICAL();
+
+	if (restartReceive)
+	{
+		USB_DeviceCdcVcomScheduleRecv();
+	}
+}
+
+void reset_streambuffer(void)
+{
+	taskENTER_CRITICAL();
+	com_streambuffer_read_idx = 0;
+	com_streambuffer_write_idx = 0;
+	taskEXIT_CRITICAL();
+
+	if (com_streambuffer_stalled)
+	{
+		com_streambuffer_stalled = false;
+		USB_DeviceCdcVcomScheduleRecv();
+	}
+}
+
 void USB_DEBUG_PRINT(char *str)
 {
 	strcpy((char*)usbComSendBuf,str);
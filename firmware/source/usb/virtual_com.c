@@ -142,7 +142,7 @@ usb_status_t USB_DeviceCdcVcomCallback(class_handle_t handle, uint32_t event, vo
                  */
                 error = USB_DeviceCdcAcmSend(handle, USB_CDC_VCOM_BULK_IN_ENDPOINT, NULL, 0);
             }
-            else if (1 == s_cdcVcom.attach)
+            else if ((1 == s_cdcVcom.attach) && (com_streambuffer_stalled == false))
             {
                 if ((epCbParam->buffer != NULL) || ((epCbParam->buffer == NULL) && (epCbParam->length == 0)))
                 {
@@ -158,7 +158,16 @@ usb_status_t USB_DeviceCdcVcomCallback(class_handle_t handle, uint32_t event, vo
             {
                 if ((0 != epCbParam->length) && (0xFFFFFFFF != epCbParam->length))
                 {
-					if (s_currRecvBuf[0]=='B')
+					if (add_to_streambuffer(s_currRecvBuf, epCbParam->length))
+					{
+						// Hotspot data. Checked first, as a frame split over several transfers can start with any byte.
+						// There is no reply to each transfer, so schedule the next receive now, unless the stream buffer is full
+						if (com_streambuffer_stalled == false)
+						{
+							error = USB_DeviceCdcAcmRecv(handle, USB_CDC_VCOM_BULK_OUT_ENDPOINT, s_currRecvBuf, g_UsbDeviceCdcVcomDicEndpoints[0].maxPacketSize);
+						}
+					}
+					else if (s_currRecvBuf[0]=='B')
 					{
 						int buff_cnt=0;
 						while ((buff_cnt<(DATA_BUFF_SIZE-3)) && (com_buffer_cnt>0))
@@ -323,6 +332,23 @@ usb_status_t USB_DeviceCdcVcomCallback(class_handle_t handle, uint32_t event, vo
     return error;
 }
 
+/*!
+ * @brief Schedule the next receive on the bulk OUT endpoint.
+ *
+ * Used when a receive was held back because the hotspot stream buffer was full.
+ *
+ * @return A USB error code or kStatus_USB_Success.
+ */
+usb_status_t USB_DeviceCdcVcomScheduleRecv(void)
+{
+    if (1 == s_cdcVcom.attach)
+    {
+        return USB_DeviceCdcAcmRecv(s_cdcVcom.cdcAcmHandle, USB_CDC_VCOM_BULK_OUT_ENDPOINT, s_currRecvBuf, g_UsbDeviceCdcVcomDicEndpoints[0].maxPacketSize);
+    }
+
+    return kStatus_USB_Error;
+}
+
 /*!
  * @brief USB device callback function.
  *
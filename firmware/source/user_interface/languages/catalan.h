@@ -52,6 +52,7 @@ const stringsTable_t catalanLanguage=
 .new_channel			= "Nou canal", // MaxLen: 16, leave room for a space and four channel digits after
 .contact_list			= "Contactes",
 .hotspot_mode			= "Mode Hotspot",
+.inbox					= "Missatges",
 .contact_details		= "Detall Ctte",
 .built					= "Compilat",
 .zones					= "Zones",
@@ -151,7 +152,11 @@ const stringsTable_t catalanLanguage=
 .priority_order			= "Prio.", // MaxLen 16 (with ':' + 'Cc/DB/TA')
 .dmr_beep				= "DMR Beep", // MaxLen 16 (with ':' + .star/.stop/.both/.none)
 .start					= "Inici", // MaxLen 16 (with ':' + .dmr_beep)
-.both					= "Tots" // MaxLen 16 (with ':' + .dmr_beep)
+.both					= "Tots", // MaxLen 16 (with ':' + .dmr_beep)
+.recorder				= "Gravadora", // MaxLen 16 (with ':' + .on/.off)
+.voice_prompts				= "Veu", // MaxLen 16 (with ':' + .on/.off)
+.rx_agc					= "AGC RX", // MaxLen 16 (with ':' + .on/.off)
+.mic_compressor				= "Compr. mic" // MaxLen 16 (with ':' + .off or 4:1)
 };
 /********************************************************************
  *
@@ -52,6 +52,7 @@ const stringsTable_t czechLanguage =
 .new_channel			= "Nov Kanal", // MaxLen: 16, leave room for a space and four channel digits after
 .contact_list			= "Kontakt list", // MaxLen: 16
 .hotspot_mode			= "Hotspot-Md", // MaxLen: 16
+.inbox					= "Zpravy", // MaxLen: 16
 .contact_details		= "Kontakt Detail", // MaxLen: 16
 .built					= "Sestaven", // MaxLen: 16
 .zones					= "Zny", // MaxLen: 16
@@ -151,7 +152,11 @@ const stringsTable_t czechLanguage =
 .priority_order				= "st ID", // MaxLen 16 (with ':' + 'Cc/DB/TA')
 .dmr_beep				= "ppDMR", // MaxLen 16 (with ':' + .star/.stop/.both/.none)
 .start					= "start", // MaxLen 16 (with ':' + .dmr_beep)
-.both					= "StartStop" // MaxLen 16 (with ':' + .dmr_beep)
+.both					= "StartStop", // MaxLen 16 (with ':' + .dmr_beep)
+.recorder				= "Zaznam", // MaxLen 16 (with ':' + .on/.off)
+.voice_prompts				= "Hlas", // MaxLen 16 (with ':' + .on/.off)
+.rx_agc					= "RX AGC", // MaxLen 16 (with ':' + .on/.off)
+.mic_compressor				= "Komp. mik" // MaxLen 16 (with ':' + .off or 4:1)
 };
 /********************************************************************
  *
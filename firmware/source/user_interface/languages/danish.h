@@ -52,6 +52,7 @@ const stringsTable_t danishLanguage =
 .new_channel			= "Ny kanal", // MaxLen: 16, leave room for a space and four channel digits after
 .contact_list			= "Kontakt liste",
 .hotspot_mode			= "Hotspot mode",
+.inbox					= "Indbakke",
 .contact_details		= "Kontakt Detaljer",
 .built					= "Version",
 .zones					= "Zoner",
@@ -151,7 +152,11 @@ const stringsTable_t danishLanguage =
 .priority_order				= "Order", // MaxLen 16 (with ':' + 'Cc/DB/TA')
 .dmr_beep				= "DMR beep", // MaxLen 16 (with ':' + .star/.stop/.both/.none)
 .start					= "Start", // MaxLen 16 (with ':' + .dmr_beep)
-.both					= "Both" // MaxLen 16 (with ':' + .dmr_beep)
+.both					= "Both", // MaxLen 16 (with ':' + .dmr_beep)
+.recorder				= "Optager", // MaxLen 16 (with ':' + .on/.off)
+.voice_prompts				= "Stemme", // MaxLen 16 (with ':' + .on/.off)
+.rx_agc					= "RX AGC", // MaxLen 16 (with ':' + .on/.off)
+.mic_compressor				= "Mik komp" // MaxLen 16 (with ':' + .off or 4:1)
 };
 /********************************************************************
  *
@@ -52,6 +52,7 @@ const stringsTable_t englishLanguage =
 .new_channel				= "New channel", // MaxLen: 16, leave room for a space and four channel digits after
 .contact_list				= "Contact list", // MaxLen: 16
 .hotspot_mode				= "Hotspot mode", // MaxLen: 16
+.inbox						= "Inbox", // MaxLen: 16
 .contact_details			= "Contact Details", // MaxLen: 16
 .built					= "Built", // MaxLen: 16
 .zones					= "Zones", // MaxLen: 16
@@ -151,7 +152,11 @@ const stringsTable_t englishLanguage =
 .priority_order				= "Order", // MaxLen 16 (with ':' + 'Cc/DB/TA')
 .dmr_beep				= "DMR beep", // MaxLen 16 (with ':' + .star/.stop/.both/.none)
 .start					= "Start", // MaxLen 16 (with ':' + .dmr_beep)
-.both					= "Both" // MaxLen 16 (with ':' + .dmr_beep)
+.both					= "Both", // MaxLen 16 (with ':' + .dmr_beep)
+.recorder				= "Recorder", // MaxLen 16 (with ':' + .on/.off)
+.voice_prompts				= "Voice", // MaxLen 16 (with ':' + .on/.off)
+.rx_agc					= "RX AGC", // MaxLen 16 (with ':' + .on/.off)
+.mic_compressor				= "Mic comp" // MaxLen 16 (with ':' + .off or 4:1)
 };
 /********************************************************************
  *
@@ -52,6 +52,7 @@ const stringsTable_t finnishLanguage =
 .new_channel		= "Uusi kanava", 	// MaxLen: 16, leave room for a space and four channel digits after
 .contact_list		= "Kontakti lista",
 .hotspot_mode		= "Hotspotti tila",
+.inbox				= "Saapuneet",
 .contact_details	= "Kontakti Asetus",
 .built			= "Koontiknns",
 .zones			= "Zonet",
@@ -151,7 +152,11 @@ const stringsTable_t finnishLanguage =
 .priority_order		= "Jrjest", 		// MaxLen 16 (with ':' + 'Cc/DB/TA')
 .dmr_beep		= "DMR piippi", 	// MaxLen 16 (with ':' + .star/.stop/.both/.none)
 .start			= "Alku", 		// MaxLen 16 (with ':' + .dmr_beep)
-.both			= "Molemm" 		// MaxLen 16 (with ':' + .dmr_beep)
+.both			= "Molemm", 		// MaxLen 16 (with ':' + .dmr_beep)
+.recorder		= "Tallennin", // MaxLen 16 (with ':' + .on/.off)
+.voice_prompts		= "Puhe", // MaxLen 16 (with ':' + .on/.off)
+.rx_agc			= "RX AGC", // MaxLen 16 (with ':' + .on/.off)
+.mic_compressor		= "Mik. komp" // MaxLen 16 (with ':' + .off or 4:1)
 };
 /********************************************************************
  *
@@ -52,6 +52,7 @@ const stringsTable_t frenchLanguage =
 .new_channel			= "New channel", // MaxLen: 16, leave room for a space and four channel digits after
 .contact_list			= "Liste contacts",
 .hotspot_mode			= "Mode hotspot",
+.inbox					= "Messages",
 .contact_details		= "Dtails contact",
 .built					= "Cr",
 .zones					= "Zones",
@@ -151,7 +152,11 @@ const stringsTable_t frenchLanguage =
 .priority_order				= "Ordre", // MaxLen 16 (with ':' + 'Cc/DB/TA')
 .dmr_beep				= "Bip TX", // MaxLen 16 (with ':' + .star/.stop/.both/.none)
 .start					= "Dbut", // MaxLen 16 (with ':' + .dmr_beep)
-.both					= "Les Deux" // MaxLen 16 (with ':' + .dmr_beep)
+.both					= "Les Deux", // MaxLen 16 (with ':' + .dmr_beep)
+.recorder				= "Enregistr.", // MaxLen 16 (with ':' + .on/.off)
+.voice_prompts				= "Annonces", // MaxLen 16 (with ':' + .on/.off)
+.rx_agc					= "AGC RX", // MaxLen 16 (with ':' + .on/.off)
+.mic_compressor				= "Compr. micro" // MaxLen 16 (with ':' + .off or 4:1)
 };
 /********************************************************************
  *
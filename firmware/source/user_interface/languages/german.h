@@ -52,6 +52,7 @@ const stringsTable_t germanLanguage =
 .new_channel			= "Neuer Kanal", // MaxLen: 16, leave room for a space and four channel digits after
 .contact_list			= "Kontaktliste", // MaxLen: 16
 .hotspot_mode			= "Hotspot-Modus", // MaxLen: 16
+.inbox					= "Posteingang", // MaxLen: 16
 .contact_details		= "Kontakt Details", // MaxLen: 16
 .built					= "Erstellt", // MaxLen: 16
 .zones					= "Zonen", // MaxLen: 16
@@ -151,7 +152,11 @@ const stringsTable_t germanLanguage =
 .priority_order				= "ID-Prio", // MaxLen 16 (with ':' + 'Cc/DB/TA')
 .dmr_beep				= "DMR TX Ton", // MaxLen 16 (with ':' + .star/.stop/.both/.none)
 .start					= "Start", // MaxLen 16 (with ':' + .dmr_beep)
-.both					= "Beide" // MaxLen 16 (with ':' + .dmr_beep)
+.both					= "Beide", // MaxLen 16 (with ':' + .dmr_beep)
+.recorder				= "Rekorder", // MaxLen 16 (with ':' + .on/.off)
+.voice_prompts				= "Ansagen", // MaxLen 16 (with ':' + .on/.off)
+.rx_agc					= "RX AGC", // MaxLen 16 (with ':' + .on/.off)
+.mic_compressor				= "Mik Komp" // MaxLen 16 (with ':' + .off or 4:1)
 };
 /********************************************************************
  *
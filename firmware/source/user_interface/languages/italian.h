@@ -52,6 +52,7 @@ const stringsTable_t italianLanguage =
 .new_channel			= "Nuovo can.", // MaxLen: 16, leave room for a space and four channel digits after
 .contact_list			= "Lista Contatti", // MaxLen: 16
 .hotspot_mode			= "Modo Hotspot", // MaxLen: 16
+.inbox					= "Messaggi", // MaxLen: 16
 .contact_details		= "Det.li Contatto", // MaxLen: 16
 .built					= "Versione", // MaxLen: 16
 .zones					= "Zone", // MaxLen: 16
@@ -151,7 +152,11 @@ const stringsTable_t italianLanguage =
 .priority_order			= "Prio.", // MaxLen 16 (with ':' + 'Cc/DB/TA')
 .dmr_beep				= "DMR bip", // MaxLen 16 (with ':' + .star/.stop/.both/.none)
 .start					= "Inizio", // MaxLen 16 (with ':' + .dmr_beep)
-.both					= "Ambedue" // MaxLen 16 (with ':' + .dmr_beep)
+.both					= "Ambedue", // MaxLen 16 (with ':' + .dmr_beep)
+.recorder				= "Registratore", // MaxLen 16 (with ':' + .on/.off)
+.voice_prompts				= "Voce", // MaxLen 16 (with ':' + .on/.off)
+.rx_agc					= "AGC RX", // MaxLen 16 (with ':' + .on/.off)
+.mic_compressor				= "Compr. mic" // MaxLen 16 (with ':' + .off or 4:1)
 };
 /********************************************************************
  *
@@ -52,6 +52,7 @@ const stringsTable_t polishLanguage =
 .new_channel				= "Nowy kana", // MaxLen: 16, leave room for a space and four channel digits after
 .contact_list				= "Lista kontaktw", // MaxLen: 16
 .hotspot_mode				= "Tryb HotSpot", // MaxLen: 16
+.inbox						= "Odebrane", // MaxLen: 16
 .contact_details			= "Detale kontaktu", // MaxLen: 16
 .built					= "Kompilacja", // MaxLen: 16
 .zones					= "Strefy", // MaxLen: 16
@@ -151,7 +152,11 @@ const stringsTable_t polishLanguage =
 .priority_order				= "Wybr", // MaxLen 16 (with ':' + 'Cc/DB/TA')
 .dmr_beep				= "Wybr bipa", // MaxLen 16 (with ':' + .star/.stop/.both/.none)
 .start					= "Start", // MaxLen 16 (with ':' + .dmr_beep)
-.both					= "Oba" // MaxLen 16 (with ':' + .dmr_beep)
+.both					= "Oba", // MaxLen 16 (with ':' + .dmr_beep)
+.recorder				= "Nagrywanie", // MaxLen 16 (with ':' + .on/.off)
+.voice_prompts				= "Komunikaty", // MaxLen 16 (with ':' + .on/.off)
+.rx_agc					= "RX AGC", // MaxLen 16 (with ':' + .on/.off)
+.mic_compressor				= "Kompr. mik" // MaxLen 16 (with ':' + .off or 4:1)
 };
 /********************************************************************
  *
@@ -52,6 +52,7 @@ const stringsTable_t portuguesLanguage =
 .new_channel			= "Canal novo", // MaxLen: 16, leave room for a space and four channel digits after
 .contact_list			= "Lista Contactos",
 .hotspot_mode			= "Modo Hotspot",
+.inbox					= "Mensagens",
 .contact_details		= "Detalhes Contato",
 .built					= "Built",
 .zones					= "Zonas",
@@ -151,7 +152,11 @@ const stringsTable_t portuguesLanguage =
 .priority_order				= "Order", // MaxLen 16 (with ':' + 'Cc/DB/TA')
 .dmr_beep				= "DMR beep", // MaxLen 16 (with ':' + .star/.stop/.both/.none)
 .start					= "Start", // MaxLen 16 (with ':' + .dmr_beep)
-.both					= "Both" // MaxLen 16 (with ':' + .dmr_beep)
+.both					= "Both", // MaxLen 16 (with ':' + .dmr_beep)
+.recorder				= "Gravador", // MaxLen 16 (with ':' + .on/.off)
+.voice_prompts				= "Voz", // MaxLen 16 (with ':' + .on/.off)
+.rx_agc					= "AGC RX", // MaxLen 16 (with ':' + .on/.off)
+.mic_compressor				= "Compr. mic" // MaxLen 16 (with ':' + .off or 4:1)
 };
 /********************************************************************
  *
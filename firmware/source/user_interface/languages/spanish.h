@@ -52,6 +52,7 @@ const stringsTable_t spanishLanguage =
 .new_channel			= "Nuevo canal", // MaxLen: 16, leave room for a space and four channel digits after
 .contact_list			= "Lista contactos", // MaxLen: 16
 .hotspot_mode			= "Modo Hotspot", // MaxLen: 16
+.inbox					= "Mensajes", // MaxLen: 16
 .contact_details		= "Detalles contacto", // MaxLen: 16
 .built					= "Compilado", // MaxLen: 16
 .zones					= "Zonas", // MaxLen: 16
@@ -151,7 +152,11 @@ const stringsTable_t spanishLanguage =
 .priority_order				= "Orden", // MaxLen 16 (with ':' + 'Cc/DB/TA')
 .dmr_beep				= "DMR beep", // MaxLen 16 (with ':' + .star/.stop/.both/.none)
 .start					= "Inicio", // MaxLen 16 (with ':' + .dmr_beep)
-.both					= "Ambos" // MaxLen 16 (with ':' + .dmr_beep)
+.both					= "Ambos", // MaxLen 16 (with ':' + .dmr_beep)
+.recorder				= "Grabadora", // MaxLen 16 (with ':' + .on/.off)
+.voice_prompts				= "Voz", // MaxLen 16 (with ':' + .on/.off)
+.rx_agc					= "AGC RX", // MaxLen 16 (with ':' + .on/.off)
+.mic_compressor				= "Compr. mic" // MaxLen 16 (with ':' + .off or 4:1)
 };
 /********************************************************************
  *
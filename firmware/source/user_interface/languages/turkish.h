@@ -52,6 +52,7 @@ const stringsTable_t turkishLanguage =
 .new_channel				= "Yeni Kanal", // MaxLen: 16, leave room for a space and four channel digits after
 .contact_list				= "Kii listesi", // MaxLen: 16
 .hotspot_mode				= "Eriim Modu", // MaxLen: 16
+.inbox						= "Gelen kutusu", // MaxLen: 16
 .contact_details			= "Kii Detaylar", // MaxLen: 16
 .built					= "Oluturma", // MaxLen: 16
 .zones					= "Blgeler", // MaxLen: 16
@@ -151,7 +152,11 @@ const stringsTable_t turkishLanguage =
 .priority_order				= "ncelik", // MaxLen 16 (with ':' + 'Cc/DB/TA')
 .dmr_beep				= "DMR beep", // MaxLen 16 (with ':' + .star/.stop/.both/.none)
 .start					= "Start", // MaxLen 16 (with ':' + .dmr_beep)
-.both					= "Both" // MaxLen 16 (with ':' + .dmr_beep)
+.both					= "Both", // MaxLen 16 (with ':' + .dmr_beep)
+.recorder				= "Kayit", // MaxLen 16 (with ':' + .on/.off)
+.voice_prompts				= "Ses", // MaxLen 16 (with ':' + .on/.off)
+.rx_agc					= "RX AGC", // MaxLen 16 (with ':' + .on/.off)
+.mic_compressor				= "Mic comp" // MaxLen 16 (with ':' + .off or 4:1)
 };
 /********************************************************************
  *
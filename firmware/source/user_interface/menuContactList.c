@@ -22,8 +22,9 @@
 #include <user_interface/uiUtilities.h>
 #include <user_interface/uiLocalisation.h>
 
-static void updateScreen(void);
+static void updateScreen(bool fullRender);
 static void handleEvent(uiEvent_t *ev);
+static bool loadContactName(int number, char *text);
 static struct_codeplugContact_t contact;
 static int contactCallType;
 static int menuContactListDisplayState;
@@ -49,12 +50,16 @@ static void reloadContactList(void)
 	} else {
 		contactListContactIndex = 0;
 	}
+	menuListCacheInvalidate();
 }
 
 int menuContactList(uiEvent_t *ev, bool isFirstRun)
 {
 	if (isFirstRun)
 	{
+		menuListCacheSetLoadFunction(loadContactName);
+		menuListCacheInvalidate();
+
 		if (menuContactListOverrideState == 0) {
 			if (contactListContactIndex == 0) {
 				contactCallType = CONTACT_CALLTYPE_TG;
@@ -71,7 +76,7 @@ int menuContactList(uiEvent_t *ev, bool isFirstRun)
 			menuContactListDisplayState = menuContactListOverrideState;
 			menuContactListOverrideState = 0;
 		}
-		updateScreen();
+		updateScreen(true);
 	}
 	else
 	{
@@ -79,23 +84,52 @@ int menuContactList(uiEvent_t *ev, bool isFirstRun)
 		{
 			handleEvent(ev);
 		}
+		else if (menuContactListDisplayState == MENU_CONTACT_LIST_DISPLAY)
+		{
+			menuListPrefetchTick(gMenusEndIndex);
+		}
 	}
 	return 0;
 }
 
-static void updateScreen(void)
+static bool loadContactName(int number, char *text)
+{
+	struct_codeplugContact_t contactBuf;
+
+	if (codeplugContactGetDataForNumber(number + 1, contactCallType, &contactBuf) > 0)
+	{
+		codeplugUtilConvertBufToString(contactBuf.name, text, 16); // need to convert to zero terminated string
+		return true;
+	}
+
+	return false;
+}
+
+// The list can be scrolled without a full render, as only the entries are changing
+static void updateScreen(bool fullRender)
 {
 	char nameBuf[33];
 	int mNum;
-	int idx;
+	const char *entryText;
 	const char *calltypeName[] = { currentLanguage->group_call, currentLanguage->private_call, currentLanguage->all_call };
 
-	ucClearBuf();
+	if ((fullRender == false) && (menuContactListDisplayState == MENU_CONTACT_LIST_DISPLAY) && (gMenusEndIndex != 0))
+	{
+		menuClearListArea();
+	}
+	else
+	{
+		fullRender = true;
+		ucClearBuf();
+	}
 
 	switch (menuContactListDisplayState)
 	{
 	case MENU_CONTACT_LIST_DISPLAY:
-		menuDisplayTitle((char *) calltypeName[contactCallType]);
+		if (fullRender)
+		{
+			menuDisplayTitle((char *) calltypeName[contactCallType]);
+		}
 
 		if (gMenusEndIndex == 0)
 		{
@@ -106,12 +140,11 @@ static void updateScreen(void)
 			for (int i = -1; i <= 1; i++)
 			{
 				mNum = menuGetMenuOffset(gMenusEndIndex, i);
-				idx = codeplugContactGetDataForNumber(mNum + 1, contactCallType, &contact);
+				entryText = menuListCacheGetText(mNum);
 
-				if (idx > 0)
+				if (entryText != NULL)
 				{
-					codeplugUtilConvertBufToString(contact.name, nameBuf, 16); // need to convert to zero terminated string
-					menuDisplayEntry(i, mNum, (char*) nameBuf);
+					menuDisplayEntry(i, mNum, entryText);
 				}
 			}
 		}
@@ -135,7 +168,15 @@ static void updateScreen(void)
 		ucDrawChoice(CHOICE_DISMISS, false);
 		break;
 	}
-	ucRender();
+
+	if (fullRender)
+	{
+		ucRender();
+	}
+	else
+	{
+		menuRenderListArea();
+	}
 	displayLightTrigger();
 }
 
@@ -147,18 +188,14 @@ static void handleEvent(uiEvent_t *ev)
 		if (KEYCHECK_PRESS(ev->keys, KEY_DOWN))
 		{
 			MENU_INC(gMenusCurrentItemIndex, gMenusEndIndex);
-			contactListContactIndex = codeplugContactGetDataForNumber(
-					gMenusCurrentItemIndex + 1, contactCallType,
-					&contactListContactData);
-			updateScreen();
+			menuListSetScrollDirection(1);
+			updateScreen(false);
 		}
 		else if (KEYCHECK_PRESS(ev->keys, KEY_UP))
 		{
 			MENU_DEC(gMenusCurrentItemIndex, gMenusEndIndex);
-			contactListContactIndex = codeplugContactGetDataForNumber(
-					gMenusCurrentItemIndex + 1, contactCallType,
-					&contactListContactData);
-			updateScreen();
+			menuListSetScrollDirection(-1);
+			updateScreen(false);
 		}
 		else if (KEYCHECK_SHORTUP(ev->keys, KEY_HASH))
 		{
@@ -171,10 +208,13 @@ static void handleEvent(uiEvent_t *ev)
 				contactCallType = CONTACT_CALLTYPE_TG;
 			}
 			reloadContactList();
-			updateScreen();
+			updateScreen(true);
 		}
 		else if (KEYCHECK_SHORTUP(ev->keys, KEY_GREEN))
 		{
+			// The selected contact is only read when needed, not on each scroll
+			contactListContactIndex = codeplugContactGetDataForNumber(gMenusCurrentItemIndex + 1, contactCallType, &contactListContactData);
+
 			if (menuSystemGetCurrentMenuNumber() == MENU_CONTACT_QUICKLIST)
 			{
 				setOverrideTGorPC(contactListContactData.tgNumber, contactListContactData.callType == CONTACT_CALLTYPE_PC);
@@ -205,13 +245,13 @@ static void handleEvent(uiEvent_t *ev)
 			menuContactListTimeout = 2000;
 			menuContactListDisplayState = MENU_CONTACT_LIST_DELETED;
 			reloadContactList();
-			updateScreen();
+			updateScreen(true);
 		}
 		else if (KEYCHECK_SHORTUP(ev->keys, KEY_RED))
 		{
 			menuContactListDisplayState = MENU_CONTACT_LIST_DISPLAY;
 			reloadContactList();
-			updateScreen();
+			updateScreen(true);
 		}
 		break;
 
@@ -223,7 +263,7 @@ static void handleEvent(uiEvent_t *ev)
 			menuContactListDisplayState = MENU_CONTACT_LIST_DISPLAY;
 			reloadContactList();
 		}
-		updateScreen();
+		updateScreen(true);
 		break;
 	}
 }
@@ -19,7 +19,7 @@
 #include <user_interface/menuSystem.h>
 #include <user_interface/uiLocalisation.h>
 
-static void updateScreen(void);
+static void updateScreen(bool fullRender);
 static void handleEvent(uiEvent_t *ev);
 
 int menuDisplayMenuList(uiEvent_t *ev, bool isFirstRun)
@@ -29,7 +29,7 @@ int menuDisplayMenuList(uiEvent_t *ev, bool isFirstRun)
 		gMenuCurrentMenuList = (menuItemNew_t *)menusData[menuSystemGetCurrentMenuNumber()];
 		gMenusEndIndex = gMenuCurrentMenuList[0].menuNum;// first entry actually contains the number of entries
 		gMenuCurrentMenuList = &gMenuCurrentMenuList[1];// move to first real index
-		updateScreen();
+		updateScreen(true);
 	}
 	else
 	{
@@ -39,12 +39,19 @@ int menuDisplayMenuList(uiEvent_t *ev, bool isFirstRun)
 	return 0;
 }
 
-static void updateScreen(void)
+static void updateScreen(bool fullRender)
 {
 	int mNum;
 
-	ucClearBuf();
-	menuDisplayTitle(currentLanguage->menu);
+	if (fullRender)
+	{
+		ucClearBuf();
+		menuDisplayTitle(currentLanguage->menu);
+	}
+	else
+	{
+		menuClearListArea();
+	}
 
 	for(int i = -1; i <= 1 ; i++)
 	{
@@ -59,7 +66,14 @@ static void updateScreen(void)
 		}
 	}
 
-	ucRender();
+	if (fullRender)
+	{
+		ucRender();
+	}
+	else
+	{
+		menuRenderListArea();
+	}
 	displayLightTrigger();
 }
 
@@ -70,12 +84,12 @@ static void handleEvent(uiEvent_t *ev)
 	if (KEYCHECK_PRESS(ev->keys,KEY_DOWN))
 	{
 		MENU_INC(gMenusCurrentItemIndex, gMenusEndIndex);
-		updateScreen();
+		updateScreen(false);
 	}
 	else if (KEYCHECK_PRESS(ev->keys,KEY_UP))
 	{
 		MENU_DEC(gMenusCurrentItemIndex, gMenusEndIndex);
-		updateScreen();
+		updateScreen(false);
 	}
 	else if (KEYCHECK_SHORTUP(ev->keys,KEY_GREEN))
 	{
@@ -15,16 +15,21 @@
  * along with this program; if not, write to the Free Software
  * Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
  */
+#include <bootProfiler.h>
 #include <user_interface/menuSystem.h>
 #include <user_interface/uiLocalisation.h>
 
 static void updateScreen(void);
+static void updateBootTimelineScreen(void);
 static void handleEvent(uiEvent_t *ev);
 
+static int bootTimelineOffset;// -1 for the firmware info, otherwise the first boot stage shown below it
+
 int menuFirmwareInfoScreen(uiEvent_t *ev, bool isFirstRun)
 {
 	if (isFirstRun)
 	{
+		bootTimelineOffset = -1;
 		updateScreen();
 	}
 	else
@@ -41,6 +46,12 @@ static void updateScreen(void)
 {
 	char buf[17];
 
+	if (bootTimelineOffset >= 0)
+	{
+		updateBootTimelineScreen();
+		return;
+	}
+
 	snprintf(buf, 16, "[ %s", GITVERSION);
 	buf[9] = 0; // git hash id 7 char long;
 	strcat(buf, " ]");
@@ -72,12 +83,54 @@ static void updateScreen(void)
 	displayLightTrigger();
 }
 
+// Time at the end of each boot stage, in uS since the clocks were set up
+static void updateBootTimelineScreen(void)
+{
+	char buf[22];
+	int numLines = (DISPLAY_SIZE_Y / 8) - 1;
+
+	ucClearBuf();
+	ucPrintCentered(0, "Boot timeline (uS)", FONT_SIZE_1);
+
+	for (int i = 0; i < numLines; i++)
+	{
+		int stage = bootTimelineOffset + i;
+
+		if (stage >= bootProfiler.numStages)
+		{
+			break;
+		}
+
+		snprintf(buf, sizeof(buf), "%-11s%10d", bootProfiler.stages[stage].name, (int)bootProfiler.stages[stage].timeUs);
+		ucPrintAt(0, 8 + (i * 8), buf, FONT_SIZE_1);
+	}
+
+	ucRender();
+	displayLightTrigger();
+}
 
 static void handleEvent(uiEvent_t *ev)
 {
 	displayLightTrigger();
 
-	if (KEYCHECK_PRESS(ev->keys,KEY_RED))
+	// Down from the firmware info shows the boot timeline, and scrolls it
+	if (KEYCHECK_PRESS(ev->keys,KEY_DOWN))
+	{
+		if (bootTimelineOffset < ((int)bootProfiler.numStages - ((DISPLAY_SIZE_Y / 8) - 1)))
+		{
+			bootTimelineOffset++;
+			updateScreen();
+		}
+	}
+	else if (KEYCHECK_PRESS(ev->keys,KEY_UP))
+	{
+		if (bootTimelineOffset >= 0)
+		{
+			bootTimelineOffset--;
+			updateScreen();
+		}
+	}
+	else if (KEYCHECK_PRESS(ev->keys,KEY_RED))
 	{
 		menuSystemPopPreviousMenu();
 		return;
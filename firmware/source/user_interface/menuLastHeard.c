@@ -15,6 +15,7 @@
  * along with this program; if not, write to the Free Software
  * Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
  */
+#include <ambeRecorder.h>
 #include <ticks.h>
 #include <user_interface/menuSystem.h>
 #include <user_interface/uiUtilities.h>
@@ -24,7 +25,9 @@ static const int LAST_HEARD_NUM_LINES_ON_DISPLAY = 3;
 static bool displayLHDetails = false;
 
 static void handleEvent(uiEvent_t *ev);
-static void menuLastHeardDisplayTA(uint8_t y, char *text, uint32_t time, uint32_t now, uint32_t TGorPC, size_t maxLen, bool displayDetails);
+static bool loadDMRIDText(int id, char *text);
+static void displayList(bool displayDetails);
+static void menuLastHeardDisplayTA(uint8_t y, char *text, uint32_t time, uint32_t now, uint32_t TGorPC, int ber, size_t maxLen, bool displayDetails);
 
 int menuLastHeard(uiEvent_t *ev, bool isFirstRun)
 {
@@ -35,6 +38,8 @@ int menuLastHeard(uiEvent_t *ev, bool isFirstRun)
 		gMenusStartIndex = LinkHead->id;// reuse this global to store the ID of the first item in the list
 		gMenusEndIndex = 0;
 		displayLHDetails = false;
+		menuListCacheSetLoadFunction(loadDMRIDText);
+		menuListCacheInvalidate();
 		menuLastHeardUpdateScreen(true, displayLHDetails);
 		m = ev->time;
 	}
@@ -63,19 +68,43 @@ int menuLastHeard(uiEvent_t *ev, bool isFirstRun)
 				m = ev->time;
 				menuLastHeardUpdateScreen(true, true);
 			}
+			else
+			{
+				// Look up the name of the entry which will be displayed if the list scrolls down
+				LinkItem_t *item = LinkHead;
+
+				for (int i = 0; (i < (gMenusCurrentItemIndex + LAST_HEARD_NUM_LINES_ON_DISPLAY)) && (item != NULL); i++)
+				{
+					item = item->next;
+				}
+
+				if ((item != NULL) && (item->id != 0))
+				{
+					menuListCachePrefetch(item->id);
+				}
+			}
 		}
 
 	}
 	return 0;
 }
 
-void menuLastHeardUpdateScreen(bool showTitleOrHeader, bool displayDetails)
+static bool loadDMRIDText(int id, char *text)
 {
 	dmrIdDataStruct_t foundRecord;
-	int numDisplayed = 0;
-	LinkItem_t *item = LinkHead;
-	uint32_t now = fw_millis();
 
+	if (dmrIDLookup(id, &foundRecord))
+	{
+		memcpy(text, foundRecord.text, sizeof(foundRecord.text));
+		text[sizeof(foundRecord.text)] = 0;
+		return true;
+	}
+
+	return false;
+}
+
+void menuLastHeardUpdateScreen(bool showTitleOrHeader, bool displayDetails)
+{
 	ucClearBuf();
 	if (showTitleOrHeader)
 	{
@@ -86,6 +115,21 @@ void menuLastHeardUpdateScreen(bool showTitleOrHeader, bool displayDetails)
 		menuUtilityRenderHeader();
 	}
 
+	// This can also be called from the TX screen, which doesn't use the list cache
+	menuListCacheSetLoadFunction(loadDMRIDText);
+	displayList(displayDetails);
+
+	ucRender();
+	menuDisplayQSODataState = QSO_DISPLAY_IDLE;
+}
+
+static void displayList(bool displayDetails)
+{
+	const char *text;
+	int numDisplayed = 0;
+	LinkItem_t *item = LinkHead;
+	uint32_t now = fw_millis();
+
 	// skip over the first gMenusCurrentItemIndex in the listing
 	for(int i = 0; i < gMenusCurrentItemIndex; i++)
 	{
@@ -94,15 +138,15 @@ void menuLastHeardUpdateScreen(bool showTitleOrHeader, bool displayDetails)
 
 	while((item != NULL) && (item->id != 0))
 	{
-		if (dmrIDLookup(item->id, &foundRecord))
+		if ((text = menuListCacheGetText(item->id)) != NULL)
 		{
-			menuLastHeardDisplayTA(16 + (numDisplayed * MENU_ENTRY_HEIGHT), foundRecord.text, item->time, now, item->talkGroupOrPcId, 20, displayDetails);
+			menuLastHeardDisplayTA(16 + (numDisplayed * MENU_ENTRY_HEIGHT), (char *)text, item->time, now, item->talkGroupOrPcId, item->ber, 20, displayDetails);
 		}
 		else
 		{
 			if (item->talkerAlias[0] != 0x00)
 			{
-				menuLastHeardDisplayTA(16 + (numDisplayed * MENU_ENTRY_HEIGHT), item->talkerAlias, item->time, now, item->talkGroupOrPcId, 32, displayDetails);
+				menuLastHeardDisplayTA(16 + (numDisplayed * MENU_ENTRY_HEIGHT), item->talkerAlias, item->time, now, item->talkGroupOrPcId, item->ber, 32, displayDetails);
 			}
 			else
 			{
@@ -110,7 +154,7 @@ void menuLastHeardUpdateScreen(bool showTitleOrHeader, bool displayDetails)
 
 				snprintf(buffer, 17, "ID:%d", item->id);
 				buffer[16] = 0;
-				menuLastHeardDisplayTA(16 + (numDisplayed * MENU_ENTRY_HEIGHT), buffer, item->time, now, item->talkGroupOrPcId, 17, displayDetails);
+				menuLastHeardDisplayTA(16 + (numDisplayed * MENU_ENTRY_HEIGHT), buffer, item->time, now, item->talkGroupOrPcId, item->ber, 17, displayDetails);
 			}
 		}
 
@@ -130,8 +174,6 @@ void menuLastHeardUpdateScreen(bool showTitleOrHeader, bool displayDetails)
 			break;
 		}
 	}
-	ucRender();
-	menuDisplayQSODataState = QSO_DISPLAY_IDLE;
 }
 
 static void handleEvent(uiEvent_t *ev)
@@ -159,6 +201,25 @@ static void handleEvent(uiEvent_t *ev)
 		menuSystemPopAllAndDisplayRootMenu();
 		return;
 	}
+	else if (KEYCHECK_SHORTUP(ev->keys, KEY_RIGHT))
+	{
+		// Play the last recorded call of the station at the top of the display
+		LinkItem_t *item = LinkHead;
+
+		for(int i = 0; (i < gMenusCurrentItemIndex) && (item != NULL); i++)
+		{
+			item = item->next;
+		}
+
+		if ((item != NULL) && (item->id != 0) && (ambeRecorderPlayLastCall(item->id) == false))
+		{
+			set_melody(melody_ERROR_beep);
+		}
+	}
+	else if (KEYCHECK_SHORTUP(ev->keys, KEY_LEFT))
+	{
+		ambeRecorderStopPlayback();
+	}
 
 	// Toggles LH simple/details view on SK2 press
 	if (ev->buttons & BUTTON_SK2)
@@ -170,10 +231,14 @@ static void handleEvent(uiEvent_t *ev)
 		displayLHDetails = false;
 	}
 
-	menuLastHeardUpdateScreen(true, displayLHDetails);
+	// Only the list needs to be redrawn, the title doesn't change
+	ucClearRows(2, (DISPLAY_SIZE_Y / 8), false);
+	displayList(displayLHDetails);
+	ucRenderRows(2, (DISPLAY_SIZE_Y / 8));
+	menuDisplayQSODataState = QSO_DISPLAY_IDLE;
 }
 
-static void menuLastHeardDisplayTA(uint8_t y, char *text, uint32_t time, uint32_t now, uint32_t TGorPC, size_t maxLen, bool displayDetails)
+static void menuLastHeardDisplayTA(uint8_t y, char *text, uint32_t time, uint32_t now, uint32_t TGorPC, int ber, size_t maxLen, bool displayDetails)
 {
 	char buffer[37]; // Max: TA 27 (in 7bit format) + ' [' + 6 (Maidenhead)  + ']' + NULL
 
@@ -185,17 +250,31 @@ static void menuLastHeardDisplayTA(uint8_t y, char *text, uint32_t time, uint32_
 		// PC or TG
 		sprintf(buffer, "%s %u", (((TGorPC >> 24) == PC_CALL_FLAG) ? "PC" : "TG"), tg);
 		ucPrintAt(0, y, buffer, FONT_SIZE_3);
+		int berXPos = (strlen(buffer) * 8) + 2;
 
 		// Time
 		snprintf(buffer, 5, "%d", diffTimeInMins);
 		buffer[5] = 0;
+		int timeXPos = (128 - (strlen(buffer) * 8) - (3 * 6) - 1);
 
 #if defined(PLATFORM_RD5R)
 		ucPrintAt((128 - (3 * 6)), y		, "min", FONT_SIZE_1);
 #else
 		ucPrintAt((128 - (3 * 6)), (y + 6)	, "min", FONT_SIZE_1);
 #endif
-		ucPrintAt((128 - (strlen(buffer) * 8) - (3 * 6) - 1), y, buffer, FONT_SIZE_3);
+		ucPrintAt(timeXPos, y, buffer, FONT_SIZE_3);
+
+		// Bit error rate of the last call, if there is room between the TG and the time
+		if (ber >= 0)
+		{
+			snprintf(buffer, 8, "%d.%d%%", ber / 10, ber % 10);
+			buffer[7] = 0;
+
+			if ((berXPos + (strlen(buffer) * 6)) < timeXPos)
+			{
+				ucPrintAt(berXPos, y, buffer, FONT_SIZE_1);
+			}
+		}
 	}
 	else // search for callsign + first name
 	{
@@ -16,49 +16,250 @@
  * Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
  */
 
+#include <dmrData.h>
 #include <user_interface/menuSystem.h>
+#include <user_interface/uiUtilities.h>
+#include <user_interface/uiLocalisation.h>
 
-static void updateScreen(void);
+static const int MESSAGE_TEXT_Y_POS = 26;
+static const int MESSAGE_TEXT_LINE_HEIGHT = 8;
+static const int MESSAGE_TEXT_LINE_LENGTH = 21;// FONT_SIZE_1 characters across the display
+
+static void updateScreen(bool fullRender);
+static void updateMessageScreen(void);
 static void handleEvent(uiEvent_t *ev);
-static int updateCounter;
+static bool loadMessageSender(int number, char *text);
+static void getSenderText(uint32_t srcId, char *text);
+static bool openMessage(int number);
+
+__attribute__((section(".data.$RAM2"))) static dmrDataInboxRecord_t message;
+static int messageTextLength;
+static int messageLineOffset;
+static bool displayMessage;
 
 int menuMessageScreen(uiEvent_t *ev, bool isFirstRun)
 {
 	if (isFirstRun)
 	{
-		updateCounter=0;
-		updateScreen();
+		gMenusEndIndex = dmrDataInboxGetCount();
+		gMenusCurrentItemIndex = 0;
+		displayMessage = false;
+		menuListCacheSetLoadFunction(loadMessageSender);
+		menuListCacheInvalidate();
+		updateScreen(true);
 	}
 	else
 	{
 		if (ev->hasEvent)
+		{
 			handleEvent(ev);
+		}
+		else if (displayMessage == false)
+		{
+			menuListPrefetchTick(gMenusEndIndex);
+		}
 	}
 	return 0;
 }
 
-static void updateScreen(void)
+static void getSenderText(uint32_t srcId, char *text)
+{
+	dmrIdDataStruct_t foundRecord;
+
+	if (dmrIDLookup(srcId, &foundRecord))
+	{
+		memcpy(text, foundRecord.text, sizeof(foundRecord.text));
+		text[sizeof(foundRecord.text)] = 0;
+	}
+	else
+	{
+		sprintf(text, "ID:%u", srcId);
+	}
+}
+
+static bool loadMessageSender(int number, char *text)
+{
+	if (dmrDataInboxGetMessage(number, &message) == false)
+	{
+		return false;
+	}
+
+	getSenderText(message.srcId, text);
+	return true;
+}
+
+// Read the message, and squeeze its data down to the displayable text.
+// UTF-16 text (the usual DMR text message encoding) has a 0x00 in every other byte, those are skipped.
+static bool openMessage(int number)
+{
+	int length;
+
+	if (dmrDataInboxGetMessage(number, &message) == false)
+	{
+		return false;
+	}
+
+	length = (message.length < DMR_DATA_INBOX_DATA_LENGTH) ? message.length : DMR_DATA_INBOX_DATA_LENGTH;
+	messageTextLength = 0;
+	for (int i = 0; i < length; i++)
+	{
+		uint8_t c = message.data[i];
+
+		if (c == 0x00)
+		{
+			continue;
+		}
+		if ((c == '\r') || (c == '\n'))
+		{
+			c = ' ';
+		}
+		else if ((c < 0x20) || (c > 0x7E))
+		{
+			c = '.';
+		}
+		message.data[messageTextLength++] = c;
+	}
+	messageLineOffset = 0;
+
+	return true;
+}
+
+static void updateScreen(bool fullRender)
 {
-//	char buffer[8];
+	int mNum;
+
+	if (fullRender)
+	{
+		ucClearBuf();
+		menuDisplayTitle(currentLanguage->inbox);
+	}
+	else
+	{
+		menuClearListArea();
+	}
+
+	if (gMenusEndIndex == 0)
+	{
+		ucPrintCentered((DISPLAY_SIZE_Y / 2), currentLanguage->empty_list, FONT_SIZE_3);
+	}
+	else
+	{
+		for(int i = -1; i <= 1; i++)
+		{
+			if (gMenusEndIndex <= (i + 1))
+			{
+				break;
+			}
+
+			mNum = menuGetMenuOffset(gMenusEndIndex, i);
+
+			menuDisplayEntry(i, mNum, menuListCacheGetText(mNum));
+		}
+	}
+
+	if (fullRender)
+	{
+		ucRender();
+	}
+	else
+	{
+		menuRenderListArea();
+	}
+	displayLightTrigger();
+}
+
+static void updateMessageScreen(void)
+{
+	char buffer[MESSAGE_TEXT_LINE_LENGTH + 1];
+	int numLines = (DISPLAY_SIZE_Y - MESSAGE_TEXT_Y_POS) / MESSAGE_TEXT_LINE_HEIGHT;
 
 	ucClearBuf();
-	menuDisplayTitle("Message");
+	getSenderText(message.srcId, buffer);
+	menuDisplayTitle(buffer);
+
+	sprintf(buffer, "%s %u%s", ((message.flags & DMR_DATA_INBOX_FLAG_GROUP) ? "TG" : "PC"), message.dstId,
+			((message.flags & DMR_DATA_INBOX_FLAG_TRUNCATED) ? " ..." : ""));
+	ucPrintCentered(16, buffer, FONT_SIZE_1);
+
+	for (int i = 0; i < numLines; i++)
+	{
+		int start = (messageLineOffset + i) * MESSAGE_TEXT_LINE_LENGTH;
+		int length = messageTextLength - start;
+
+		if (length <= 0)
+		{
+			break;
+		}
+		if (length > MESSAGE_TEXT_LINE_LENGTH)
+		{
+			length = MESSAGE_TEXT_LINE_LENGTH;
+		}
+
+		memcpy(buffer, &message.data[start], length);
+		buffer[length] = 0;
+		ucPrintAt(0, MESSAGE_TEXT_Y_POS + (i * MESSAGE_TEXT_LINE_HEIGHT), buffer, FONT_SIZE_1);
+	}
 
 	ucRender();
 	displayLightTrigger();
 }
 
-
 static void handleEvent(uiEvent_t *ev)
 {
-	if (KEYCHECK_SHORTUP(ev->keys,KEY_RED))
+	displayLightTrigger();
+
+	if (displayMessage)
 	{
-		menuSystemPopPreviousMenu();
+		int numTextLines = (messageTextLength + MESSAGE_TEXT_LINE_LENGTH - 1) / MESSAGE_TEXT_LINE_LENGTH;
+		int numLines = (DISPLAY_SIZE_Y - MESSAGE_TEXT_Y_POS) / MESSAGE_TEXT_LINE_HEIGHT;
+
+		if (KEYCHECK_PRESS(ev->keys,KEY_DOWN))
+		{
+			if ((messageLineOffset + numLines) < numTextLines)
+			{
+				messageLineOffset++;
+				updateMessageScreen();
+			}
+		}
+		else if (KEYCHECK_PRESS(ev->keys,KEY_UP))
+		{
+			if (messageLineOffset > 0)
+			{
+				messageLineOffset--;
+				updateMessageScreen();
+			}
+		}
+		else if (KEYCHECK_SHORTUP(ev->keys,KEY_RED) || KEYCHECK_SHORTUP(ev->keys,KEY_LEFT))
+		{
+			displayMessage = false;
+			updateScreen(true);
+		}
 		return;
 	}
-	else if (KEYCHECK_SHORTUP(ev->keys,KEY_GREEN))
+
+	if (KEYCHECK_PRESS(ev->keys,KEY_DOWN) && (gMenusEndIndex != 0))
+	{
+		MENU_INC(gMenusCurrentItemIndex, gMenusEndIndex);
+		menuListSetScrollDirection(1);
+		updateScreen(false);
+	}
+	else if (KEYCHECK_PRESS(ev->keys,KEY_UP) && (gMenusEndIndex != 0))
+	{
+		MENU_DEC(gMenusCurrentItemIndex, gMenusEndIndex);
+		menuListSetScrollDirection(-1);
+		updateScreen(false);
+	}
+	else if ((KEYCHECK_SHORTUP(ev->keys,KEY_GREEN) || KEYCHECK_SHORTUP(ev->keys,KEY_RIGHT)) && (gMenusEndIndex != 0))
+	{
+		if (openMessage(gMenusCurrentItemIndex))
+		{
+			displayMessage = true;
+			updateMessageScreen();
+		}
+	}
+	else if (KEYCHECK_SHORTUP(ev->keys,KEY_RED))
 	{
-		menuSystemPopAllAndDisplayRootMenu();
+		menuSystemPopPreviousMenu();
 		return;
 	}
 }
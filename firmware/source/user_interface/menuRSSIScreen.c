@@ -25,6 +25,40 @@
 static calibrationRSSIMeter_t rssiCalibration;
 static void updateScreen(void);
 static void handleEvent(uiEvent_t *ev);
+static void bandScopeStart(void);
+static void bandScopeTick(void);
+static void bandScopeUpdateHeader(void);
+
+// Band scope. The receiver is swept across BAND_SCOPE_NUM_COLUMNS frequencies around the current frequency,
+// using the fast Rx tuning (only the AT1846S frequency registers are changed) and reading the RSSI of each one.
+// Each column is drawn and sent to the display as soon as it has been measured, and a short waterfall
+// (one bit per column, set when the column is above the average level of the sweep) is kept below the spectrum.
+#define BAND_SCOPE_NUM_COLUMNS 		64
+#define BAND_SCOPE_COLUMN_WIDTH		(128 / BAND_SCOPE_NUM_COLUMNS)
+#define BAND_SCOPE_WATERFALL_LINES	16
+#define BAND_SCOPE_WATERFALL_ROWS	(BAND_SCOPE_WATERFALL_LINES / 8)
+#define BAND_SCOPE_SPECTRUM_START_ROW 2
+
+typedef enum
+{
+	RSSI_SCREEN_METER = 0,
+	RSSI_SCREEN_BAND_SCOPE
+} rssiScreenMode_t;
+
+static const int BAND_SCOPE_STEPS[] = { 250, 500, 625, 1000, 1250, 2500, 5000, 10000 };// In units of 10Hz, like the frequencies
+static const int BAND_SCOPE_NUM_STEPS = (sizeof(BAND_SCOPE_STEPS) / sizeof(BAND_SCOPE_STEPS[0]));
+static const int BAND_SCOPE_SETTLING_TIME = 2;// Main loop ticks between retune and RSSI read
+
+static rssiScreenMode_t rssiScreenMode = RSSI_SCREEN_METER;
+static int bandScopeStepIndex = 4;// 12.5kHz
+static int bandScopeCentreFrequency = 0;
+static int bandScopeColumn;
+static int bandScopeSettlingTimer;
+static bool bandScopeTuned;
+static uint8_t bandScopeLevel[BAND_SCOPE_NUM_COLUMNS];
+static uint8_t bandScopePeak[BAND_SCOPE_NUM_COLUMNS];
+static uint8_t bandScopeWaterfall[BAND_SCOPE_WATERFALL_LINES][BAND_SCOPE_NUM_COLUMNS / 8];// ring of bitmaps, one bit per column
+static int bandScopeWaterfallHead;
 
 int menuRSSIScreen(uiEvent_t *ev, bool isFirstRun)
 {
@@ -33,13 +67,22 @@ int menuRSSIScreen(uiEvent_t *ev, bool isFirstRun)
 	if (isFirstRun)
 	{
 		calibrationGetRSSIMeterParams(&rssiCalibration);
+
+		if (rssiScreenMode == RSSI_SCREEN_BAND_SCOPE)
+		{
+			bandScopeStart();
+		}
 	}
 	else
 	{
 		if (ev->hasEvent)
 			handleEvent(ev);
 
-		if((ev->time - m) > RSSI_UPDATE_COUNTER_RELOAD)
+		if (rssiScreenMode == RSSI_SCREEN_BAND_SCOPE)
+		{
+			bandScopeTick();
+		}
+		else if((ev->time - m) > RSSI_UPDATE_COUNTER_RELOAD)
 		{
 			m = ev->time;
 			updateScreen();
@@ -48,6 +91,19 @@ int menuRSSIScreen(uiEvent_t *ev, bool isFirstRun)
 	return 0;
 }
 
+static int rssiToDbm(int band, uint8_t rssi)
+{
+	if (band == RADIO_BAND_UHF)
+	{
+		// Use fixed point maths to scale the RSSI value to dBm, based on data from VK4JWT and VK7ZJA
+		return -151 + rssi;// Note no the RSSI value on UHF does not need to be scaled like it does on VHF
+	}
+
+	// VHF
+	// Use fixed point maths to scale the RSSI value to dBm, based on data from VK4JWT and VK7ZJA
+	return -164 + ((rssi * 32) / 27);
+}
+
 
 static void updateScreen(void)
 {
@@ -55,17 +111,7 @@ static void updateScreen(void)
 	int barGraphLength;
 	char buffer[17];
 
-		if (trxCurrentBand[TRX_RX_FREQ_BAND] == RADIO_BAND_UHF)
-		{
-			// Use fixed point maths to scale the RSSI value to dBm, based on data from VK4JWT and VK7ZJA
-			dBm = -151 + trxRxSignal;// Note no the RSSI value on UHF does not need to be scaled like it does on VHF
-		}
-		else
-		{
-			// VHF
-			// Use fixed point maths to scale the RSSI value to dBm, based on data from VK4JWT and VK7ZJA
-			dBm = -164 + ((trxRxSignal * 32) / 27);
-		}
+		dBm = rssiToDbm(trxCurrentBand[TRX_RX_FREQ_BAND], trxRxSignal);
 
 		ucClearBuf();
 		menuDisplayTitle(currentLanguage->rssi);
@@ -95,18 +141,268 @@ static void updateScreen(void)
 }
 
 
+static int bandScopeSpectrumHeight(void)
+{
+	return (((DISPLAY_SIZE_Y / 8) - BAND_SCOPE_WATERFALL_ROWS - BAND_SCOPE_SPECTRUM_START_ROW) * 8);
+}
+
+static int bandScopeColumnFrequency(int column)
+{
+	return bandScopeCentreFrequency + ((column - (BAND_SCOPE_NUM_COLUMNS / 2)) * BAND_SCOPE_STEPS[bandScopeStepIndex]);
+}
+
+static void bandScopeUpdateHeader(void)
+{
+	char buffer[17];
+	int span = (BAND_SCOPE_STEPS[bandScopeStepIndex] * BAND_SCOPE_NUM_COLUMNS) / 100;// kHz
+
+	ucClearRows(0, BAND_SCOPE_SPECTRUM_START_ROW, false);
+	sprintf(buffer, "%d.%04d", bandScopeCentreFrequency / 100000, (bandScopeCentreFrequency % 100000) / 10);
+	ucPrintCore(0, 3, buffer, FONT_SIZE_2, TEXT_ALIGN_LEFT, false);
+	sprintf(buffer, "%dk", span);
+	ucPrintCore(0, 3, buffer, FONT_SIZE_2, TEXT_ALIGN_RIGHT, false);
+	ucDrawFastHLine(0, 13, 128, true);
+	ucSetPixel(64, 14, true);// Centre frequency marker
+	ucRenderRows(0, BAND_SCOPE_SPECTRUM_START_ROW);
+}
+
+static void bandScopeDrawColumn(int column)
+{
+	int height = bandScopeSpectrumHeight();
+	int bottom = (BAND_SCOPE_SPECTRUM_START_ROW * 8) + height;
+	int x = column * BAND_SCOPE_COLUMN_WIDTH;
+
+	ucFillRect(x, BAND_SCOPE_SPECTRUM_START_ROW * 8, BAND_SCOPE_COLUMN_WIDTH, height, true);
+	if (bandScopeLevel[column] > 0)
+	{
+		ucFillRect(x, bottom - bandScopeLevel[column], BAND_SCOPE_COLUMN_WIDTH, bandScopeLevel[column], false);
+	}
+	if (bandScopePeak[column] > bandScopeLevel[column])
+	{
+		ucDrawFastHLine(x, bottom - bandScopePeak[column], BAND_SCOPE_COLUMN_WIDTH, true);
+	}
+	ucRenderColumns(BAND_SCOPE_SPECTRUM_START_ROW, BAND_SCOPE_SPECTRUM_START_ROW + (height / 8), x, x + BAND_SCOPE_COLUMN_WIDTH);
+}
+
+static void bandScopeDrawWaterfall(void)
+{
+	int startRow = (DISPLAY_SIZE_Y / 8) - BAND_SCOPE_WATERFALL_ROWS;
+
+	ucClearRows(startRow, startRow + BAND_SCOPE_WATERFALL_ROWS, false);
+
+	// Newest line at the top
+	for (int line = 0; line < BAND_SCOPE_WATERFALL_LINES; line++)
+	{
+		uint8_t *bits = bandScopeWaterfall[(bandScopeWaterfallHead + BAND_SCOPE_WATERFALL_LINES - line) % BAND_SCOPE_WATERFALL_LINES];
+
+		for (int column = 0; column < BAND_SCOPE_NUM_COLUMNS; column++)
+		{
+			if (bits[column >> 3] & (1 << (column & 0x07)))
+			{
+				ucDrawFastHLine(column * BAND_SCOPE_COLUMN_WIDTH, (startRow * 8) + line, BAND_SCOPE_COLUMN_WIDTH, true);
+			}
+		}
+	}
+	ucRenderRows(startRow, startRow + BAND_SCOPE_WATERFALL_ROWS);
+}
+
+static void bandScopeEndOfSweep(void)
+{
+	int average = 0;
+	uint8_t *bits;
+
+	for (int column = 0; column < BAND_SCOPE_NUM_COLUMNS; column++)
+	{
+		average += bandScopeLevel[column];
+	}
+	average /= BAND_SCOPE_NUM_COLUMNS;
+
+	bandScopeWaterfallHead = (bandScopeWaterfallHead + 1) % BAND_SCOPE_WATERFALL_LINES;
+	bits = bandScopeWaterfall[bandScopeWaterfallHead];
+	memset(bits, 0, BAND_SCOPE_NUM_COLUMNS / 8);
+
+	for (int column = 0; column < BAND_SCOPE_NUM_COLUMNS; column++)
+	{
+		if (bandScopeLevel[column] > (average + 2))
+		{
+			bits[column >> 3] |= (1 << (column & 0x07));
+		}
+
+		// Slow peak hold decay
+		if (bandScopePeak[column] > 0)
+		{
+			bandScopePeak[column]--;
+		}
+	}
+
+	bandScopeDrawWaterfall();
+}
+
+static void bandScopeClear(void)
+{
+	memset(bandScopeLevel, 0, sizeof(bandScopeLevel));
+	memset(bandScopePeak, 0, sizeof(bandScopePeak));
+	memset(bandScopeWaterfall, 0, sizeof(bandScopeWaterfall));
+	bandScopeWaterfallHead = 0;
+	bandScopeColumn = 0;
+	bandScopeTuned = false;
+}
+
+static void bandScopeRestart(void)
+{
+	bandScopeClear();
+	ucClearBuf();
+	bandScopeUpdateHeader();
+	ucRender();
+}
+
+static void bandScopeStart(void)
+{
+	int frequency = trxGetFrequency();
+
+	// The frequency is 0 when the receiver is already fast tuned
+	if (frequency != 0)
+	{
+		bandScopeCentreFrequency = frequency;
+	}
+
+	bandScopeRestart();
+}
+
+static void bandScopeStop(void)
+{
+	trxFastTuneRestore();
+	bandScopeTuned = false;
+}
+
+// Called on each main loop tick. The RSSI of the column tuned on a previous tick is read, then the next column is tuned straight away.
+static void bandScopeTick(void)
+{
+	trxFastTune_t fastTune;
+	int frequency;
+	int band;
+
+	if (trxIsTransmitting)
+	{
+		return;
+	}
+
+	if (bandScopeTuned)
+	{
+		if (bandScopeSettlingTimer > 0)
+		{
+			bandScopeSettlingTimer--;
+			return;
+		}
+
+		trxReadRSSIAndNoise();
+		band = trxGetBandFromFrequency(bandScopeColumnFrequency(bandScopeColumn));
+		int level = ((rssiToDbm(band, trxRxSignal) + 130) * bandScopeSpectrumHeight()) / 80;// -130dBm to -50dBm
+
+		if (level < 0)
+		{
+			level = 0;
+		}
+		else if (level > bandScopeSpectrumHeight())
+		{
+			level = bandScopeSpectrumHeight();
+		}
+
+		bandScopeLevel[bandScopeColumn] = level;
+		if (level > bandScopePeak[bandScopeColumn])
+		{
+			bandScopePeak[bandScopeColumn] = level;
+		}
+		bandScopeDrawColumn(bandScopeColumn);
+		bandScopeTuned = false;
+
+		bandScopeColumn++;
+		if (bandScopeColumn >= BAND_SCOPE_NUM_COLUMNS)
+		{
+			bandScopeColumn = 0;
+			bandScopeEndOfSweep();
+		}
+	}
+
+	frequency = bandScopeColumnFrequency(bandScopeColumn);
+	if (trxGetBandFromFrequency(frequency) == -1)
+	{
+		// Out of the radio bands, nothing to measure
+		bandScopeLevel[bandScopeColumn] = 0;
+		bandScopeDrawColumn(bandScopeColumn);
+
+		bandScopeColumn++;
+		if (bandScopeColumn >= BAND_SCOPE_NUM_COLUMNS)
+		{
+			bandScopeColumn = 0;
+			bandScopeEndOfSweep();
+		}
+		return;
+	}
+
+	trxFastTunePrepare(frequency, 0, &fastTune);
+	trxFastTuneRx(&fastTune);
+	bandScopeSettlingTimer = BAND_SCOPE_SETTLING_TIME;
+	bandScopeTuned = true;
+}
+
 static void handleEvent(uiEvent_t *ev)
 {
 	displayLightTrigger();
 
 	if (KEYCHECK_SHORTUP(ev->keys,KEY_RED))
 	{
+		bandScopeStop();
 		menuSystemPopPreviousMenu();
 		return;
 	}
 	else if (KEYCHECK_SHORTUP(ev->keys,KEY_GREEN))
 	{
+		bandScopeStop();
 		menuSystemPopAllAndDisplayRootMenu();
 		return;
 	}
+	else if (KEYCHECK_SHORTUP(ev->keys,KEY_HASH))
+	{
+		if (rssiScreenMode == RSSI_SCREEN_METER)
+		{
+			rssiScreenMode = RSSI_SCREEN_BAND_SCOPE;
+			bandScopeStart();
+		}
+		else
+		{
+			rssiScreenMode = RSSI_SCREEN_METER;
+			bandScopeStop();
+			updateScreen();
+		}
+		return;
+	}
+
+	if (rssiScreenMode == RSSI_SCREEN_BAND_SCOPE)
+	{
+		if (KEYCHECK_SHORTUP(ev->keys,KEY_UP) && (bandScopeStepIndex < (BAND_SCOPE_NUM_STEPS - 1)))
+		{
+			bandScopeStepIndex++;
+			bandScopeRestart();
+		}
+		else if (KEYCHECK_SHORTUP(ev->keys,KEY_DOWN) && (bandScopeStepIndex > 0))
+		{
+			bandScopeStepIndex--;
+			bandScopeRestart();
+		}
+		else if (KEYCHECK_SHORTUP(ev->keys,KEY_RIGHT))
+		{
+			bandScopeCentreFrequency += (BAND_SCOPE_STEPS[bandScopeStepIndex] * BAND_SCOPE_NUM_COLUMNS) / 4;
+			bandScopeRestart();
+		}
+		else if (KEYCHECK_SHORTUP(ev->keys,KEY_LEFT))
+		{
+			bandScopeCentreFrequency -= (BAND_SCOPE_STEPS[bandScopeStepIndex] * BAND_SCOPE_NUM_COLUMNS) / 4;
+			bandScopeRestart();
+		}
+		else if (KEYCHECK_SHORTUP(ev->keys,KEY_STAR))
+		{
+			memset(bandScopePeak, 0, sizeof(bandScopePeak));// Clear the peak hold
+		}
+	}
 }
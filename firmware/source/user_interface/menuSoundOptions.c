@@ -25,7 +25,7 @@ static void updateScreen(void);
 static void handleEvent(uiEvent_t *ev);
 
 enum SOUND_MENU_LIST { OPTIONS_MENU_TIMEOUT_BEEP = 0, OPTIONS_MENU_BEEP_VOLUME, OPTIONS_MENU_DMR_BEEP,
-						OPTIONS_MIC_GAIN_DMR, OPTIONS_MIC_GAIN_FM, NUM_SOUND_MENU_ITEMS};
+						OPTIONS_MIC_GAIN_DMR, OPTIONS_MIC_GAIN_FM, OPTIONS_CALL_RECORDER, OPTIONS_VOICE_PROMPTS, OPTIONS_RX_AGC, OPTIONS_MIC_COMPRESSOR, NUM_SOUND_MENU_ITEMS};
 
 
 int menuSoundOptions(uiEvent_t *ev, bool isFirstRun)
@@ -88,6 +88,25 @@ static void updateScreen(void)
 			case OPTIONS_MIC_GAIN_FM: // FM Mic gain
 				snprintf(buf, bufferLen, "%s:%d", currentLanguage->fm_mic_gain, (nonVolatileSettings.micGainFM - 16));
 				break;
+			case OPTIONS_CALL_RECORDER: // Record the DMR calls into the Flash
+				snprintf(buf, bufferLen, "%s:%s", currentLanguage->recorder, (nonVolatileSettings.callRecorder ? currentLanguage->on : currentLanguage->off));
+				break;
+			case OPTIONS_VOICE_PROMPTS: // AMBE voice prompts, if they have been loaded into the Flash
+				snprintf(buf, bufferLen, "%s:%s", currentLanguage->voice_prompts, (nonVolatileSettings.voicePrompts ? currentLanguage->on : currentLanguage->off));
+				break;
+			case OPTIONS_RX_AGC: // DMR receive AGC and noise gate
+				snprintf(buf, bufferLen, "%s:%s", currentLanguage->rx_agc, (nonVolatileSettings.rxAGC ? currentLanguage->on : currentLanguage->off));
+				break;
+			case OPTIONS_MIC_COMPRESSOR: // DMR mic compressor profile, shown as its ratio
+				if (nonVolatileSettings.micCompressor != 0)
+				{
+					snprintf(buf, bufferLen, "%s:%d:1", currentLanguage->mic_compressor, (1 << nonVolatileSettings.micCompressor));
+				}
+				else
+				{
+					snprintf(buf, bufferLen, "%s:%s", currentLanguage->mic_compressor, currentLanguage->off);
+				}
+				break;
 		}
 
 		buf[bufferLen - 1] = 0;
@@ -148,6 +167,21 @@ static void handleEvent(uiEvent_t *ev)
 						setMicGainFM(nonVolatileSettings.micGainFM);
 					}
 					break;
+				case OPTIONS_CALL_RECORDER:
+					nonVolatileSettings.callRecorder = 1;
+					break;
+				case OPTIONS_VOICE_PROMPTS:
+					nonVolatileSettings.voicePrompts = 1;
+					break;
+				case OPTIONS_RX_AGC:
+					nonVolatileSettings.rxAGC = 1;
+					break;
+				case OPTIONS_MIC_COMPRESSOR:
+					if (nonVolatileSettings.micCompressor < (MIC_COMPRESSOR_NUM_PROFILES - 1))
+					{
+						nonVolatileSettings.micCompressor++;
+					}
+					break;
 			}
 		}
 		else if (KEYCHECK_PRESS(ev->keys,KEY_LEFT))
@@ -186,6 +220,21 @@ static void handleEvent(uiEvent_t *ev)
 						setMicGainFM(nonVolatileSettings.micGainFM);
 					}
 					break;
+				case OPTIONS_CALL_RECORDER:
+					nonVolatileSettings.callRecorder = 0;
+					break;
+				case OPTIONS_VOICE_PROMPTS:
+					nonVolatileSettings.voicePrompts = 0;
+					break;
+				case OPTIONS_RX_AGC:
+					nonVolatileSettings.rxAGC = 0;
+					break;
+				case OPTIONS_MIC_COMPRESSOR:
+					if (nonVolatileSettings.micCompressor > 0)
+					{
+						nonVolatileSettings.micCompressor--;
+					}
+					break;
 			}
 		}
 		else if (KEYCHECK_SHORTUP(ev->keys,KEY_GREEN))
@@ -70,6 +70,7 @@ const menuItemNew_t * menusData[] = { 	NULL,// splash
 										NULL,// New Contact
 										NULL,// Language
 										NULL,// Private Call
+										NULL,// Message inbox
 								};
 
 const menuFunctionPointer_t menuFunctions[] = { uiSplashScreen,
@@ -101,7 +102,8 @@ const menuFunctionPointer_t menuFunctions[] = { uiSplashScreen,
 												menuContactDetails,
 												menuContactDetails,
 												menuLanguage,
-												menuPrivateCall
+												menuPrivateCall,
+												menuMessageScreen
 };
 
 void menuSystemPushNewMenu(int menuNumber)
@@ -228,13 +230,14 @@ void menuSystemLanguageHasChanged(void)
 }
 
 const menuItemNew_t menuDataMainMenu[] = {
-	{ 12, 12 }, // Special entry: number of menus entries, both member must be set to the same number
+	{ 13, 13 }, // Special entry: number of menus entries, both member must be set to the same number
 	{ 2,  MENU_CREDITS },
 	{ 3,  MENU_ZONE_LIST },
 	{ 4,  MENU_RSSI_SCREEN },
 	{ 5,  MENU_BATTERY },
 	{ 6,  MENU_CONTACTS_MENU },
 	{ 7,  MENU_LAST_HEARD },
+	{ 18, MENU_MESSAGE_INBOX },
 	{ 8,  MENU_FIRMWARE_INFO },
 	{ 9,  MENU_OPTIONS },
 	{ 10, MENU_DISPLAY },
@@ -314,6 +317,114 @@ int menuGetMenuOffset(int maxMenuEntries, int loopOffset)
 	return offset;
 }
 
+// The list entries are displayed below the title, which doesn't need to be redrawn when the list is scrolled
+#if defined(PLATFORM_RD5R)
+static const int MENU_LIST_AREA_Y = 14;
+#else
+static const int MENU_LIST_AREA_Y = 16;
+#endif
+
+void menuClearListArea(void)
+{
+	ucFillRect(0, MENU_LIST_AREA_Y, 128, (DISPLAY_SIZE_Y - MENU_LIST_AREA_Y), true);
+}
+
+void menuRenderListArea(void)
+{
+	ucRenderRows((MENU_LIST_AREA_Y / 8), (DISPLAY_SIZE_Y / 8));
+}
+
+// Cache of the decoded list entries, shared by the list screens.
+// Scrolling then only needs to read the entry which becomes visible, and it's usually
+// already been read by menuListPrefetchTick(), in the scroll direction, while the screen was idle.
+#define MENU_LIST_CACHE_SIZE 8
+
+typedef struct
+{
+	int  key;
+	bool exists;
+	char text[MENU_LIST_CACHE_TEXT_LENGTH];
+} menuListCacheEntry_t;
+
+static menuListCacheEntry_t menuListCache[MENU_LIST_CACHE_SIZE];
+static int menuListCacheNumEntries = 0;
+static int menuListCacheNextSlot = 0;// Entries are replaced in a round robin fashion
+static menuListCacheLoadFunction_t menuListCacheLoadFunction = NULL;
+static int menuListScrollDirection = 1;
+
+void menuListCacheSetLoadFunction(menuListCacheLoadFunction_t loadFunction)
+{
+	if (loadFunction != menuListCacheLoadFunction)
+	{
+		menuListCacheLoadFunction = loadFunction;
+		menuListCacheInvalidate();
+	}
+}
+
+void menuListCacheInvalidate(void)
+{
+	menuListCacheNumEntries = 0;
+	menuListCacheNextSlot = 0;
+	menuListScrollDirection = 1;
+}
+
+static menuListCacheEntry_t *menuListCacheLoad(int key)
+{
+	menuListCacheEntry_t *entry;
+
+	for (int i = 0; i < menuListCacheNumEntries; i++)
+	{
+		if (menuListCache[i].key == key)
+		{
+			return &menuListCache[i];
+		}
+	}
+
+	if (menuListCacheLoadFunction == NULL)
+	{
+		return NULL;
+	}
+
+	entry = &menuListCache[menuListCacheNextSlot];
+	menuListCacheNextSlot = (menuListCacheNextSlot + 1) % MENU_LIST_CACHE_SIZE;
+	if (menuListCacheNumEntries < MENU_LIST_CACHE_SIZE)
+	{
+		menuListCacheNumEntries++;
+	}
+
+	entry->key = key;
+	entry->exists = menuListCacheLoadFunction(key, entry->text);
+	entry->text[MENU_LIST_CACHE_TEXT_LENGTH - 1] = 0;
+
+	return entry;
+}
+
+const char *menuListCacheGetText(int key)
+{
+	menuListCacheEntry_t *entry = menuListCacheLoad(key);
+
+	return (((entry != NULL) && entry->exists) ? entry->text : NULL);
+}
+
+void menuListCachePrefetch(int key)
+{
+	menuListCacheLoad(key);
+}
+
+void menuListSetScrollDirection(int direction)
+{
+	menuListScrollDirection = direction;
+}
+
+// For the lists where the key is the item index: read the entry which will be displayed if the list scrolls once more
+void menuListPrefetchTick(int maxMenuEntries)
+{
+	if (maxMenuEntries > MENU_MAX_DISPLAYED_ENTRIES)
+	{
+		menuListCachePrefetch(menuGetMenuOffset(maxMenuEntries, 2 * menuListScrollDirection));
+	}
+}
+
 /*
  * Returns 99 if key is unknown, or not numerical when digitsOnly is true
  */
@@ -21,8 +21,9 @@
 #include <user_interface/menuSystem.h>
 #include <user_interface/uiLocalisation.h>
 
-static void updateScreen(void);
+static void updateScreen(bool fullRender);
 static void handleEvent(uiEvent_t *ev);
+static bool loadZoneName(int zoneNum, char *text);
 
 int menuZoneList(uiEvent_t *ev, bool isFirstRun)
 {
@@ -30,24 +31,47 @@ int menuZoneList(uiEvent_t *ev, bool isFirstRun)
 	{
 		gMenusEndIndex = codeplugZonesGetCount();
 		gMenusCurrentItemIndex = nonVolatileSettings.currentZone;
-		updateScreen();
+		menuListCacheSetLoadFunction(loadZoneName);
+		menuListCacheInvalidate();
+		updateScreen(true);
 	}
 	else
 	{
 		if (ev->hasEvent)
+		{
 			handleEvent(ev);
+		}
+		else
+		{
+			menuListPrefetchTick(gMenusEndIndex);
+		}
 	}
 	return 0;
 }
 
-static void updateScreen(void)
+static bool loadZoneName(int zoneNum, char *text)
 {
-	char nameBuf[17];
-	int mNum;
 	struct_codeplugZone_t zoneBuf;
 
-	ucClearBuf();
-	menuDisplayTitle(currentLanguage->zones);
+	codeplugZoneGetDataForNumber(zoneNum, &zoneBuf);
+	codeplugUtilConvertBufToString(zoneBuf.name, text, 16);// need to convert to zero terminated string
+
+	return true;
+}
+
+static void updateScreen(bool fullRender)
+{
+	int mNum;
+
+	if (fullRender)
+	{
+		ucClearBuf();
+		menuDisplayTitle(currentLanguage->zones);
+	}
+	else
+	{
+		menuClearListArea();
+	}
 
 	for(int i = -1; i <= 1; i++)
 	{
@@ -58,13 +82,17 @@ static void updateScreen(void)
 
 		mNum = menuGetMenuOffset(gMenusEndIndex, i);
 
-		codeplugZoneGetDataForNumber(mNum, &zoneBuf);
-		codeplugUtilConvertBufToString(zoneBuf.name, nameBuf, 16);// need to convert to zero terminated string
-
-		menuDisplayEntry(i, mNum, (char* )nameBuf);
+		menuDisplayEntry(i, mNum, menuListCacheGetText(mNum));
 	}
 
-	ucRender();
+	if (fullRender)
+	{
+		ucRender();
+	}
+	else
+	{
+		menuRenderListArea();
+	}
 	displayLightTrigger();
 }
 
@@ -75,12 +103,14 @@ static void handleEvent(uiEvent_t *ev)
 	if (KEYCHECK_PRESS(ev->keys,KEY_DOWN))
 	{
 		MENU_INC(gMenusCurrentItemIndex, gMenusEndIndex);
-		updateScreen();
+		menuListSetScrollDirection(1);
+		updateScreen(false);
 	}
 	else if (KEYCHECK_PRESS(ev->keys,KEY_UP))
 	{
 		MENU_DEC(gMenusCurrentItemIndex, gMenusEndIndex);
-		updateScreen();
+		menuListSetScrollDirection(-1);
+		updateScreen(false);
 	}
 	else if (KEYCHECK_SHORTUP(ev->keys,KEY_GREEN))
 	{
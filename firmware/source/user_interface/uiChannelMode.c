@@ -36,12 +36,17 @@ static uint8_t inGD77SSettings;
 static void startScan(void);
 static void handleUpKey(uiEvent_t *ev);
 static void uiChannelUpdateTrxID(void);
+static void announceChannel(void);
 #endif // PLATFORM_GD77S
 
 static void updateQuickMenuScreen(void);
 static void handleQuickMenuEvent(uiEvent_t *ev);
-static void searchNextChannel(void);
+static void scanListBuild(int fromIndex);
+static void scanListSyncPosition(void);
 static void setNextChannel(void);
+static void channelPrefetchInvalidate(void);
+static void channelPrefetchGetData(int channelNumber, struct_codeplugChannel_t *channelBuf);
+static void channelPrefetchTick(void);
 
 static struct_codeplugZone_t currentZone;
 static char currentZoneName[17];
@@ -57,10 +62,40 @@ static bool displayChannelSettings;
 static bool reverseRepeater;
 static int prevDisplayQSODataState;
 
-static struct_codeplugChannel_t channelNextChannelData={.rxFreq=0};
-static bool nextChannelReady = false;
 static int nextChannelIndex = 0;
 
+// Scan list. Each scannable channel is read and decoded once when the scan starts, then only the AT1846S
+// Rx frequency is changed on each step, and the Rx noise is sampled for the dwell time of the channel.
+// Only the channels where a carrier is found get fully loaded (CTCSS, colour code, etc) to qualify the signal.
+#define SCAN_LIST_MAX_ENTRIES 128
+typedef struct
+{
+	trxFastTune_t tune;
+	uint16_t index;// Index in the zone, or channel number in the All Channels zone
+	uint8_t  activity;// Increased each time a carrier is found, decays on each pass
+	uint8_t  dwellTime;
+} scanListEntry_t;
+
+static scanListEntry_t scanList[SCAN_LIST_MAX_ENTRIES];
+static int scanListNumEntries = 0;
+static int scanListPos = 0;
+static bool scanListIsComplete = false;// false when only a window of the All Channels zone is in the list
+static bool scanDwellTuned = false;
+static int scanDwellTimer = 0;
+
+// Ring of the channels next to the current one (in both directions), loaded one per tick while the screen is idle,
+// so that the next channel up/down is read from RAM rather than from the EEPROM or the Flash.
+// It's invalidated each time this screen is entered again, as the channels could have been edited elsewhere.
+#define CHANNEL_PREFETCH_RING_SIZE 4
+typedef struct
+{
+	int channelNumber;// 0 when the slot is unused
+	struct_codeplugChannel_t channel;
+} channelPrefetchEntry_t;
+
+static channelPrefetchEntry_t channelPrefetchRing[CHANNEL_PREFETCH_RING_SIZE];
+static int channelPrefetchCompleteForChannel = 0;// Channel number for which all the neighbours are in the ring
+
 #if defined(PLATFORM_RD5R)
 static const int  CH_NAME_Y_POS = 40;
 static const int  XBAR_Y_POS = 15;
@@ -81,7 +116,7 @@ int uiChannelMode(uiEvent_t *ev, bool isFirstRun)
 		nonVolatileSettings.initialMenuNumber = UI_CHANNEL_MODE;// This menu.
 		displayChannelSettings = false;
 		reverseRepeater = false;
-		nextChannelReady = false;
+		scanDwellTuned = false;
 
 		// We're in digital mode, RXing, and current talker is already at the top of last heard list,
 		// hence immediately display complete contact/TG info on screen
@@ -91,6 +126,7 @@ int uiChannelMode(uiEvent_t *ev, bool isFirstRun)
 		lastHeardClearLastID();
 		prevDisplayQSODataState = QSO_DISPLAY_IDLE;
 		currentChannelData = &channelScreenChannelData;// Need to set this as currentChannelData is used by functions called by loadChannelData()
+		channelPrefetchInvalidate();
 
 		if (channelScreenChannelData.rxFreq != 0)
 		{
@@ -188,6 +224,11 @@ int uiChannelMode(uiEvent_t *ev, bool isFirstRun)
 			{
 				scanning();
 			}
+
+			if ((scanActive == false) || (scanState != SCAN_SCANNING))
+			{
+				channelPrefetchTick();
+			}
 		}
 		else
 		{
@@ -213,78 +254,183 @@ uint16_t byteSwap16(uint16_t in)
 }
 #endif
 
-static void searchNextChannel(void) {
-	//bool allZones = strcmp(currentZoneName,currentLanguage->all_channels) == 0;
-	int channel = 0;
-	if (currentZone.NOT_IN_MEMORY_isAllChannelsZone)
+static int scanListChannelNumber(int index)
+{
+	return (currentZone.NOT_IN_MEMORY_isAllChannelsZone ? index : currentZone.channels[index]);
+}
+
+static bool scanChannelIsNuisance(int channel)
+{
+	for(int i=0;i<MAX_ZONE_SCAN_NUISANCE_CHANNELS;i++)														//check all nuisance delete entries and skip channel if there is a match
 	{
-		do {
-			nextChannelIndex += scanDirection;
-			if (scanDirection == 1)
-			{
-				if (nextChannelIndex>1024)
-				{
-					nextChannelIndex = 1;
-				}
-			}
-			else
+		if (nuisanceDelete[i] == -1)
+		{
+			break;
+		}
+		else
+		{
+			if(nuisanceDelete[i] == channel)
 			{
-				// Note this is inefficient check all the index down from 1024 until it gets to the first valid index from the end.
-				// To improve this. Highest valid channel number would need to be found and cached when the radio boots up
-				if (nextChannelIndex < 1)
-				{
-					nextChannelIndex = 1024;
-				}
+				return true;
 			}
-		} while(!codeplugChannelIndexIsValid(nextChannelIndex));
-		channel = nextChannelIndex;
-		codeplugChannelGetDataForIndex(nextChannelIndex,&channelNextChannelData);
+		}
+	}
+
+	return false;
+}
+
+static void scanListAddEntry(int index)
+{
+	struct_codeplugChannel_t channelBuf;
+	scanListEntry_t *entry = &scanList[scanListNumEntries];
+	int channel = scanListChannelNumber(index);
+
+	codeplugChannelGetDataForIndex(channel, &channelBuf);
+
+	if ((currentZone.NOT_IN_MEMORY_isAllChannelsZone && (channelBuf.flag4 & 0x10)) ||
+			(!currentZone.NOT_IN_MEMORY_isAllChannelsZone && (channelBuf.flag4 & 0x20)) ||
+			scanChannelIsNuisance(channel))
+	{
+		return;
+	}
+
+	// Only use the channel squelch level in FM, DMR always uses the band default (see trxCheckDigitalSquelch())
+	trxFastTunePrepare(channelBuf.rxFreq, ((channelBuf.chMode == RADIO_MODE_ANALOG) ? channelBuf.sql : 0), &entry->tune);
+	entry->index = index;
+	entry->activity = 0;
+
+	if ((channelBuf.chMode == RADIO_MODE_DIGITAL) && (channelBuf.rxFreq == channelBuf.txFreq))
+	{
+		entry->dwellTime = SCAN_DMR_SIMPLEX_MIN_INTERVAL;//allow extra time if scanning a simplex DMR channel (needs to catch the TDMA pulsing)
 	}
 	else
 	{
-		nextChannelIndex += scanDirection;
-		if (scanDirection == 1)
+		entry->dwellTime = SCAN_FAST_DWELL_TIME;
+	}
+
+	scanListNumEntries++;
+}
+
+// Build the scan list, starting from the specified index.
+// In the All Channels zone, only a window of SCAN_LIST_MAX_ENTRIES channels is built, in the scan direction.
+static void scanListBuild(int fromIndex)
+{
+	scanListNumEntries = 0;
+	scanListPos = 0;
+
+	if (currentZone.NOT_IN_MEMORY_isAllChannelsZone)
+	{
+		int rangeStart = ((scanDirection == 1) ? 1 : 1024);
+		int index = fromIndex;
+
+		while ((index >= 1) && (index <= 1024) && (scanListNumEntries < SCAN_LIST_MAX_ENTRIES))
 		{
-			if (nextChannelIndex > currentZone.NOT_IN_MEMORY_numChannelsInZone - 1)
+			if (codeplugChannelIndexIsValid(index))
 			{
-				nextChannelIndex = 0;
+				scanListAddEntry(index);
 			}
+			index += scanDirection;
 		}
-		else
+
+		// The whole channel range fits in the list
+		scanListIsComplete = ((fromIndex == rangeStart) && ((index < 1) || (index > 1024)));
+
+		if ((scanListNumEntries == 0) && (fromIndex != rangeStart))
+		{
+			// Nothing left until the end of the channel range, wrap around
+			scanListBuild(rangeStart);
+			return;
+		}
+
+		if (scanDirection == -1)
 		{
-			if (nextChannelIndex < 0)
+			// The list is always kept in ascending channel order
+			for (int i = 0, j = scanListNumEntries - 1; i < j; i++, j--)
 			{
-				nextChannelIndex = currentZone.NOT_IN_MEMORY_numChannelsInZone - 1;
+				scanListEntry_t tmp = scanList[i];
+
+				scanList[i] = scanList[j];
+				scanList[j] = tmp;
 			}
 		}
-		codeplugChannelGetDataForIndex(currentZone.channels[nextChannelIndex],&channelNextChannelData);
-		channel = currentZone.channels[nextChannelIndex];
 	}
+	else
+	{
+		for (int i = 0; (i < currentZone.NOT_IN_MEMORY_numChannelsInZone) && (scanListNumEntries < SCAN_LIST_MAX_ENTRIES); i++)
+		{
+			scanListAddEntry(i);
+		}
+		scanListIsComplete = true;
+	}
+}
+
+// Select the list entry that follows the current channel, in the scan direction
+static void scanListSyncPosition(void)
+{
+	int current = (currentZone.NOT_IN_MEMORY_isAllChannelsZone ? nonVolatileSettings.currentChannelIndexInAllZone : nonVolatileSettings.currentChannelIndexInZone);
 
-	if ((currentZone.NOT_IN_MEMORY_isAllChannelsZone && (channelNextChannelData.flag4 & 0x10)) ||
-			(!currentZone.NOT_IN_MEMORY_isAllChannelsZone && (channelNextChannelData.flag4 & 0x20)))
+	if (scanListNumEntries == 0)
 	{
 		return;
 	}
-	else
+
+	if (scanDirection == 1)
 	{
-		for(int i=0;i<MAX_ZONE_SCAN_NUISANCE_CHANNELS;i++)														//check all nuisance delete entries and skip channel if there is a match
+		scanListPos = 0;
+		for (int i = 0; i < scanListNumEntries; i++)
 		{
-			if (nuisanceDelete[i] == -1)
+			if (scanList[i].index > current)
 			{
-				break;
+				scanListPos = i;
+				return;
 			}
-			else
+		}
+	}
+	else
+	{
+		scanListPos = scanListNumEntries - 1;
+		for (int i = scanListNumEntries - 1; i >= 0; i--)
+		{
+			if (scanList[i].index < current)
 			{
-				if(nuisanceDelete[i] == channel)
-				{
-					return;
-				}
+				scanListPos = i;
+				return;
 			}
 		}
 	}
 
-	nextChannelReady = true;
+	// Past the end of the list
+	if (!scanListIsComplete)
+	{
+		scanListBuild(current + scanDirection);
+		scanListPos = ((scanDirection == 1) ? 0 : (scanListNumEntries - 1));
+	}
+}
+
+static void scanListAdvance(void)
+{
+	scanListPos += scanDirection;
+
+	if ((scanListPos >= 0) && (scanListPos < scanListNumEntries))
+	{
+		return;
+	}
+
+	if (scanListIsComplete)
+	{
+		// One full pass done, let the activity of the channels decay
+		for (int i = 0; i < scanListNumEntries; i++)
+		{
+			scanList[i].activity -= (scanList[i].activity >> 2) + (scanList[i].activity ? 1 : 0);
+		}
+		scanListPos = ((scanDirection == 1) ? 0 : (scanListNumEntries - 1));
+	}
+	else
+	{
+		// Only a window of the All Channels zone is loaded, load the next one
+		scanListBuild(scanList[((scanDirection == 1) ? (scanListNumEntries - 1) : 0)].index + scanDirection);
+		scanListPos = ((scanDirection == 1) ? 0 : (scanListNumEntries - 1));
+	}
 }
 
 static void setNextChannel(void)
@@ -303,10 +449,6 @@ static void setNextChannel(void)
 	loadChannelData(false);
 	menuDisplayQSODataState = QSO_DISPLAY_DEFAULT_SCREEN;
 	uiChannelModeUpdateScreen(0);
-
-	nextChannelReady = false;
-	scanTimer = 500;
-	scanState = SCAN_SCANNING;
 }
 
 static void loadChannelData(bool useChannelDataInMemory)
@@ -322,14 +464,7 @@ static void loadChannelData(bool useChannelDataInMemory)
 
 	if (!useChannelDataInMemory)
 	{
-		if (currentZone.NOT_IN_MEMORY_isAllChannelsZone)
-		{
-			codeplugChannelGetDataForIndex(nonVolatileSettings.currentChannelIndexInAllZone, &channelScreenChannelData);
-		}
-		else
-		{
-			codeplugChannelGetDataForIndex(currentZone.channels[nonVolatileSettings.currentChannelIndexInZone], &channelScreenChannelData);
-		}
+		channelPrefetchGetData(settingsCurrentChannelNumber, &channelScreenChannelData);
 	}
 
 	trxSetFrequency(channelScreenChannelData.rxFreq, channelScreenChannelData.txFreq, DMR_MODE_AUTO);
@@ -391,6 +526,111 @@ static void loadChannelData(bool useChannelDataInMemory)
 	}
 }
 
+static void channelPrefetchInvalidate(void)
+{
+	for (int i = 0; i < CHANNEL_PREFETCH_RING_SIZE; i++)
+	{
+		channelPrefetchRing[i].channelNumber = 0;
+	}
+	channelPrefetchCompleteForChannel = 0;
+}
+
+static void channelPrefetchGetData(int channelNumber, struct_codeplugChannel_t *channelBuf)
+{
+	for (int i = 0; i < CHANNEL_PREFETCH_RING_SIZE; i++)
+	{
+		if (channelPrefetchRing[i].channelNumber == channelNumber)
+		{
+			memcpy(channelBuf, &channelPrefetchRing[i].channel, sizeof(struct_codeplugChannel_t));
+			return;
+		}
+	}
+
+	codeplugChannelGetDataForIndex(channelNumber, channelBuf);
+}
+
+// Returns the channel number which is 'steps' channels away from the current one, in the same way as the Up/Down keys
+static int channelPrefetchNeighbour(int steps)
+{
+	int direction = ((steps > 0) ? 1 : -1);
+
+	if (currentZone.NOT_IN_MEMORY_isAllChannelsZone)
+	{
+		int channelNumber = nonVolatileSettings.currentChannelIndexInAllZone;
+
+		while ((steps != 0) && (channelNumber != 0))
+		{
+			channelNumber = codeplugChannelGetNextValidIndex(channelNumber, direction);
+			steps -= direction;
+		}
+
+		return channelNumber;
+	}
+
+	if (currentZone.NOT_IN_MEMORY_numChannelsInZone == 0)
+	{
+		return 0;
+	}
+
+	int index = (nonVolatileSettings.currentChannelIndexInZone + steps) % currentZone.NOT_IN_MEMORY_numChannelsInZone;
+	if (index < 0)
+	{
+		index += currentZone.NOT_IN_MEMORY_numChannelsInZone;
+	}
+
+	return currentZone.channels[index];
+}
+
+static void channelPrefetchTick(void)
+{
+	static const int PREFETCH_STEPS[CHANNEL_PREFETCH_RING_SIZE] = { 1, -1, 2, -2 };
+	int targets[CHANNEL_PREFETCH_RING_SIZE];
+
+	if (channelPrefetchCompleteForChannel == settingsCurrentChannelNumber)
+	{
+		return;
+	}
+
+	for (int i = 0; i < CHANNEL_PREFETCH_RING_SIZE; i++)
+	{
+		targets[i] = channelPrefetchNeighbour(PREFETCH_STEPS[i]);
+	}
+
+	// Load the first missing channel, only one per tick
+	for (int i = 0; i < CHANNEL_PREFETCH_RING_SIZE; i++)
+	{
+		bool found = (targets[i] == 0);
+
+		for (int j = 0; (j < CHANNEL_PREFETCH_RING_SIZE) && !found; j++)
+		{
+			found = (channelPrefetchRing[j].channelNumber == targets[i]);
+		}
+
+		if (!found)
+		{
+			// Replace a slot which doesn't contain one of the channels we want. There is always one, as a target is missing.
+			for (int j = 0; j < CHANNEL_PREFETCH_RING_SIZE; j++)
+			{
+				bool isTarget = false;
+
+				for (int k = 0; (k < CHANNEL_PREFETCH_RING_SIZE) && !isTarget; k++)
+				{
+					isTarget = (channelPrefetchRing[j].channelNumber == targets[k]);
+				}
+
+				if (!isTarget)
+				{
+					codeplugChannelGetDataForIndex(targets[i], &channelPrefetchRing[j].channel);
+					channelPrefetchRing[j].channelNumber = targets[i];
+					return;
+				}
+			}
+		}
+	}
+
+	channelPrefetchCompleteForChannel = settingsCurrentChannelNumber;
+}
+
 void uiChannelModeUpdateScreen(int txTimeSecs)
 {
 	int channelNumber;
@@ -1227,6 +1467,7 @@ static void handleEvent(uiEvent_t *ev)
 				directChannelNumber = 0;
 				menuDisplayQSODataState = QSO_DISPLAY_DEFAULT_SCREEN;
 				uiChannelModeUpdateScreen(0);
+				announceChannel();
 			}
 			else if (ev->buttons & BUTTON_SK2 )
 			{
@@ -1519,14 +1760,11 @@ static void handleEvent(uiEvent_t *ev)
 				lastHeardClearLastID();
 				if (currentZone.NOT_IN_MEMORY_isAllChannelsZone)
 				{
-					do
+					int prevChannel = codeplugChannelGetNextValidIndex(nonVolatileSettings.currentChannelIndexInAllZone, -1);
+					if (prevChannel != 0)
 					{
-						nonVolatileSettings.currentChannelIndexInAllZone--;
-						if (nonVolatileSettings.currentChannelIndexInAllZone<1)
-						{
-							nonVolatileSettings.currentChannelIndexInAllZone = 1024;
-						}
-					} while(!codeplugChannelIndexIsValid(nonVolatileSettings.currentChannelIndexInAllZone));
+						nonVolatileSettings.currentChannelIndexInAllZone = prevChannel;
+					}
 				}
 				else
 				{
@@ -1540,6 +1778,7 @@ static void handleEvent(uiEvent_t *ev)
 			loadChannelData(false);
 			menuDisplayQSODataState = QSO_DISPLAY_DEFAULT_SCREEN;
 			uiChannelModeUpdateScreen(0);
+			announceChannel();
 			SETTINGS_PLATFORM_SPECIFIC_SAVE_SETTINGS(false);
 		}
 		else if (KEYCHECK_LONGDOWN(ev->keys, KEY_UP))
@@ -1606,14 +1845,11 @@ static void handleUpKey(uiEvent_t *ev)
 		lastHeardClearLastID();
 		if (currentZone.NOT_IN_MEMORY_isAllChannelsZone)
 		{
-			do
+			int nextChannel = codeplugChannelGetNextValidIndex(nonVolatileSettings.currentChannelIndexInAllZone, 1);
+			if (nextChannel != 0)
 			{
-				nonVolatileSettings.currentChannelIndexInAllZone++;
-				if (nonVolatileSettings.currentChannelIndexInAllZone > 1024)
-				{
-					nonVolatileSettings.currentChannelIndexInAllZone = 1;
-				}
-			} while(!codeplugChannelIndexIsValid(nonVolatileSettings.currentChannelIndexInAllZone));
+				nonVolatileSettings.currentChannelIndexInAllZone = nextChannel;
+			}
 		}
 		else
 		{
@@ -1624,13 +1860,32 @@ static void handleUpKey(uiEvent_t *ev)
 
 			}
 		}
-		scanTimer=500;
-		scanState = SCAN_SCANNING;
+		// Listen to the manually selected channel for a moment, then carry on scanning from there
+		scanTimer = 500;
+		scanState = SCAN_SHORT_PAUSED;
+		scanDwellTuned = false;
+		scanListSyncPosition();
 	}
 
 	loadChannelData(false);
 	menuDisplayQSODataState = QSO_DISPLAY_DEFAULT_SCREEN;
 	uiChannelModeUpdateScreen(0);
+	announceChannel();
+}
+
+// Speak the channel number, when the voice prompts are turned on
+static void announceChannel(void)
+{
+	uint8_t buf[SPEECH_SYNTHESIS_BUFFER_SIZE];
+	int channelNumber = (currentZone.NOT_IN_MEMORY_isAllChannelsZone ? nonVolatileSettings.currentChannelIndexInAllZone :
+							(nonVolatileSettings.currentChannelIndexInZone + 1));
+
+	buf[0U] = 1U;
+	buf[1U] = SPEECH_SYNTHESIS_CHANNEL;
+	// Numbers above 999 can only be spoken digit by digit
+	buf[0U] += speechSynthesisBuildNumerical(&buf[2U], SPEECH_SYNTHESIS_BUFFER_SIZE - 2U, channelNumber, 1, (channelNumber > 999));
+
+	speechSynthesisSpeak(buf);
 }
 #endif // ! PLATFORM_GD77S
 
@@ -1711,7 +1966,9 @@ static void handleQuickMenuEvent(uiEvent_t *ev)
 				if (trxGetMode() == RADIO_MODE_DIGITAL)
 				{
 					nonVolatileSettings.dmrFilterLevel = tmpQuickMenuDmrFilterLevel;
+					lock_SPI_bus();
 					init_digital_DMR_RX();
+					unlock_SPI_bus();
 					disableAudioAmp(AUDIO_AMP_MODE_RF);
 				}
 				else
@@ -1807,9 +2064,6 @@ static void startScan(void)
 	}
 	nuisanceDeleteIndex=0;
 
-	scanActive = true;
-	scanTimer = SCAN_SHORT_PAUSE_TIME;
-	scanState = SCAN_SCANNING;
 	menuSystemPopAllAndDisplaySpecificRootMenu(UI_CHANNEL_MODE);
 
 	//get current channel index
@@ -1819,10 +2073,16 @@ static void startScan(void)
 	}
 	else
 	{
-		nextChannelIndex = currentZone.channels[nonVolatileSettings.currentChannelIndexInZone];
+		nextChannelIndex = nonVolatileSettings.currentChannelIndexInZone;
 	}
-	nextChannelReady = false;
 
+	scanListBuild(nextChannelIndex);
+	scanListSyncPosition();
+
+	scanActive = true;
+	scanDwellTuned = false;
+	scanTimer = SCAN_SHORT_PAUSE_TIME;
+	scanState = SCAN_SHORT_PAUSED;// Listen to the current channel first
 }
 
 static void uiChannelUpdateTrxID(void)
@@ -1854,31 +2114,50 @@ static void uiChannelUpdateTrxID(void)
 
 static void scanning(void)
 {
-	if((scanState == SCAN_SCANNING) && (scanTimer > SCAN_SKIP_CHANNEL_INTERVAL) && (scanTimer < ( SCAN_TOTAL_INTERVAL - SCAN_FREQ_CHANGE_SETTLING_INTERVAL)))							    			//after initial settling time
+	scanListEntry_t *entry;
+
+	if (scanState == SCAN_SCANNING)
 	{
-		//test for presence of RF Carrier.
-		// In FM mode the dmr slot_state will always be DMR_STATE_IDLE
-		if (slot_state != DMR_STATE_IDLE)
+		if (scanListNumEntries == 0)
 		{
-			if (nonVolatileSettings.scanModePause == SCAN_MODE_STOP)
+			return;
+		}
+
+		entry = &scanList[scanListPos];
+
+		// Only the AT1846S is retuned while looking for a carrier, the channel is fully loaded once something is heard.
+		if (!scanDwellTuned)
+		{
+			// Channel added to the nuisance list after the scan list was built
+			if (scanChannelIsNuisance(scanListChannelNumber(entry->index)))
 			{
-				scanActive = false;
-				// Just update the header (to prevent hidden mode)
-				ucClearRows(0,  2, false);
-				menuUtilityRenderHeader();
-				ucRenderRows(0,  2);
+				scanListAdvance();
 				return;
 			}
-			else
-			{
-				scanState = SCAN_PAUSED;
-				scanTimer = nonVolatileSettings.scanDelay * 1000;
-			}
+
+			trxFastTuneRx(&entry->tune);
+			trx_measure_count = 0;
+			scanDwellTuned = true;
+			scanDwellTimer = 0;
+			return;
 		}
-		else
+
+		scanDwellTimer++;
+
+		if (scanDwellTimer > SCAN_FAST_SETTLING_TIME)
 		{
-			if(trxCarrierDetected())
+			//test for presence of RF Carrier.
+			// In FM mode the dmr slot_state will always be DMR_STATE_IDLE
+			if ((slot_state != DMR_STATE_IDLE) || trxFastTuneCarrierDetected(&entry->tune))
 			{
+				entry->activity = ((entry->activity > (255 - 32)) ? 255 : (entry->activity + 32));
+
+				nextChannelIndex = entry->index;
+				setNextChannel();
+				scanDwellTuned = false;
+				trx_measure_count = 0;
+				scanListAdvance();
+
 				if (nonVolatileSettings.scanModePause == SCAN_MODE_STOP)
 				{
 					scanActive = false;
@@ -1888,57 +2167,50 @@ static void scanning(void)
 					ucRenderRows(0,  2);
 					return;
 				}
-				else
-				{
-					scanTimer = SCAN_SHORT_PAUSE_TIME;	//start short delay to allow full detection of signal
-					scanState = SCAN_SHORT_PAUSED;		//state 1 = pause and test for valid signal that produces audio
-				}
+
+				scanTimer = SCAN_SHORT_PAUSE_TIME;	//start short delay to allow full detection of signal
+				scanState = SCAN_SHORT_PAUSED;		//state 1 = pause and test for valid signal that produces audio
+				return;
 			}
 		}
+
+		// Channels which were recently active get a slightly longer dwell time
+		if (scanDwellTimer >= (entry->dwellTime + (entry->activity >> 3)))
+		{
+			scanListAdvance();
+			scanDwellTuned = false;
+		}
+		return;
 	}
 
 	if(((scanState == SCAN_PAUSED) && (nonVolatileSettings.scanModePause == SCAN_MODE_HOLD)) || (scanState == SCAN_SHORT_PAUSED))   // only do this once if scan mode is PAUSE do it every time if scan mode is HOLD
 	{
-	    //if (GPIO_PinRead(GPIO_audio_amp_enable, Pin_audio_amp_enable) == 1)	    	// if speaker on we must be receiving a signal so extend the time before resuming scan.
-	    if (getAudioAmpStatus() & AUDIO_AMP_MODE_RF)
+	    if ((getAudioAmpStatus() & AUDIO_AMP_MODE_RF) || (slot_state != DMR_STATE_IDLE))
 	    {
 	    	scanTimer = nonVolatileSettings.scanDelay * 1000;
 	    	scanState = SCAN_PAUSED;
 	    }
 	}
 
-	if (!nextChannelReady)
-	{
-		searchNextChannel();
-	}
-
 	if(scanTimer > 0)
 	{
 		scanTimer--;
 	}
 	else
 	{
-		if (nextChannelReady)
-		{
-			setNextChannel();
-			trx_measure_count = 0;
-
-			if ((trxGetMode() == RADIO_MODE_DIGITAL) && (trxDMRMode == DMR_MODE_ACTIVE) && (SCAN_TOTAL_INTERVAL < SCAN_DMR_SIMPLEX_MIN_INTERVAL) )				//allow extra time if scanning a simplex DMR channel.
-			{
-				scanTimer = SCAN_DMR_SIMPLEX_MIN_INTERVAL;
-			}
-			else
-			{
-				scanTimer = SCAN_TOTAL_INTERVAL;
-			}
-		}
-
-		scanState = SCAN_SCANNING;													//state 0 = settling and test for carrier present.
+		scanDwellTuned = false;
+		scanState = SCAN_SCANNING;													//state 0 = dwell and test for carrier present.
 	}
 }
 
 void uiChannelModeStopScanning(void)
 {
+	if (scanDwellTuned)
+	{
+		// The receiver is still tuned on a scanned channel, go back to the current one
+		trxSetFrequency(channelScreenChannelData.rxFreq, channelScreenChannelData.txFreq, DMR_MODE_AUTO);
+		scanDwellTuned = false;
+	}
 	scanActive = false;
 }
 
@@ -16,6 +16,7 @@
  * Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
  */
 
+#include <ambeRecorder.h>
 #include <EEPROM.h>
 #include <user_interface/menuSystem.h>
 #include <user_interface/uiUtilities.h>
@@ -35,10 +36,14 @@ const int QSO_TIMER_TIMEOUT = 2400;
 const int TX_TIMER_Y_OFFSET = 12;
 const int CONTACT_Y_POS = 12;
 static const int BAR_Y_POS = 8;
+static const int RSSI_BAR_HEIGHT = 2;// Thinner than on the other radios, to leave room for the BER bar below it
+static const int BER_BAR_Y_POS = 11;
 #else
 const int TX_TIMER_Y_OFFSET = 8;
 const int CONTACT_Y_POS = 16;
 static const int BAR_Y_POS = 10;
+static const int RSSI_BAR_HEIGHT = 4;
+static const int BER_BAR_Y_POS = 15;
 #endif
 
 const int FREQUENCY_X_POS = /* '>Ta'*/ (3 * 8) + 4;
@@ -48,7 +53,39 @@ static const int DMRID_MEMORY_STORAGE_START = 0x30000;
 static const int DMRID_HEADER_LENGTH = 0x0C;
 __attribute__((section(".data.$RAM2"))) LinkItem_t callsList[NUM_LASTHEARD_STORED];
 LinkItem_t *LinkHead = callsList;
+static LinkItem_t *LinkTail = &callsList[NUM_LASTHEARD_STORED - 1];
 int numLastHeard=0;
+
+// Open addressed (linear probing) index over callsList[], keyed by DMR ID.
+// Slots hold the index of the item in callsList[], or LASTHEARD_HASH_EMPTY.
+#define LASTHEARD_HASH_BITS		6
+#define LASTHEARD_HASH_SIZE		(1 << LASTHEARD_HASH_BITS)// Must be at least twice NUM_LASTHEARD_STORED
+#define LASTHEARD_HASH_MASK		(LASTHEARD_HASH_SIZE - 1)
+#define LASTHEARD_HASH_EMPTY	0xFF
+static uint8_t lastHeardHashTable[LASTHEARD_HASH_SIZE];
+static void updateLHItem(LinkItem_t *item);
+static void drawBERBarGraph(void);
+
+// Persistent last heard log, stored in the external Flash as a ring of append-only records.
+// Records are only ever programmed into erased (0xFF) space, a sector is erased when the write position enters it.
+static const uint32_t LASTHEARD_LOG_FLASH_START = 0x90000;
+static const uint32_t LASTHEARD_LOG_FLASH_SIZE  = (4 * 4096);
+#define LASTHEARD_LOG_NUM_PENDING 4
+
+typedef struct
+{
+	uint32_t sequence;// 0xFFFFFFFF means erased / unused record
+	uint32_t id;
+	uint32_t talkGroupOrPcId;
+	char     locator[8];
+	char     talkerAlias[32];
+	uint8_t  reserved[12];
+} lastHeardLogRecord_t;// 64 bytes, so records never straddle a Flash page
+
+static uint32_t lastHeardLogWritePos = 0;// Offset of the next free record, relative to LASTHEARD_LOG_FLASH_START
+static uint32_t lastHeardLogSequence = 0;
+static lastHeardLogRecord_t lastHeardLogPending[LASTHEARD_LOG_NUM_PENDING];
+static int lastHeardLogNumPending = 0;
 int menuDisplayQSODataState = QSO_DISPLAY_DEFAULT_SCREEN;
 int qsodata_timer;
 const uint32_t RSSI_UPDATE_COUNTER_RELOAD = 100;
@@ -85,6 +122,8 @@ const int SCAN_TOTAL_INTERVAL = 30;			    //time between each scan step
 const int SCAN_DMR_SIMPLEX_MIN_INTERVAL=60;		//minimum time between steps when scanning DMR Simplex. (needs extra time to capture TDMA Pulsing)
 const int SCAN_FREQ_CHANGE_SETTLING_INTERVAL = 1;//Time after frequency is changed before RSSI sampling starts
 const int SCAN_SKIP_CHANNEL_INTERVAL = 1;		//This is actually just an implicit flag value to indicate the channel should be skipped
+const int SCAN_FAST_DWELL_TIME = 8;				//time the Rx noise is sampled on each channel before stepping to the next one
+const int SCAN_FAST_SETTLING_TIME = 3;			//time after the Rx frequency is changed before the Rx noise is sampled
 
 
 bool isQSODataAvailableForCurrentTalker(void)
@@ -150,9 +189,206 @@ int32_t getFirstSpacePos(char *str)
 	return -1;
 }
 
+static inline uint32_t lastheardHashSlot(uint32_t id)
+{
+	return ((id * 2654435761U) >> (32 - LASTHEARD_HASH_BITS));
+}
+
+static void lastheardHashInsert(LinkItem_t *item)
+{
+	uint32_t slot = lastheardHashSlot(item->id);
+
+	while (lastHeardHashTable[slot] != LASTHEARD_HASH_EMPTY)
+	{
+		slot = (slot + 1) & LASTHEARD_HASH_MASK;
+	}
+
+	lastHeardHashTable[slot] = (uint8_t)(item - callsList);
+}
+
+// Removal uses backward shift deletion, hence no tombstones are needed and probe sequences stay short.
+static void lastheardHashRemove(LinkItem_t *item)
+{
+	uint8_t itemIndex = (uint8_t)(item - callsList);
+	uint32_t slot = lastheardHashSlot(item->id);
+	uint32_t next;
+
+	while (lastHeardHashTable[slot] != itemIndex)
+	{
+		if (lastHeardHashTable[slot] == LASTHEARD_HASH_EMPTY)
+		{
+			return;// Not indexed
+		}
+		slot = (slot + 1) & LASTHEARD_HASH_MASK;
+	}
+
+	next = (slot + 1) & LASTHEARD_HASH_MASK;
+	while (lastHeardHashTable[next] != LASTHEARD_HASH_EMPTY)
+	{
+		uint32_t home = lastheardHashSlot(callsList[lastHeardHashTable[next]].id);
+
+		// Move the entry back into the hole, if its home slot is not between the hole and its current slot
+		if (((next - home) & LASTHEARD_HASH_MASK) >= ((next - slot) & LASTHEARD_HASH_MASK))
+		{
+			lastHeardHashTable[slot] = lastHeardHashTable[next];
+			slot = next;
+		}
+		next = (next + 1) & LASTHEARD_HASH_MASK;
+	}
+
+	lastHeardHashTable[slot] = LASTHEARD_HASH_EMPTY;
+}
+
+// Move an item which is already in the list to the top of the list
+static void lastheardMoveToHead(LinkItem_t *item)
+{
+	if (item == LinkHead)
+	{
+		return;
+	}
+
+	// set the previous item to skip this item and link to 'items' next item.
+	item->prev->next = item->next;
+
+	if (item->next != NULL)
+	{
+		// not the last in the list
+		item->next->prev = item->prev;// backwards link the next item to the item before us in the list.
+	}
+	else
+	{
+		LinkTail = item->prev;
+	}
+
+	item->next = LinkHead;// link our next item to the item at the head of the list
+	LinkHead->prev = item;// backwards link the hold head item to the item moving to the top of the list.
+	item->prev = NULL;// change the items prev to NULL now we are at the top of the list
+	LinkHead = item;// Change the global for the head of the link to the item that is to be at the top of the list.
+}
+
+static void lastheardLogQueueItem(LinkItem_t *item)
+{
+	lastHeardLogRecord_t *rec;
+
+	if (item->id == 0)
+	{
+		return;
+	}
+
+	if (lastHeardLogNumPending == LASTHEARD_LOG_NUM_PENDING)
+	{
+		// Queue is full, drop the oldest pending record
+		memmove(&lastHeardLogPending[0], &lastHeardLogPending[1], sizeof(lastHeardLogRecord_t) * (LASTHEARD_LOG_NUM_PENDING - 1));
+		lastHeardLogNumPending--;
+	}
+
+	rec = &lastHeardLogPending[lastHeardLogNumPending++];
+	memset(rec, 0xFF, sizeof(lastHeardLogRecord_t));
+	rec->id = item->id;
+	rec->talkGroupOrPcId = item->talkGroupOrPcId;
+	memcpy(rec->locator, item->locator, sizeof(item->locator));
+	memcpy(rec->talkerAlias, item->talkerAlias, sizeof(rec->talkerAlias));
+}
+
+static bool lastheardLogWriteRecord(lastHeardLogRecord_t *rec)
+{
+	uint32_t address = LASTHEARD_LOG_FLASH_START + lastHeardLogWritePos;
+
+	// Entering a new sector, it needs to be erased first (this discards the oldest records)
+	if ((lastHeardLogWritePos % 4096) == 0)
+	{
+		if (SPI_Flash_eraseSector(address) == false)
+		{
+			return false;
+		}
+	}
+
+	rec->sequence = lastHeardLogSequence;
+
+	// Program the whole page with 0xFF everywhere except the record, so the other records of the page are left untouched
+	memset(SPI_Flash_sectorbuffer, 0xFF, 256);
+	memcpy(SPI_Flash_sectorbuffer + (address & 0xFF), rec, sizeof(lastHeardLogRecord_t));
+
+	if (SPI_Flash_writePage(address & ~0xFFU, SPI_Flash_sectorbuffer) == false)
+	{
+		return false;
+	}
+
+	lastHeardLogSequence++;
+	lastHeardLogWritePos = (lastHeardLogWritePos + sizeof(lastHeardLogRecord_t)) % LASTHEARD_LOG_FLASH_SIZE;
+
+	return true;
+}
+
+// Restore the list from the Flash log, newest first, and setup the log write position.
+static void lastheardLogRestore(void)
+{
+	lastHeardLogRecord_t rec;
+	uint32_t newestPos = 0;
+	bool found = false;
+
+	for (uint32_t pos = 0; pos < LASTHEARD_LOG_FLASH_SIZE; pos += sizeof(lastHeardLogRecord_t))
+	{
+		SPI_Flash_read(LASTHEARD_LOG_FLASH_START + pos, (uint8_t *)&rec.sequence, sizeof(rec.sequence));
+
+		if ((rec.sequence != 0xFFFFFFFF) && ((found == false) || ((int32_t)(rec.sequence - lastHeardLogSequence) > 0)))
+		{
+			lastHeardLogSequence = rec.sequence;
+			newestPos = pos;
+			found = true;
+		}
+	}
+
+	if (found == false)
+	{
+		lastHeardLogSequence = 0;
+		lastHeardLogWritePos = 0;
+		return;
+	}
+
+	lastHeardLogWritePos = (newestPos + sizeof(lastHeardLogRecord_t)) % LASTHEARD_LOG_FLASH_SIZE;
+
+	// Walk backwards from the newest record, appending each new ID at the bottom of the list
+	LinkItem_t *item = LinkHead;
+	uint32_t pos = newestPos;
+	uint32_t expectedSequence = lastHeardLogSequence;
+
+	lastHeardLogSequence++;
+
+	for (uint32_t n = 0; (n < (LASTHEARD_LOG_FLASH_SIZE / sizeof(lastHeardLogRecord_t))) && (item != NULL); n++)
+	{
+		SPI_Flash_read(LASTHEARD_LOG_FLASH_START + pos, (uint8_t *)&rec, sizeof(lastHeardLogRecord_t));
+
+		if (rec.sequence != expectedSequence)
+		{
+			break;// Reached erased or older wrapped data
+		}
+
+		if ((rec.id != 0) && (lastheardFindInList(rec.id) == NULL))
+		{
+			item->id = rec.id;
+			item->talkGroupOrPcId = rec.talkGroupOrPcId;
+			memcpy(item->locator, rec.locator, sizeof(item->locator));
+			item->locator[sizeof(item->locator) - 1] = 0;
+			memcpy(item->talkerAlias, rec.talkerAlias, sizeof(item->talkerAlias));
+			item->talkerAlias[sizeof(item->talkerAlias) - 1] = 0;
+			item->time = 0;// There is no RTC, hence when this station was heard is unknown
+			item->ber = -1;
+			lastheardHashInsert(item);
+			item = item->next;
+		}
+
+		expectedSequence--;
+		pos = ((pos == 0) ? LASTHEARD_LOG_FLASH_SIZE : pos) - sizeof(lastHeardLogRecord_t);
+	}
+}
+
 void lastheardInitList(void)
 {
 	LinkHead = callsList;
+	LinkTail = &callsList[NUM_LASTHEARD_STORED - 1];
+	memset(lastHeardHashTable, LASTHEARD_HASH_EMPTY, sizeof(lastHeardHashTable));
+	lastHeardLogNumPending = 0;
 
 	for(int i = 0; i < NUM_LASTHEARD_STORED; i++)
 	{
@@ -163,6 +399,7 @@ void lastheardInitList(void)
 		callsList[i].talkerAlias[0] = 0;
 		callsList[i].locator[0] = 0;
 		callsList[i].time = 0;
+		callsList[i].ber = -1;
 
 		if (i == 0)
 		{
@@ -182,22 +419,96 @@ void lastheardInitList(void)
 			callsList[i].next = NULL;
 		}
 	}
+
+	lastheardLogRestore();
+}
+
+// The contact and talkgroup names of restored items are looked up here, as the DMR ID and contacts caches are not ready when the list is restored.
+void lastheardUpdateRestoredNames(void)
+{
+	LinkItem_t *item = LinkHead;
+
+	while ((item != NULL) && (item->id != 0))
+	{
+		if (item->contact[0] == 0)
+		{
+			updateLHItem(item);
+		}
+		item = item->next;
+	}
 }
 
 LinkItem_t *lastheardFindInList(uint32_t id)
 {
-    LinkItem_t *item = LinkHead;
+	uint32_t slot = lastheardHashSlot(id);
 
-    while (item->next != NULL)
-    {
-        if (item->id == id)
-        {
-            // found it
-            return item;
-        }
-        item = item->next;
-    }
-    return NULL;
+	while (lastHeardHashTable[slot] != LASTHEARD_HASH_EMPTY)
+	{
+		if (callsList[lastHeardHashTable[slot]].id == id)
+		{
+			// found it
+			return &callsList[lastHeardHashTable[slot]];
+		}
+		slot = (slot + 1) & LASTHEARD_HASH_MASK;
+	}
+	return NULL;
+}
+
+// Write one pending record to the Flash log, if any, but only while the radio is neither receiving nor transmitting DMR.
+void lastheardLogTick(void)
+{
+	if ((lastHeardLogNumPending > 0) && (trxIsTransmitting == false) && (slot_state == DMR_STATE_IDLE))
+	{
+		lastheardLogWriteRecord(&lastHeardLogPending[0]);
+		lastHeardLogNumPending--;
+		memmove(&lastHeardLogPending[0], &lastHeardLogPending[1], sizeof(lastHeardLogRecord_t) * lastHeardLogNumPending);
+	}
+}
+
+// Store everything still pending, then the current head of the list. Used when powering off.
+// The pending records are written first, as queuing the head into a full queue would drop the oldest of them.
+void lastheardLogFlush(void)
+{
+	for (int i = 0; i < lastHeardLogNumPending; i++)
+	{
+		lastheardLogWriteRecord(&lastHeardLogPending[i]);
+	}
+	lastHeardLogNumPending = 0;
+
+	lastheardLogQueueItem(LinkHead);
+	if (lastHeardLogNumPending > 0)
+	{
+		lastheardLogWriteRecord(&lastHeardLogPending[0]);
+		lastHeardLogNumPending = 0;
+	}
+}
+
+// Read the whole log, newest record first, for the CPS (area 8 of the 'R' command).
+// The address is (record number * sizeof(lastHeardLogRecord_t)) + offset in the record, record 0 being the newest.
+// Reads fail past the oldest record still in the Flash.
+bool lastheardLogRead(uint32_t address, uint8_t *buf, uint32_t length)
+{
+	uint32_t recordNumber = address / sizeof(lastHeardLogRecord_t);
+	uint32_t offset = address % sizeof(lastHeardLogRecord_t);
+	uint32_t pos;
+	uint32_t sequence;
+
+	if ((recordNumber >= (LASTHEARD_LOG_FLASH_SIZE / sizeof(lastHeardLogRecord_t))) || ((offset + length) > sizeof(lastHeardLogRecord_t)) ||
+			(recordNumber >= lastHeardLogSequence))
+	{
+		return false;
+	}
+
+	pos = (lastHeardLogWritePos + LASTHEARD_LOG_FLASH_SIZE - ((recordNumber + 1) * sizeof(lastHeardLogRecord_t))) % LASTHEARD_LOG_FLASH_SIZE;
+
+	// The record has been erased, or is older data left from a previous wrap
+	if ((SPI_Flash_read(LASTHEARD_LOG_FLASH_START + pos, (uint8_t *)&sequence, sizeof(sequence)) == false) ||
+			(sequence != (lastHeardLogSequence - 1 - recordNumber)))
+	{
+		return false;
+	}
+
+	return SPI_Flash_read(LASTHEARD_LOG_FLASH_START + pos + offset, buf, length);
 }
 
 static uint8_t *coordsToMaidenhead(double longitude, double latitude)
@@ -374,6 +685,17 @@ void lastHeardClearLastID(void)
 	lastID=0;
 }
 
+// Store the BER of the call being received in the last heard entry of the station which is transmitting
+void lastheardUpdateBER(void)
+{
+	int ber = codecGetBER(true);
+
+	if ((ber >= 0) && (LinkHead->id != 0) && (LinkHead->id == HRC6000GetReceivedSrcId()))
+	{
+		LinkHead->ber = ber;
+	}
+}
+
 static void updateLHItem(LinkItem_t *item)
 {
 	static const int bufferLen = 33; // displayChannelNameOrRxFrequency() use 6x8 font
@@ -508,6 +830,8 @@ bool lastHeardListUpdate(uint8_t *dmrDataBuffer, bool forceOnHotspot)
 		{
 			uint32_t id = (dmrDataBuffer[6] << 16) + (dmrDataBuffer[7] << 8) + (dmrDataBuffer[8] << 0);
 
+			ambeRecorderSetRxCallInfo(id, talkGroupOrPcId);
+
 			if (id != lastID)
 			{
 				memset(bufferTA, 0, 32);// Clear any TA data in TA buffer (used for decode)
@@ -539,25 +863,10 @@ bool lastHeardListUpdate(uint8_t *dmrDataBuffer, bool forceOnHotspot)
 					else
 					{
 						// not at top of the list
-						// Move this item to the top of the list
-						LinkItem_t *next = item->next;
-						LinkItem_t *prev = item->prev;
-
-						// set the previous item to skip this item and link to 'items' next item.
-						prev->next = next;
-
-						if (item->next != NULL)
-						{
-							// not the last in the list
-							next->prev = prev;// backwards link the next item to the item before us in the list.
-						}
+						// Move this item to the top of the list, the old head is stored in the Flash log
+						lastheardLogQueueItem(LinkHead);
+						lastheardMoveToHead(item);
 
-						item->next = LinkHead;// link our next item to the item at the head of the list
-
-						LinkHead->prev = item;// backwards link the hold head item to the item moving to the top of the list.
-
-						item->prev = NULL;// change the items prev to NULL now we are at teh top of the list
-						LinkHead = item;// Change the global for the head of the link to the item that is to be at the top of the list.
 						if (item->talkGroupOrPcId != 0)
 						{
 							menuDisplayQSODataState = QSO_DISPLAY_CALLER_DATA;// flag that the display needs to update
@@ -567,25 +876,23 @@ bool lastHeardListUpdate(uint8_t *dmrDataBuffer, bool forceOnHotspot)
 				else
 				{
 					// Not in the list
-					item = LinkHead;// setup to traverse the list from the top.
-
 					// need to use the last item in the list as the new item at the top of the list.
-					// find last item in the list
-					while(item->next != NULL)
+					item = LinkTail;
+
+					lastheardLogQueueItem(LinkHead);
+
+					if (item->id != 0)
 					{
-						item = item->next;
+						lastheardHashRemove(item);
 					}
-					//item is now the last
 
-					(item->prev)->next = NULL;// make the previous item the last
-
-					LinkHead->prev = item;// set the current head item to back reference this item.
-					item->next = LinkHead;// set this items next to the current head
-					LinkHead = item;// Make this item the new head
+					lastheardMoveToHead(item);
 
 					item->id = id;
+					lastheardHashInsert(item);
 					item->talkGroupOrPcId = talkGroupOrPcId;
 					item->time = fw_millis();
+					item->ber = -1;
 					lastTG = talkGroupOrPcId;
 
 					memset(item->contact, 0, sizeof(item->contact)); // Clear contact's datas
@@ -1327,8 +1634,30 @@ void drawRSSIBarGraph(void)
 	{
 		barGraphLength=123;
 	}
-	ucFillRect(0, BAR_Y_POS,barGraphLength,4,false);
+	ucFillRect(0, BAR_Y_POS,barGraphLength,RSSI_BAR_HEIGHT,false);
 	trxRxSignal=0;
+
+	drawBERBarGraph();
+}
+
+// Thin bar under the RSSI bar, for the BER of the DMR audio being received. 10% or more is full scale
+static void drawBERBarGraph(void)
+{
+	int ber,barGraphLength;
+
+	ucFillRect(0, BER_BAR_Y_POS,128,1,true);
+
+	if ((trxGetMode() != RADIO_MODE_DIGITAL) || (slot_state == DMR_STATE_IDLE) || ((ber = codecGetBER(false)) < 0))
+	{
+		return;
+	}
+
+	barGraphLength = (ber * 123) / 100;
+	if (barGraphLength>123)
+	{
+		barGraphLength=123;
+	}
+	ucFillRect(0, BER_BAR_Y_POS,barGraphLength,1,false);
 }
 
 void drawDMRMicLevelBarGraph(void)
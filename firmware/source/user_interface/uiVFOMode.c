@@ -40,6 +40,7 @@ static void stepFrequency(int increment);
 static void loadContact(void);
 static void toneScan(void);
 static void scanning(void);
+static void scanStepFrequency(void);
 static void initScan(void);
 static void uiVFOUpdateTrxID(void );
 static void setCurrentFreqToScanLimits(void);
@@ -56,6 +57,15 @@ static bool displayChannelSettings;
 static int prevDisplayQSODataState;
 static vfoScreenOperationMode_t screenOperationMode[2] = {VFO_SCREEN_OPERATION_NORMAL,VFO_SCREEN_OPERATION_NORMAL};// For VFO A and B
 
+// As for the Channel screen scan, only the AT1846S Rx frequency is changed on each step, and the Rx noise is sampled for the dwell time.
+// The transceiver is only fully tuned on the frequencies where a carrier is found.
+static const int SCAN_DISPLAY_UPDATE_STEPS = 8;// The frequency is only redrawn every few steps
+static trxFastTune_t scanFastTune;
+static bool scanDwellTuned = false;
+static int scanDwellTimer = 0;
+static int scanDwellTime = 0;
+static int scanStepsSinceDisplayUpdate = 0;
+
 #if defined(PLATFORM_RD5R)
 const int RX_FREQ_Y_POS = 31;
 const int TX_FREQ_Y_POS = 40;
@@ -548,6 +558,12 @@ void uiVFOModeStopScanning(void)
 		trxSetRxCTCSS(currentChannelData->rxTone);
 		toneScanActive=false;
 	}
+	if (scanDwellTuned)
+	{
+		// The receiver has only been fast tuned on the scanned frequency, fully tune the transceiver on it
+		trxSetFrequency(currentChannelData->rxFreq, currentChannelData->txFreq, DMR_MODE_AUTO);
+		scanDwellTuned = false;
+	}
 	scanActive=false;
 	menuDisplayQSODataState = QSO_DISPLAY_DEFAULT_SCREEN;
 	uiVFOModeUpdateScreen(0); // Needs to redraw the screen now
@@ -1203,8 +1219,10 @@ static void handleUpKey(uiEvent_t *ev)
 		}
 		uiVFOModeUpdateScreen(0);
 	}
+	// Listen to the manually selected frequency for a moment, then carry on scanning from there
 	scanTimer=500;
-	scanState = SCAN_SCANNING;
+	scanState = (scanActive ? SCAN_SHORT_PAUSED : SCAN_SCANNING);
+	scanDwellTuned = false;
 	SETTINGS_PLATFORM_SPECIFIC_SAVE_SETTINGS(true);
 }
 
@@ -1382,7 +1400,9 @@ static void handleQuickMenuEvent(uiEvent_t *ev)
 				if (trxGetMode() == RADIO_MODE_DIGITAL)
 				{
 					nonVolatileSettings.dmrFilterLevel = tmpQuickMenuDmrFilterLevel;
+					lock_SPI_bus();
 					init_digital_DMR_RX();
+					unlock_SPI_bus();
 					disableAudioAmp(AUDIO_AMP_MODE_RF);
 				}
 				else
@@ -1633,20 +1653,111 @@ static void initScan(void)
 
 	selectedFreq = VFO_SELECTED_FREQUENCY_INPUT_RX;
 
+	scanDwellTuned = false;
+	scanStepsSinceDisplayUpdate = 0;
 	scanTimer=500;
-	scanState = SCAN_SCANNING;
+	scanState = SCAN_SHORT_PAUSED;// Listen to the current frequency first
 	menuSystemPopAllAndDisplaySpecificRootMenu(UI_VFO_MODE);
 }
 
+// Move to the next frequency within the scan limits, skipping the gaps between the bands. The transceiver is not retuned.
+static void scanStepFrequency(void)
+{
+	int low = nonVolatileSettings.vfoScanLow[nonVolatileSettings.currentVFONumber];
+	int high = nonVolatileSettings.vfoScanHigh[nonVolatileSettings.currentVFONumber];
+	int offset = currentChannelData->txFreq - currentChannelData->rxFreq;
+	int freq = currentChannelData->rxFreq + (VFO_FREQ_STEP_TABLE[(currentChannelData->VFOflag5 >> 4)] * scanDirection);
+
+	if (freq > high)
+	{
+		freq = low;
+	}
+	else if (freq < low)
+	{
+		freq = high;
+	}
+
+	if (trxGetBandFromFrequency(freq) == -1)
+	{
+		int band = trxGetNextOrPrevBandFromFrequency(freq, (scanDirection == 1));
+
+		if (band != -1)
+		{
+			freq = ((scanDirection == 1) ? RADIO_FREQUENCY_BANDS[band].minFreq : RADIO_FREQUENCY_BANDS[band].maxFreq);
+		}
+
+		if ((band == -1) || (freq < low) || (freq > high))
+		{
+			freq = ((scanDirection == 1) ? low : high);
+		}
+	}
+
+	currentChannelData->rxFreq = freq;
+	currentChannelData->txFreq = freq + offset;
+}
+
 static void scanning(void)
 {
-	//After initial settling time
-	if((scanState == SCAN_SCANNING) && (scanTimer > SCAN_SKIP_CHANNEL_INTERVAL) && (scanTimer < ( SCAN_TOTAL_INTERVAL - SCAN_FREQ_CHANGE_SETTLING_INTERVAL)))
+	if (scanState == SCAN_SCANNING)
 	{
+		if (!scanDwellTuned)
+		{
+			scanStepFrequency();
+
+			//check all nuisance delete entries and skip the frequency if there is a match
+			for(int i=0;i<MAX_ZONE_SCAN_NUISANCE_CHANNELS;i++)
+			{
+				if (nuisanceDelete[i]==-1)
+				{
+					break;
+				}
+				else
+				{
+					if(nuisanceDelete[i]==currentChannelData->rxFreq)
+					{
+						return;
+					}
+				}
+			}
+
+			// Only use the squelch level of the VFO in FM, DMR always uses the band default (see trxCheckDigitalSquelch())
+			trxFastTunePrepare(currentChannelData->rxFreq, ((currentChannelData->chMode == RADIO_MODE_ANALOG) ? currentChannelData->sql : 0), &scanFastTune);
+			trxFastTuneRx(&scanFastTune);
+			trx_measure_count = 0;
+			scanDwellTuned = true;
+			scanDwellTimer = 0;
+
+			//allow extra time if scanning a simplex DMR frequency (needs to catch the TDMA pulsing)
+			if ((trxGetMode() == RADIO_MODE_DIGITAL) && (trxDMRMode == DMR_MODE_ACTIVE))
+			{
+				scanDwellTime = SCAN_DMR_SIMPLEX_MIN_INTERVAL;
+			}
+			else
+			{
+				scanDwellTime = SCAN_FAST_DWELL_TIME;
+			}
+
+			if (++scanStepsSinceDisplayUpdate >= SCAN_DISPLAY_UPDATE_STEPS)
+			{
+				scanStepsSinceDisplayUpdate = 0;
+				uiVFOModeUpdateScreen(0);
+			}
+			return;
+		}
+
+		scanDwellTimer++;
+
 		//test for presence of RF Carrier.
 		// In FM mode the dmr slot_state will always be DMR_STATE_IDLE
-		if (slot_state != DMR_STATE_IDLE)
+		if ((scanDwellTimer > SCAN_FAST_SETTLING_TIME) && ((slot_state != DMR_STATE_IDLE) || trxFastTuneCarrierDetected(&scanFastTune)))
 		{
+			// Something has been heard, fully tune the transceiver to qualify the signal
+			trxSetFrequency(currentChannelData->rxFreq, currentChannelData->txFreq, DMR_MODE_AUTO);
+			scanDwellTuned = false;
+			trx_measure_count = 0;
+			scanStepsSinceDisplayUpdate = 0;
+			uiVFOModeUpdateScreen(0);
+
 			if (nonVolatileSettings.scanModePause == SCAN_MODE_STOP)
 			{
 				scanActive = false;
@@ -1656,38 +1767,23 @@ static void scanning(void)
 				ucRenderRows(0,  2);
 				return;
 			}
-			else
-			{
-				scanState = SCAN_PAUSED;
-				scanTimer = nonVolatileSettings.scanDelay * 1000;
-			}
+
+			scanTimer = SCAN_SHORT_PAUSE_TIME;//start short delay to allow full detection of signal
+			scanState = SCAN_SHORT_PAUSED;//state 1 = pause and test for valid signal that produces audio
+			return;
 		}
-		else
+
+		if (scanDwellTimer >= scanDwellTime)
 		{
-			if(trxCarrierDetected())
-			{
-				if (nonVolatileSettings.scanModePause == SCAN_MODE_STOP)
-				{
-					scanActive = false;
-					// Just update the header (to prevent hidden mode)
-					ucClearRows(0,  2, false);
-					menuUtilityRenderHeader();
-					ucRenderRows(0,  2);
-					return;
-				}
-				else
-				{
-					scanTimer = SCAN_SHORT_PAUSE_TIME;//start short delay to allow full detection of signal
-					scanState = SCAN_SHORT_PAUSED;//state 1 = pause and test for valid signal that produces audio
-				}
-			}
+			scanDwellTuned = false;
 		}
+		return;
 	}
 
 	// Only do this once if scan mode is PAUSE do it every time if scan mode is HOLD
 	if(((scanState == SCAN_PAUSED) && (nonVolatileSettings.scanModePause == SCAN_MODE_HOLD)) || (scanState == SCAN_SHORT_PAUSED))
 	{
-	    if (getAudioAmpStatus() & AUDIO_AMP_MODE_RF)
+	    if ((getAudioAmpStatus() & AUDIO_AMP_MODE_RF) || (slot_state != DMR_STATE_IDLE))
 	    {
 	    	scanTimer = nonVolatileSettings.scanDelay * 1000;
 	    	scanState = SCAN_PAUSED;
@@ -1700,66 +1796,7 @@ static void scanning(void)
 	}
 	else
 	{
-
-		trx_measure_count=0;//needed to allow time for Rx to settle after channel change.
-		uiEvent_t tmpEvent={ .buttons = 0, .keys = NO_KEYCODE, .rotary = 0, .function = 0, .events = NO_EVENT, .hasEvent = 0, .time = 0 };
-
-		if (scanDirection == 1)
-		{
-			if(currentChannelData->rxFreq + VFO_FREQ_STEP_TABLE[(currentChannelData->VFOflag5 >> 4)] <= nonVolatileSettings.vfoScanHigh[nonVolatileSettings.currentVFONumber])
-			{
-				handleUpKey(&tmpEvent);
-			}
-			else
-			{
-				int offset = currentChannelData->txFreq - currentChannelData->rxFreq;
-				currentChannelData->rxFreq = nonVolatileSettings.vfoScanLow[nonVolatileSettings.currentVFONumber];
-				currentChannelData->txFreq = currentChannelData->rxFreq + offset;
-				trxSetFrequency(currentChannelData->rxFreq, currentChannelData->txFreq, DMR_MODE_AUTO);
-			}
-		}
-		else
-		{
-			if(currentChannelData->rxFreq + VFO_FREQ_STEP_TABLE[(currentChannelData->VFOflag5 >> 4)] >= nonVolatileSettings.vfoScanLow[nonVolatileSettings.currentVFONumber])
-			{
-				handleUpKey(&tmpEvent);
-			}
-			else
-			{
-				int offset = currentChannelData->txFreq - currentChannelData->rxFreq;
-				currentChannelData->rxFreq = nonVolatileSettings.vfoScanHigh[nonVolatileSettings.currentVFONumber];
-				currentChannelData->txFreq = currentChannelData->rxFreq+offset;
-				trxSetFrequency(currentChannelData->rxFreq, currentChannelData->txFreq, DMR_MODE_AUTO);
-			}
-		}
-
-		//allow extra time if scanning a simplex DMR channel.
-		if ((trxGetMode() == RADIO_MODE_DIGITAL) && (trxDMRMode == DMR_MODE_ACTIVE) && (SCAN_TOTAL_INTERVAL < SCAN_DMR_SIMPLEX_MIN_INTERVAL) )
-		{
-			scanTimer = SCAN_DMR_SIMPLEX_MIN_INTERVAL;
-		}
-		else
-		{
-			scanTimer = SCAN_TOTAL_INTERVAL;
-		}
-
-		scanState = SCAN_SCANNING;//state 0 = settling and test for carrier present.
-
-		//check all nuisance delete entries and skip channel if there is a match
-		for(int i=0;i<MAX_ZONE_SCAN_NUISANCE_CHANNELS;i++)
-		{
-			if (nuisanceDelete[i]==-1)
-			{
-				break;
-			}
-			else
-			{
-				if(nuisanceDelete[i]==currentChannelData->rxFreq)
-				{
-					scanTimer=SCAN_SKIP_CHANNEL_INTERVAL;
-					break;
-				}
-			}
-		}
+		scanDwellTuned = false;
+		scanState = SCAN_SCANNING;//state 0 = dwell and test for carrier present.
 	}
 }
@@ -49,7 +49,7 @@ DEFAULT_SCALE = 2
 DEFAULT_FOREGROUND = "#000000"
 DEFAULT_BACKGROUND = "#99d9ea"
 ##
-PROGRAM_VERSION = '0.0.2'
+PROGRAM_VERSION = '0.0.3'
 
 ###
 # Send the command to the GD-77 and read buffer back
@@ -124,6 +124,136 @@ def sendAndReceiveCommand(ser):
     return True
 
 
+###
+# Convert a byte read from the serial port to an int (python2 returns a str)
+###
+def byteValue(b):
+    if (sys.version_info > (3, 0)):
+        return b
+    else:
+        return ord(b)
+
+
+###
+# Read exactly 'length' bytes, or return None on timeout.
+# The bytes can arrive in several reads, a read returning less than 'length' bytes doesn't mean the data is lost.
+###
+def readBytes(ser, length, timeout=None):
+    data = []
+    deadline = time.time() + (ser.timeout if (timeout is None) else timeout)
+    while (len(data) < length):
+        data.extend([byteValue(b) for b in ser.read(length - len(data))])
+        if ((len(data) < length) and (time.time() >= deadline)):
+            return None
+    return data
+
+
+###
+# Start or stop the screen streaming, the GD-77 replies with '-'
+###
+def sendStreamCommand(ser, enable):
+    ser.write([ord('C'), 7, (1 if enable else 0)])
+
+
+###
+# Restart the streaming after the stream has been lost. Both sides restart from a blank screen, so the next frame is a full one
+###
+def restartStream(ser):
+    global imgBuffer
+
+    sendStreamCommand(ser, False)
+    time.sleep(0.5)
+    ser.reset_input_buffer()
+    imgBuffer = [0x0] * 1024
+    sendStreamCommand(ser, True)
+
+
+###
+# Apply the XOR/RLE encoded row to the image buffer
+###
+def decodeRow(row, data):
+    column = 0
+    pos = 0
+    while (pos < len(data)):
+        token = data[pos]
+        pos += 1
+        count = (token & 0x7F) + 1
+        if ((column + count) > 128):
+            return False
+        if ((token & 0x80) != 0):
+            column += count
+        else:
+            if ((pos + count) > len(data)):
+                return False
+            for i in range(0, count):
+                imgBuffer[(row * 128) + column] ^= data[pos]
+                column += 1
+                pos += 1
+
+    return (column == 128)
+
+
+###
+# Receive the streamed frames and save each of them, until the duration has elapsed
+###
+def recordStream(ser, filename, scale, foreground, background, duration):
+    frameCount = 0
+
+    ser.reset_input_buffer()
+    sendStreamCommand(ser, True)
+    ser.timeout = 0.5
+
+    reply = readBytes(ser, 1)
+    if ((reply is None) or (reply[0] != ord('-'))):
+        print("ERROR: the GD-77 did not accept the streaming command")
+        return False
+
+    print(" - recording for " + str(duration) + " seconds...")
+    endTime = time.time() + duration
+    expectedFrameNumber = 0
+    while (time.time() < endTime):
+        marker = readBytes(ser, 1)
+        if (marker is None):
+            # Nothing has changed on the screen
+            continue
+
+        # Anything else than a frame marker (e.g. the reply to a restart command) is skipped
+        if (marker[0] != ord('S')):
+            continue
+
+        # A frame is sent in one go, so the rest of it follows quickly
+        header = readBytes(ser, 2, 1.0)
+        valid = ((header is not None) and (header[0] == expectedFrameNumber))
+
+        if (valid):
+            for row in range(0, 8):
+                if (((header[1] >> row) & 0x01) != 0):
+                    length = readBytes(ser, 1, 1.0)
+                    data = (readBytes(ser, length[0], 1.0) if (length is not None) else None)
+                    if ((data is None) or (decodeRow(row, data) == False)):
+                        valid = False
+                        break
+
+        if (valid == False):
+            # The image can't be trusted anymore, as each frame only contains the changes from the previous one
+            print(" - stream out of sync, restarting it")
+            restartStream(ser)
+            expectedFrameNumber = 0
+            continue
+
+        expectedFrameNumber = ((expectedFrameNumber + 1) & 0xFF)
+        saveImage(filename + "-" + "%05d" % frameCount, scale, foreground, background)
+        frameCount += 1
+
+    sendStreamCommand(ser, False)
+    # Drain what was sent before the streaming stopped
+    time.sleep(0.5)
+    ser.reset_input_buffer()
+
+    print(" - " + str(frameCount) + " frames recorded")
+    return True
+
+
 ###
 # Scale and save the downloaded image to a PNG file
 ###
@@ -160,7 +290,8 @@ def usage():
     print("    -s, --scale=v              : Apply scale factor (1..x) [default: " + str(DEFAULT_SCALE) + "],")
     print("    -o, --output=<filename>    : Save the image in <filename>.png (without file extension),")
     print("    -f, --foreground=#RRGGBB   : Use specified color as foreground color [default: " + DEFAULT_FOREGROUND + "],")
-    print("    -b, --background=#RRGGBB   : Use specified color as background color [default: " + DEFAULT_BACKGROUND + "].")
+    print("    -b, --background=#RRGGBB   : Use specified color as background color [default: " + DEFAULT_BACKGROUND + "],")
+    print("    -r, --record=<seconds>     : Record the screen changes for <seconds>, in <filename>-NNNNN.png files.")
     print("")
 
 
@@ -180,10 +311,11 @@ def main():
     dateTimeObj = datetime.now()
     timestampStr = dateTimeObj.strftime("%Y-%m-%d_%H_%M_%S")
     filename = "GD-77_screengrab-" + timestampStr
+    recordDuration = 0
     
     # Command line argument parsing
     try:                                
-        opts, args = getopt.getopt(sys.argv[1:], "hd:s:o:f:b:", ["help", "device=", "scale=", "output=", "foreground=", "background="])
+        opts, args = getopt.getopt(sys.argv[1:], "hd:s:o:f:b:r:", ["help", "device=", "scale=", "output=", "foreground=", "background=", "record="])
     except getopt.GetoptError as err:
         print(str(err))
         usage()
@@ -219,6 +351,10 @@ def main():
                 sys.exit(-3)
 
             background = arg
+        elif opt in ("-r", "--record"):
+            recordDuration = int(arg)
+            if (recordDuration < 1):
+                recordDuration = 1
         else:
             assert False, "Unhandled option"
 
@@ -245,12 +381,19 @@ def main():
         print(str(err))
         sys.exit(1)
     
-    print("Save screen image:")
-    if (sendAndReceiveCommand(ser) == True):
-        saveImage(filename, scale, foreground, background)
-        print("Done.")
+    if (recordDuration > 0):
+        print("Record screen images:")
+        if (recordStream(ser, filename, scale, foreground, background, recordDuration) == True):
+            print("Done.")
+        else:
+            print("Failure")
     else:
-        print("Failure")
+        print("Save screen image:")
+        if (sendAndReceiveCommand(ser) == True):
+            saveImage(filename, scale, foreground, background)
+            print("Done.")
+        else:
+            print("Failure")
         
     if (ser.is_open):
         ser.close()
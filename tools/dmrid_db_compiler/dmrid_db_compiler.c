@@ -0,0 +1,848 @@
+/* -*- mode: c; c-file-style: "k&r"; compile-command: "gcc -Wall -O2 -s -o dmrid_db_compiler dmrid_db_compiler.c"; -*- */
+
+/*
+ * DMR ID database compiler: builds the DMR IDs Flash image used by the OpenGD77 firmware
+ * from a CSV user list, and optionally uploads it to the radio over the CPS USB protocol.
+ *
+ * Copyright (C)2019 Roger Clark. VK3KYY
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *   1. Redistributions of source code must retain the above copyright notice,
+ *      this list of conditions and the following disclaimer.
+ *   2. Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer in the
+ *      documentation and/or other materials provided with the distribution.
+ *   3. The name of the author may not be used to endorse or promote products
+ *      derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR IMPLIED
+ * WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO
+ * EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ * ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+//
+// Flash image layout (read by dmrIDCacheInit() and dmrIDLookup() in the firmware):
+//
+//   0x30000: 'I', 'D', '-', (0x4A + record length), '0', '0', '1', 0x00, number of records (32 bits, little endian)
+//   0x3000C: records, sorted by ascending ID:
+//            ID (BCD, 32 bits, little endian), text (record length - 4 chars, zero padded)
+//
+// The CSV file is read line by line, e.g. the radioid.net user.csv:
+//   RADIO_ID,CALLSIGN,FIRST_NAME,LAST_NAME,CITY,STATE,COUNTRY
+// Lines which don't start with a valid DMR ID (like the column titles) are ignored. As the whole worldwide
+// list doesn't fit in the Flash, the IDs can be selected by prefix (e.g. the country codes).
+//
+// The sort doesn't hold the whole list in memory: sorted runs are written to temporary files,
+// then merged while the image is built.
+//
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include <ctype.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <errno.h>
+#include <poll.h>
+#include <termios.h>
+
+#define DMRID_MEMORY_STORAGE_START     0x30000
+#define DMRID_MEMORY_STORAGE_MAX_SIZE  0x40000
+#define DMRID_HEADER_LENGTH            0x0C
+#define DMRID_MAX_ID                   16777215
+
+// These are the firmware's values, only used to display the slices boundaries
+#define MIN_ENTRIES_BEFORE_USING_SLICES 40
+#define ID_SLICES                       14
+
+#define MIN_TEXT_LENGTH                 6
+#define MAX_TEXT_LENGTH                 20 // sizeof(dmrIdDataStruct_t.text)
+#define DEFAULT_TEXT_LENGTH             8
+
+#define RUN_LENGTH                      65536 // Records sorted in memory at once
+#define MAX_RUNS                        256
+#define MAX_LINE_LENGTH                 1024
+
+#define MAX_PREFIXES                    64
+
+#define DEFAULT_DEVICE                  "/dev/ttyACM0"
+#define FLASH_SECTOR_SIZE               4096
+#define MAX_TRANSFER_SIZE               32
+#define SERIAL_TIMEOUT_MS               2000
+
+typedef struct
+{
+     uint32_t id;
+     char     text[MAX_TEXT_LENGTH];
+} dmrIdRecord_t;
+
+static bool verbose = false;
+
+// Only the IDs starting with one of these prefixes are stored (all IDs if there is no prefix)
+static char idPrefixes[MAX_PREFIXES][9];
+static int  numIdPrefixes = 0;
+
+
+/**
+ * Same as int2bcd() in the firmware
+ **/
+static uint32_t int2bcd(uint32_t i)
+{
+     uint32_t result = 0;
+     int      shift = 0;
+
+     while (i)
+     {
+	  result += (i % 10) << shift;
+	  i = i / 10;
+	  shift += 4;
+     }
+
+     return result;
+}
+
+/**
+ * Copy the field number 'fieldNum' of a CSV line, without its quotes
+ **/
+static void csvGetField(const char *line, int fieldNum, char *field, size_t fieldSize)
+{
+     bool   inQuotes = false;
+     int    currentField = 0;
+     size_t len = 0;
+
+     for (const char *p = line; (*p != '\0') && (*p != '\r') && (*p != '\n'); p++)
+     {
+	  if (*p == '"')
+	  {
+	       inQuotes = !inQuotes;
+	  }
+	  else if ((*p == ',') && (inQuotes == false))
+	  {
+	       if (currentField == fieldNum)
+	       {
+		    break;
+	       }
+	       currentField++;
+	  }
+	  else if ((currentField == fieldNum) && (len < (fieldSize - 1)))
+	  {
+	       field[len++] = *p;
+	  }
+     }
+
+     field[len] = '\0';
+
+     // Trim trailing spaces
+     while ((len > 0) && (field[len - 1] == ' '))
+     {
+	  field[--len] = '\0';
+     }
+}
+
+/**
+ * Parse the comma separated list of ID prefixes, returns false if the list is invalid
+ **/
+static bool parsePrefixes(const char *list)
+{
+     const char *p = list;
+
+     while (*p != '\0')
+     {
+	  size_t len = strspn(p, "0123456789");
+
+	  if ((len == 0) || (len >= sizeof(idPrefixes[0])) || (numIdPrefixes == MAX_PREFIXES) || ((p[len] != ',') && (p[len] != '\0')))
+	  {
+	       return false;
+	  }
+
+	  memcpy(idPrefixes[numIdPrefixes], p, len);
+	  idPrefixes[numIdPrefixes][len] = '\0';
+	  numIdPrefixes++;
+
+	  p += len;
+	  if (*p == ',')
+	  {
+	       p++;
+	  }
+     }
+
+     return (numIdPrefixes > 0);
+}
+
+static bool idMatchesPrefixes(const char *id)
+{
+     if (numIdPrefixes == 0)
+     {
+	  return true;
+     }
+
+     for (int i = 0; i < numIdPrefixes; i++)
+     {
+	  if (strncmp(id, idPrefixes[i], strlen(idPrefixes[i])) == 0)
+	  {
+	       return true;
+	  }
+     }
+
+     return false;
+}
+
+/**
+ * Parse a CSV line into a record, returns false if the line doesn't contain a valid DMR ID
+ **/
+static bool csvParseLine(const char *line, dmrIdRecord_t *record, size_t textLength, bool callsignOnly)
+{
+     char  field[MAX_LINE_LENGTH];
+     char  text[MAX_LINE_LENGTH];
+     char *end;
+     unsigned long id;
+
+     csvGetField(line, 0, field, sizeof(field));
+     errno = 0;
+     id = strtoul(field, &end, 10);
+
+     if ((field[0] == '\0') || (*end != '\0') || (errno != 0) || (id == 0) || (id > DMRID_MAX_ID) || (idMatchesPrefixes(field) == false))
+     {
+	  return false;
+     }
+
+     csvGetField(line, 1, text, sizeof(text));
+
+     if (callsignOnly == false)
+     {
+	  csvGetField(line, 2, field, sizeof(field));
+
+	  if (field[0] != '\0')
+	  {
+	       strncat(text, " ", sizeof(text) - strlen(text) - 1);
+	       strncat(text, field, sizeof(text) - strlen(text) - 1);
+	  }
+     }
+
+     record->id = (uint32_t)id;
+     memset(record->text, 0, sizeof(record->text));
+
+     // The firmware fonts only contains the ASCII printable characters
+     for (size_t i = 0; (i < textLength) && (text[i] != '\0'); i++)
+     {
+	  record->text[i] = (isprint((unsigned char)text[i]) ? text[i] : '?');
+     }
+
+     return true;
+}
+
+static int compareRecords(const void *a, const void *b)
+{
+     uint32_t idA = ((const dmrIdRecord_t *)a)->id;
+     uint32_t idB = ((const dmrIdRecord_t *)b)->id;
+
+     return ((idA > idB) - (idA < idB));
+}
+
+/**
+ * Sort the records in memory and store them in a new temporary file
+ **/
+static FILE *writeSortedRun(dmrIdRecord_t *records, size_t numRecords)
+{
+     FILE *runFile;
+
+     qsort(records, numRecords, sizeof(dmrIdRecord_t), compareRecords);
+
+     if ((runFile = tmpfile()) == NULL)
+     {
+	  perror("tmpfile()");
+	  return NULL;
+     }
+
+     if (fwrite(records, sizeof(dmrIdRecord_t), numRecords, runFile) != numRecords)
+     {
+	  perror("fwrite()");
+	  fclose(runFile);
+	  return NULL;
+     }
+
+     rewind(runFile);
+
+     return runFile;
+}
+
+/**
+ * Read the CSV file, and split it in sorted runs. Returns the number of runs, or -1 on error
+ **/
+static int createSortedRuns(const char *csvFilename, FILE **runs, size_t textLength, bool callsignOnly, size_t *numRecordsRead)
+{
+     FILE          *csvFile;
+     dmrIdRecord_t *records;
+     size_t         numRecords = 0;
+     int            numRuns = 0;
+     char           line[MAX_LINE_LENGTH];
+
+     *numRecordsRead = 0;
+
+     if ((csvFile = fopen(csvFilename, "r")) == NULL)
+     {
+	  fprintf(stderr, "Error. Unable to open the file '%s'\n", csvFilename);
+	  return -1;
+     }
+
+     if ((records = calloc(RUN_LENGTH, sizeof(dmrIdRecord_t))) == NULL)
+     {
+	  perror("calloc()");
+	  fclose(csvFile);
+	  return -1;
+     }
+
+     while (fgets(line, sizeof(line), csvFile) != NULL)
+     {
+	  if (csvParseLine(line, &records[numRecords], textLength, callsignOnly))
+	  {
+	       numRecords++;
+	       (*numRecordsRead)++;
+	  }
+
+	  if (numRecords == RUN_LENGTH)
+	  {
+	       if ((numRuns == MAX_RUNS) || ((runs[numRuns] = writeSortedRun(records, numRecords)) == NULL))
+	       {
+		    goto failure;
+	       }
+
+	       numRuns++;
+	       numRecords = 0;
+	  }
+     }
+
+     if (numRecords > 0)
+     {
+	  if ((numRuns == MAX_RUNS) || ((runs[numRuns] = writeSortedRun(records, numRecords)) == NULL))
+	  {
+	       goto failure;
+	  }
+
+	  numRuns++;
+     }
+
+     free(records);
+     fclose(csvFile);
+
+     return numRuns;
+
+failure:
+     if (numRuns == MAX_RUNS)
+     {
+	  fprintf(stderr, "Error. The CSV file is too large\n");
+     }
+
+     while (numRuns > 0)
+     {
+	  fclose(runs[--numRuns]);
+     }
+
+     free(records);
+     fclose(csvFile);
+
+     return -1;
+}
+
+/**
+ * Merge the sorted runs into the Flash image, duplicated IDs are only stored once.
+ * Returns the image length, or 0 on error
+ **/
+static size_t mergeRunsIntoImage(FILE **runs, int numRuns, uint8_t *image, size_t textLength, uint32_t *numEntries)
+{
+     dmrIdRecord_t heads[MAX_RUNS];
+     bool          hasHead[MAX_RUNS];
+     size_t        recordLength = textLength + 4;
+     size_t        maxEntries = (DMRID_MEMORY_STORAGE_MAX_SIZE - DMRID_HEADER_LENGTH) / recordLength;
+     uint32_t      lastId = 0;
+     uint32_t      entries = 0;
+     uint8_t      *p = image + DMRID_HEADER_LENGTH;
+
+     for (int i = 0; i < numRuns; i++)
+     {
+	  hasHead[i] = (fread(&heads[i], sizeof(dmrIdRecord_t), 1, runs[i]) == 1);
+     }
+
+     while (true)
+     {
+	  int smallest = -1;
+
+	  for (int i = 0; i < numRuns; i++)
+	  {
+	       if (hasHead[i] && ((smallest == -1) || (heads[i].id < heads[smallest].id)))
+	       {
+		    smallest = i;
+	       }
+	  }
+
+	  if (smallest == -1)
+	  {
+	       break;
+	  }
+
+	  if (heads[smallest].id != lastId)
+	  {
+	       if (entries == maxEntries)
+	       {
+		    fprintf(stderr, "Error. Too many IDs, the Flash space is limited to %zu IDs with %zu characters per ID\n", maxEntries, textLength);
+		    return 0;
+	       }
+
+	       uint32_t bcd = int2bcd(heads[smallest].id);
+
+	       p[0] = (bcd >> 0) & 0xFF;
+	       p[1] = (bcd >> 8) & 0xFF;
+	       p[2] = (bcd >> 16) & 0xFF;
+	       p[3] = (bcd >> 24) & 0xFF;
+	       memcpy(p + 4, heads[smallest].text, textLength);
+
+	       p += recordLength;
+	       entries++;
+	       lastId = heads[smallest].id;
+	  }
+
+	  hasHead[smallest] = (fread(&heads[smallest], sizeof(dmrIdRecord_t), 1, runs[smallest]) == 1);
+     }
+
+     image[0] = 'I';
+     image[1] = 'D';
+     image[2] = '-';
+     image[3] = (uint8_t)(0x4A + recordLength);
+     image[4] = '0';
+     image[5] = '0';
+     image[6] = '1';
+     image[7] = 0x00;
+     image[8] = (entries >> 0) & 0xFF;
+     image[9] = (entries >> 8) & 0xFF;
+     image[10] = (entries >> 16) & 0xFF;
+     image[11] = (entries >> 24) & 0xFF;
+
+     *numEntries = entries;
+
+     return (DMRID_HEADER_LENGTH + (entries * recordLength));
+}
+
+/**
+ * Display the slices boundaries, as computed by dmrIDCacheInit() in the firmware
+ **/
+static void displaySlices(const uint8_t *image, uint32_t entries, size_t recordLength)
+{
+     uint32_t slices[ID_SLICES];
+     uint32_t IDsPerSlice = 0;
+
+     if (entries == 0)
+     {
+	  return;
+     }
+
+#define RECORD_ID(n) ((uint32_t)image[DMRID_HEADER_LENGTH + ((n) * recordLength)] | \
+		      (uint32_t)image[DMRID_HEADER_LENGTH + ((n) * recordLength) + 1] << 8 | \
+		      (uint32_t)image[DMRID_HEADER_LENGTH + ((n) * recordLength) + 2] << 16 | \
+		      (uint32_t)image[DMRID_HEADER_LENGTH + ((n) * recordLength) + 3] << 24)
+
+     memset(slices, 0, sizeof(slices));
+     slices[0] = RECORD_ID(0);
+     slices[ID_SLICES - 1] = RECORD_ID(entries - 1);
+
+     if (entries > MIN_ENTRIES_BEFORE_USING_SLICES)
+     {
+	  IDsPerSlice = entries / (ID_SLICES - 1);
+
+	  for (int i = 0; i < (ID_SLICES - 2); i++)
+	  {
+	       slices[i + 1] = RECORD_ID((IDsPerSlice * i) + IDsPerSlice);
+	  }
+     }
+#undef RECORD_ID
+
+     fprintf(stdout, "Slices (%u IDs per slice):\n", IDsPerSlice);
+     for (int i = 0; i < ID_SLICES; i++)
+     {
+	  if ((IDsPerSlice > 0) || (i == 0) || (i == (ID_SLICES - 1)))
+	  {
+	       fprintf(stdout, "  [%2d] %x\n", i, slices[i]);
+	  }
+     }
+}
+
+static int saveImageToFile(const char *filename, const uint8_t *image, size_t imageLength)
+{
+     FILE *outFile;
+
+     if ((outFile = fopen(filename, "wb")) == NULL)
+     {
+	  fprintf(stderr, "Error. Unable to create the file '%s'\n", filename);
+	  return -1;
+     }
+
+     fprintf(stdout, "Writing %s\n", filename);
+
+     if (fwrite(image, 1, imageLength, outFile) != imageLength)
+     {
+	  perror("fwrite()");
+	  fclose(outFile);
+	  return -1;
+     }
+
+     if (fclose(outFile) != 0)
+     {
+	  perror("fclose()");
+	  return -1;
+     }
+
+     return 0;
+}
+
+static int serialOpen(const char *device)
+{
+     struct termios tio;
+     int fd;
+
+     if ((fd = open(device, O_RDWR | O_NOCTTY)) == -1)
+     {
+	  fprintf(stderr, "Error. Unable to open '%s': %s\n", device, strerror(errno));
+	  return -1;
+     }
+
+     if (tcgetattr(fd, &tio) == -1)
+     {
+	  perror("tcgetattr()");
+	  close(fd);
+	  return -1;
+     }
+
+     cfmakeraw(&tio);
+     cfsetspeed(&tio, B115200);
+
+     if (tcsetattr(fd, TCSANOW, &tio) == -1)
+     {
+	  perror("tcsetattr()");
+	  close(fd);
+	  return -1;
+     }
+
+     tcflush(fd, TCIOFLUSH);
+
+     return fd;
+}
+
+/**
+ * Read 'len' bytes, returns false on timeout
+ **/
+static bool serialRead(int fd, uint8_t *buf, size_t len)
+{
+     struct pollfd pfd = { .fd = fd, .events = POLLIN };
+
+     while (len > 0)
+     {
+	  ssize_t rlen;
+
+	  if (poll(&pfd, 1, SERIAL_TIMEOUT_MS) <= 0)
+	  {
+	       return false;
+	  }
+
+	  if ((rlen = read(fd, buf, len)) <= 0)
+	  {
+	       return false;
+	  }
+
+	  buf += rlen;
+	  len -= rlen;
+     }
+
+     return true;
+}
+
+/**
+ * Send a request and check the reply: 'W' requests are acknowledged with 'W' and the sub command, 'C' with '-'
+ **/
+static bool sendRequest(int fd, const uint8_t *request, size_t requestLength)
+{
+     uint8_t reply[2];
+
+     if (write(fd, request, requestLength) != (ssize_t)requestLength)
+     {
+	  perror("write()");
+	  return false;
+     }
+
+     if (serialRead(fd, reply, 1) == false)
+     {
+	  fprintf(stderr, "\nError. No reply from the radio\n");
+	  return false;
+     }
+
+     if (request[0] == 'W')
+     {
+	  if ((reply[0] != 'W') || (serialRead(fd, &reply[1], 1) == false) || (reply[1] != request[1]))
+	  {
+	       fprintf(stderr, "\nError. Write failed\n");
+	       return false;
+	  }
+     }
+
+     return true;
+}
+
+static bool sendCommand(int fd, uint8_t command, uint8_t x, uint8_t y, uint8_t font, uint8_t alignment, const char *text)
+{
+     uint8_t request[32];
+
+     memset(request, 0, sizeof(request));
+     request[0] = 'C';
+     request[1] = command;
+     request[2] = x;
+     request[3] = y;
+     request[4] = font;
+     request[5] = alignment;
+     request[6] = 0;
+
+     if (text != NULL)
+     {
+	  strncpy((char *)&request[7], text, sizeof(request) - 8);
+     }
+
+     return sendRequest(fd, request, sizeof(request));
+}
+
+/**
+ * Upload the image using the CPS Flash write protocol, one sector at a time:
+ * 'W' 1 selects the sector (the radio reads it into RAM), 'W' 2 transfers the data, 'W' 3 writes the sector back.
+ **/
+static int uploadImage(const char *device, const uint8_t *image, size_t imageLength)
+{
+     int    fd;
+     int    retval = -1;
+     size_t offset = 0;
+
+     if ((fd = serialOpen(device)) == -1)
+     {
+	  return -1;
+     }
+
+     // Display the CPS screen (command 0), clear it (1), add a text line (2), render (3) and light the backlight (4)
+     if ((sendCommand(fd, 0, 0, 0, 0, 0, NULL) == false) ||
+	 (sendCommand(fd, 1, 0, 0, 0, 0, NULL) == false) ||
+	 (sendCommand(fd, 2, 0, 16, 3, 1, "DMR IDs") == false) ||
+	 (sendCommand(fd, 3, 0, 0, 0, 0, NULL) == false) ||
+	 (sendCommand(fd, 4, 0, 0, 0, 0, NULL) == false))
+     {
+	  goto exit;
+     }
+
+     while (offset < imageLength)
+     {
+	  uint32_t address = DMRID_MEMORY_STORAGE_START + offset;
+	  uint32_t sector = address / FLASH_SECTOR_SIZE;
+	  size_t   sectorEnd = ((sector + 1) * FLASH_SECTOR_SIZE) - DMRID_MEMORY_STORAGE_START;
+	  uint8_t  request[8 + MAX_TRANSFER_SIZE];
+
+	  if (sectorEnd > imageLength)
+	  {
+	       sectorEnd = imageLength;
+	  }
+
+	  request[0] = 'W';
+	  request[1] = 1;
+	  request[2] = (sector >> 16) & 0xFF;
+	  request[3] = (sector >> 8) & 0xFF;
+	  request[4] = (sector >> 0) & 0xFF;
+
+	  if (sendRequest(fd, request, 5) == false)
+	  {
+	       goto exit;
+	  }
+
+	  while (offset < sectorEnd)
+	  {
+	       size_t length = sectorEnd - offset;
+
+	       if (length > MAX_TRANSFER_SIZE)
+	       {
+		    length = MAX_TRANSFER_SIZE;
+	       }
+
+	       address = DMRID_MEMORY_STORAGE_START + offset;
+	       request[0] = 'W';
+	       request[1] = 2;
+	       request[2] = (address >> 24) & 0xFF;
+	       request[3] = (address >> 16) & 0xFF;
+	       request[4] = (address >> 8) & 0xFF;
+	       request[5] = (address >> 0) & 0xFF;
+	       request[6] = (length >> 8) & 0xFF;
+	       request[7] = (length >> 0) & 0xFF;
+	       memcpy(&request[8], image + offset, length);
+
+	       if (sendRequest(fd, request, 8 + length) == false)
+	       {
+		    goto exit;
+	       }
+
+	       offset += length;
+	  }
+
+	  request[0] = 'W';
+	  request[1] = 3;
+
+	  if (sendRequest(fd, request, 2) == false)
+	  {
+	       goto exit;
+	  }
+
+	  fprintf(stdout, "\rUploading: %zu%%", (offset * 100) / imageLength);
+	  fflush(stdout);
+     }
+
+     fprintf(stdout, "\n");
+     retval = 0;
+
+exit:
+     // Close the CPS screen, the radio reloads its DMR IDs cache at this point
+     if (sendCommand(fd, 5, 0, 0, 0, 0, NULL) == false)
+     {
+	  retval = -1;
+     }
+
+     close(fd);
+
+     return retval;
+}
+
+static void usage(const char *programName)
+{
+     fprintf(stdout, "Usage: %s [OPTION] <users.csv>\n", programName);
+     fprintf(stdout, "\n");
+     fprintf(stdout, "    -h             : Display this help text,\n");
+     fprintf(stdout, "    -o <filename>  : Save the Flash image in <filename>,\n");
+     fprintf(stdout, "    -u             : Upload the Flash image to the radio,\n");
+     fprintf(stdout, "    -d <device>    : Use the specified device as serial port [default: %s],\n", DEFAULT_DEVICE);
+     fprintf(stdout, "    -n <length>    : Number of characters per ID (%d..%d) [default: %d],\n", MIN_TEXT_LENGTH, MAX_TEXT_LENGTH, DEFAULT_TEXT_LENGTH);
+     fprintf(stdout, "    -p <prefixes>  : Only store the IDs starting with one of the comma separated prefixes (e.g. 505,530),\n");
+     fprintf(stdout, "    -c             : Only store the callsign (2nd column), not the callsign and the name (3rd column),\n");
+     fprintf(stdout, "    -v             : Display the slices boundaries.\n");
+     fprintf(stdout, "\n");
+}
+
+/**
+ *
+ **/
+int main(int argc, char **argv)
+{
+     FILE       *runs[MAX_RUNS];
+     const char *outFilename = NULL;
+     const char *device = DEFAULT_DEVICE;
+     bool        upload = false;
+     bool        callsignOnly = false;
+     size_t      textLength = DEFAULT_TEXT_LENGTH;
+     size_t      numRecordsRead;
+     size_t      imageLength;
+     uint32_t    entries;
+     uint8_t    *image;
+     int         numRuns;
+     int         retval = EXIT_SUCCESS;
+     int         opt;
+
+     while ((opt = getopt(argc, argv, "ho:ud:n:p:cv")) != -1)
+     {
+	  switch (opt)
+	  {
+	  case 'o':
+	       outFilename = optarg;
+	       break;
+	  case 'u':
+	       upload = true;
+	       break;
+	  case 'd':
+	       device = optarg;
+	       break;
+	  case 'n':
+	       textLength = strtoul(optarg, NULL, 10);
+	       if ((textLength < MIN_TEXT_LENGTH) || (textLength > MAX_TEXT_LENGTH))
+	       {
+		    fprintf(stderr, "Error. The number of characters must be between %d and %d\n", MIN_TEXT_LENGTH, MAX_TEXT_LENGTH);
+		    return EXIT_FAILURE;
+	       }
+	       break;
+	  case 'p':
+	       if (parsePrefixes(optarg) == false)
+	       {
+		    fprintf(stderr, "Error. Invalid ID prefixes list '%s'\n", optarg);
+		    return EXIT_FAILURE;
+	       }
+	       break;
+	  case 'c':
+	       callsignOnly = true;
+	       break;
+	  case 'v':
+	       verbose = true;
+	       break;
+	  case 'h':
+	  default:
+	       usage(argv[0]);
+	       return ((opt == 'h') ? EXIT_SUCCESS : EXIT_FAILURE);
+	  }
+     }
+
+     if ((optind >= argc) || ((outFilename == NULL) && (upload == false)))
+     {
+	  usage(argv[0]);
+	  return EXIT_FAILURE;
+     }
+
+     if ((numRuns = createSortedRuns(argv[optind], runs, textLength, callsignOnly, &numRecordsRead)) < 0)
+     {
+	  return EXIT_FAILURE;
+     }
+
+     if ((image = calloc(DMRID_MEMORY_STORAGE_MAX_SIZE, sizeof(uint8_t))) == NULL)
+     {
+	  perror("calloc()");
+	  return EXIT_FAILURE;
+     }
+
+     imageLength = mergeRunsIntoImage(runs, numRuns, image, textLength, &entries);
+
+     for (int i = 0; i < numRuns; i++)
+     {
+	  fclose(runs[i]);
+     }
+
+     if (imageLength == 0)
+     {
+	  free(image);
+	  return EXIT_FAILURE;
+     }
+
+     fprintf(stdout, "%zu IDs read, %u IDs stored (%zu bytes)\n", numRecordsRead, entries, imageLength);
+
+     if (verbose)
+     {
+	  displaySlices(image, entries, textLength + 4);
+     }
+
+     if ((outFilename != NULL) && (saveImageToFile(outFilename, image, imageLength) != 0))
+     {
+	  retval = EXIT_FAILURE;
+     }
+
+     if ((retval == EXIT_SUCCESS) && upload && (uploadImage(device, image, imageLength) != 0))
+     {
+	  retval = EXIT_FAILURE;
+     }
+
+     free(image);
+
+     return retval;
+}
@@ -0,0 +1,851 @@
+/* -*- mode: c; c-file-style: "k&r"; compile-command: "gcc -Wall -O2 -s -pthread -o multi_radio_programmer multi_radio_programmer.c"; -*- */
+
+/*
+ * Multi radio programmer: writes the same codeplug, DMR IDs database and settings to every
+ * connected OpenGD77 radio at once, then verifies them by reading them back.
+ *
+ * Copyright (C)2019 Roger Clark. VK3KYY
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *   1. Redistributions of source code must retain the above copyright notice,
+ *      this list of conditions and the following disclaimer.
+ *   2. Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer in the
+ *      documentation and/or other materials provided with the distribution.
+ *   3. The name of the author may not be used to endorse or promote products
+ *      derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR IMPLIED
+ * WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO
+ * EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ * ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+//
+// Each radio is handled by its own thread, using the CPS USB protocol (see handleCPSRequest() in usb_com.c):
+//
+//   'R' area address(32) length(16)             -> 'R' length(16) data    (area 1: Flash, 2: EEPROM)
+//   'W' 1 sector(24)                            -> 'W' 1                  (the Flash sector is read into RAM)
+//   'W' 2 address(32) length(16) data           -> 'W' 2                  (data is copied in the RAM sector)
+//   'W' 3                                       -> 'W' 3                  (the RAM sector is written back)
+//   'W' 4 address(32) length(16) data           -> 'W' 4                  (EEPROM write)
+//   'C' command ...                             -> '-'
+//
+// Transfers are limited to 32 bytes. The firmware only buffers a single request (another request received
+// while one is being handled is rejected with '-'), so requests can't be pipelined on one radio: the
+// throughput comes from programming all the radios in parallel.
+//
+// Codeplug files are the 128KB CPS images: 0x00E0-0x6000 and 0x7500-0xB000 are stored in the EEPROM,
+// 0xB000-0x1EE60 in the Flash, at 0x7B000 onwards.
+//
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <errno.h>
+#include <glob.h>
+#include <limits.h>
+#include <poll.h>
+#include <pthread.h>
+#include <termios.h>
+#include <time.h>
+#include <sys/stat.h>
+
+#define OPENGD77_USB_VID                "1fc9"
+#define OPENGD77_USB_PID                "0094"
+
+#define MAX_DEVICES                     64
+#define MAX_REGIONS                     8
+
+#define CODEPLUG_FILE_SIZE              0x20000
+#define CODEPLUG_FLASH_OFFSET           0x70000
+#define DMRID_MEMORY_STORAGE_START      0x30000
+#define DMRID_MEMORY_STORAGE_MAX_SIZE   0x40000
+#define SETTINGS_EEPROM_ADDRESS         0x6000
+#define SETTINGS_MAX_SIZE               0x1500
+
+#define FLASH_SECTOR_SIZE               4096
+#define MAX_TRANSFER_SIZE               32
+#define SERIAL_TIMEOUT_MS               2000
+#define MAX_RETRIES                     3
+
+typedef enum
+{
+     AREA_FLASH = 1,
+     AREA_EEPROM = 2
+} memoryArea_t;
+
+typedef struct
+{
+     const char    *name;
+     memoryArea_t   area;
+     uint32_t       address;
+     const uint8_t *data;
+     size_t         length;
+     uint32_t       crc;
+} region_t;
+
+typedef struct
+{
+     char           device[PATH_MAX];
+     pthread_t      thread;
+     bool           threadStarted;
+     int            fd;
+     bool           success;
+     char           error[128];
+     size_t         bytesWritten;
+     size_t         bytesVerified;
+     double         writeTime;
+     double         verifyTime;
+     unsigned int   retries;
+} radio_t;
+
+static region_t regions[MAX_REGIONS];
+static int      numRegions = 0;
+static radio_t  radios[MAX_DEVICES];
+static int      numRadios = 0;
+static bool     settingsWritten = false;
+static bool     noReboot = false;
+
+static pthread_mutex_t outputMutex = PTHREAD_MUTEX_INITIALIZER;
+
+
+/**
+ * Standard CRC-32 (IEEE 802.3)
+ **/
+static uint32_t crc32Update(uint32_t crc, const uint8_t *data, size_t length)
+{
+     crc = ~crc;
+
+     while (length--)
+     {
+	  crc ^= *data++;
+
+	  for (int i = 0; i < 8; i++)
+	  {
+	       crc = (crc >> 1) ^ (0xEDB88320 & (-(crc & 1)));
+	  }
+     }
+
+     return ~crc;
+}
+
+static double getTime(void)
+{
+     struct timespec ts;
+
+     clock_gettime(CLOCK_MONOTONIC, &ts);
+
+     return (ts.tv_sec + (ts.tv_nsec / 1e9));
+}
+
+static void radioLog(radio_t *radio, const char *message)
+{
+     pthread_mutex_lock(&outputMutex);
+     fprintf(stdout, "%s: %s\n", radio->device, message);
+     fflush(stdout);
+     pthread_mutex_unlock(&outputMutex);
+}
+
+static bool radioFail(radio_t *radio, const char *error)
+{
+     snprintf(radio->error, sizeof(radio->error), "%s", error);
+     radio->success = false;
+
+     return false;
+}
+
+/**
+ * Load a whole file, returns NULL on error
+ **/
+static uint8_t *loadFile(const char *filename, size_t *length)
+{
+     struct stat statBuf;
+     uint8_t    *buffer;
+     FILE       *inFile;
+
+     if ((stat(filename, &statBuf) == -1) || (statBuf.st_size == 0))
+     {
+	  fprintf(stderr, "Error. Unable to open the file '%s'\n", filename);
+	  return NULL;
+     }
+
+     if ((buffer = malloc(statBuf.st_size)) == NULL)
+     {
+	  perror("malloc()");
+	  return NULL;
+     }
+
+     if (((inFile = fopen(filename, "rb")) == NULL) || (fread(buffer, 1, statBuf.st_size, inFile) != (size_t)statBuf.st_size))
+     {
+	  fprintf(stderr, "Error. Unable to read the file '%s'\n", filename);
+
+	  if (inFile != NULL)
+	  {
+	       fclose(inFile);
+	  }
+	  free(buffer);
+	  return NULL;
+     }
+
+     fclose(inFile);
+     *length = statBuf.st_size;
+
+     return buffer;
+}
+
+static void addRegion(const char *name, memoryArea_t area, uint32_t address, const uint8_t *data, size_t length)
+{
+     region_t *region = &regions[numRegions++];
+
+     region->name = name;
+     region->area = area;
+     region->address = address;
+     region->data = data;
+     region->length = length;
+     region->crc = crc32Update(0, data, length);
+}
+
+static bool addCodeplug(const char *filename)
+{
+     uint8_t *codeplug;
+     size_t   length;
+
+     if ((codeplug = loadFile(filename, &length)) == NULL)
+     {
+	  return false;
+     }
+
+     if (length != CODEPLUG_FILE_SIZE)
+     {
+	  fprintf(stderr, "Error. '%s' is not a codeplug file (%zu bytes instead of %d)\n", filename, length, CODEPLUG_FILE_SIZE);
+	  free(codeplug);
+	  return false;
+     }
+
+     addRegion("codeplug (EEPROM 1)", AREA_EEPROM, 0x00E0, codeplug + 0x00E0, 0x6000 - 0x00E0);
+     addRegion("codeplug (EEPROM 2)", AREA_EEPROM, 0x7500, codeplug + 0x7500, 0xB000 - 0x7500);
+     addRegion("codeplug (Flash)", AREA_FLASH, 0xB000 + CODEPLUG_FLASH_OFFSET, codeplug + 0xB000, 0x1EE60 - 0xB000);
+
+     return true;
+}
+
+static bool addDMRIDs(const char *filename)
+{
+     uint8_t *image;
+     size_t   length;
+
+     if ((image = loadFile(filename, &length)) == NULL)
+     {
+	  return false;
+     }
+
+     if ((length < 12) || (length > DMRID_MEMORY_STORAGE_MAX_SIZE) || (image[0] != 'I') || (image[1] != 'D') || (image[2] != '-'))
+     {
+	  fprintf(stderr, "Error. '%s' is not a DMR IDs database image\n", filename);
+	  free(image);
+	  return false;
+     }
+
+     addRegion("DMR IDs", AREA_FLASH, DMRID_MEMORY_STORAGE_START, image, length);
+
+     return true;
+}
+
+static bool addSettings(const char *filename)
+{
+     uint8_t *settings;
+     size_t   length;
+
+     if ((settings = loadFile(filename, &length)) == NULL)
+     {
+	  return false;
+     }
+
+     if (length > SETTINGS_MAX_SIZE)
+     {
+	  fprintf(stderr, "Error. '%s' is not a settings file\n", filename);
+	  free(settings);
+	  return false;
+     }
+
+     addRegion("settings", AREA_EEPROM, SETTINGS_EEPROM_ADDRESS, settings, length);
+     settingsWritten = true;
+
+     return true;
+}
+
+/**
+ * Check the USB IDs of the ttyACM device, in sysfs
+ **/
+static bool isOpenGD77Device(const char *device)
+{
+     char path[PATH_MAX];
+     char value[16];
+     bool vidMatch = false;
+     bool pidMatch = false;
+     FILE *f;
+
+     snprintf(path, sizeof(path), "/sys/class/tty/%s/device/../idVendor", strrchr(device, '/') + 1);
+     if ((f = fopen(path, "r")) != NULL)
+     {
+	  vidMatch = ((fgets(value, sizeof(value), f) != NULL) && (strncmp(value, OPENGD77_USB_VID, 4) == 0));
+	  fclose(f);
+     }
+
+     snprintf(path, sizeof(path), "/sys/class/tty/%s/device/../idProduct", strrchr(device, '/') + 1);
+     if ((f = fopen(path, "r")) != NULL)
+     {
+	  pidMatch = ((fgets(value, sizeof(value), f) != NULL) && (strncmp(value, OPENGD77_USB_PID, 4) == 0));
+	  fclose(f);
+     }
+
+     return (vidMatch && pidMatch);
+}
+
+static void addRadio(const char *device)
+{
+     if (numRadios == MAX_DEVICES)
+     {
+	  fprintf(stderr, "Warning. Too many radios, '%s' is ignored\n", device);
+	  return;
+     }
+
+     memset(&radios[numRadios], 0, sizeof(radio_t));
+     snprintf(radios[numRadios].device, sizeof(radios[numRadios].device), "%s", device);
+     radios[numRadios].fd = -1;
+     numRadios++;
+}
+
+static void discoverRadios(void)
+{
+     glob_t globBuf;
+
+     if (glob("/dev/ttyACM*", 0, NULL, &globBuf) != 0)
+     {
+	  return;
+     }
+
+     for (size_t i = 0; i < globBuf.gl_pathc; i++)
+     {
+	  if (isOpenGD77Device(globBuf.gl_pathv[i]))
+	  {
+	       addRadio(globBuf.gl_pathv[i]);
+	  }
+     }
+
+     globfree(&globBuf);
+}
+
+static int serialOpen(const char *device)
+{
+     struct termios tio;
+     int fd;
+
+     if ((fd = open(device, O_RDWR | O_NOCTTY)) == -1)
+     {
+	  return -1;
+     }
+
+     if (tcgetattr(fd, &tio) == -1)
+     {
+	  close(fd);
+	  return -1;
+     }
+
+     cfmakeraw(&tio);
+     cfsetspeed(&tio, B115200);
+
+     if (tcsetattr(fd, TCSANOW, &tio) == -1)
+     {
+	  close(fd);
+	  return -1;
+     }
+
+     tcflush(fd, TCIOFLUSH);
+
+     return fd;
+}
+
+/**
+ * Read 'len' bytes, returns false on timeout
+ **/
+static bool serialRead(int fd, uint8_t *buf, size_t len)
+{
+     struct pollfd pfd = { .fd = fd, .events = POLLIN };
+
+     while (len > 0)
+     {
+	  ssize_t rlen;
+
+	  if (poll(&pfd, 1, SERIAL_TIMEOUT_MS) <= 0)
+	  {
+	       return false;
+	  }
+
+	  if ((rlen = read(fd, buf, len)) <= 0)
+	  {
+	       return false;
+	  }
+
+	  buf += rlen;
+	  len -= rlen;
+     }
+
+     return true;
+}
+
+/**
+ * Send a request and read its reply. A '-' reply, or a reply which doesn't match, is a failure.
+ * 'reply' has to be large enough for the expected reply (2 bytes for 'W', 3 + length for 'R', 1 for 'C').
+ **/
+static bool transaction(radio_t *radio, const uint8_t *request, size_t requestLength, uint8_t *reply, size_t *replyLength)
+{
+     if (write(radio->fd, request, requestLength) != (ssize_t)requestLength)
+     {
+	  return false;
+     }
+
+     if (serialRead(radio->fd, reply, 1) == false)
+     {
+	  return false;
+     }
+
+     switch (request[0])
+     {
+     case 'R':
+	  if ((reply[0] != 'R') || (serialRead(radio->fd, &reply[1], 2) == false))
+	  {
+	       return false;
+	  }
+
+	  *replyLength = (reply[1] << 8) | reply[2];
+
+	  return ((*replyLength <= MAX_TRANSFER_SIZE) && serialRead(radio->fd, &reply[3], *replyLength));
+
+     case 'W':
+	  return ((reply[0] == 'W') && serialRead(radio->fd, &reply[1], 1) && (reply[1] == request[1]));
+
+     default:
+	  return (reply[0] == '-');
+     }
+}
+
+/**
+ * Requests are retried, as a request can be rejected if the radio is still busy with the previous one.
+ * Retrying is harmless, as all the requests are idempotent.
+ **/
+static bool request(radio_t *radio, const uint8_t *request, size_t requestLength, uint8_t *reply, size_t *replyLength)
+{
+     for (int i = 0; i < MAX_RETRIES; i++)
+     {
+	  if (transaction(radio, request, requestLength, reply, replyLength))
+	  {
+	       return true;
+	  }
+
+	  radio->retries++;
+
+	  // Flush any late reply
+	  usleep(100000);
+	  tcflush(radio->fd, TCIOFLUSH);
+     }
+
+     return false;
+}
+
+static bool sendCommand(radio_t *radio, uint8_t command, uint8_t x, uint8_t y, uint8_t font, uint8_t alignment, const char *text)
+{
+     uint8_t commandBuf[32];
+     uint8_t reply[4];
+     size_t  replyLength;
+
+     memset(commandBuf, 0, sizeof(commandBuf));
+     commandBuf[0] = 'C';
+     commandBuf[1] = command;
+     commandBuf[2] = x;
+     commandBuf[3] = y;
+     commandBuf[4] = font;
+     commandBuf[5] = alignment;
+
+     if (text != NULL)
+     {
+	  strncpy((char *)&commandBuf[7], text, sizeof(commandBuf) - 8);
+     }
+
+     return request(radio, commandBuf, sizeof(commandBuf), reply, &replyLength);
+}
+
+static bool displayMessage(radio_t *radio, const char *message)
+{
+     // Clear the CPS screen (1), add a text line (2), render (3)
+     return (sendCommand(radio, 1, 0, 0, 0, 0, NULL) &&
+	     sendCommand(radio, 2, 0, 16, 3, 1, message) &&
+	     sendCommand(radio, 3, 0, 0, 0, 0, NULL));
+}
+
+static bool writeEEPROMRegion(radio_t *radio, const region_t *region)
+{
+     uint8_t requestBuf[8 + MAX_TRANSFER_SIZE];
+     uint8_t reply[4];
+     size_t  replyLength;
+
+     for (size_t offset = 0; offset < region->length; offset += MAX_TRANSFER_SIZE)
+     {
+	  uint32_t address = region->address + offset;
+	  size_t   length = (((region->length - offset) > MAX_TRANSFER_SIZE) ? MAX_TRANSFER_SIZE : (region->length - offset));
+
+	  requestBuf[0] = 'W';
+	  requestBuf[1] = 4;
+	  requestBuf[2] = (address >> 24) & 0xFF;
+	  requestBuf[3] = (address >> 16) & 0xFF;
+	  requestBuf[4] = (address >> 8) & 0xFF;
+	  requestBuf[5] = (address >> 0) & 0xFF;
+	  requestBuf[6] = (length >> 8) & 0xFF;
+	  requestBuf[7] = (length >> 0) & 0xFF;
+	  memcpy(&requestBuf[8], region->data + offset, length);
+
+	  if (request(radio, requestBuf, 8 + length, reply, &replyLength) == false)
+	  {
+	       return false;
+	  }
+
+	  radio->bytesWritten += length;
+     }
+
+     return true;
+}
+
+static bool writeFlashRegion(radio_t *radio, const region_t *region)
+{
+     uint8_t requestBuf[8 + MAX_TRANSFER_SIZE];
+     uint8_t reply[4];
+     size_t  replyLength;
+     size_t  offset = 0;
+
+     while (offset < region->length)
+     {
+	  uint32_t sector = (region->address + offset) / FLASH_SECTOR_SIZE;
+	  size_t   sectorEnd = ((sector + 1) * FLASH_SECTOR_SIZE) - region->address;
+
+	  if (sectorEnd > region->length)
+	  {
+	       sectorEnd = region->length;
+	  }
+
+	  requestBuf[0] = 'W';
+	  requestBuf[1] = 1;
+	  requestBuf[2] = (sector >> 16) & 0xFF;
+	  requestBuf[3] = (sector >> 8) & 0xFF;
+	  requestBuf[4] = (sector >> 0) & 0xFF;
+
+	  if (request(radio, requestBuf, 5, reply, &replyLength) == false)
+	  {
+	       return false;
+	  }
+
+	  while (offset < sectorEnd)
+	  {
+	       uint32_t address = region->address + offset;
+	       size_t   length = (((sectorEnd - offset) > MAX_TRANSFER_SIZE) ? MAX_TRANSFER_SIZE : (sectorEnd - offset));
+
+	       requestBuf[0] = 'W';
+	       requestBuf[1] = 2;
+	       requestBuf[2] = (address >> 24) & 0xFF;
+	       requestBuf[3] = (address >> 16) & 0xFF;
+	       requestBuf[4] = (address >> 8) & 0xFF;
+	       requestBuf[5] = (address >> 0) & 0xFF;
+	       requestBuf[6] = (length >> 8) & 0xFF;
+	       requestBuf[7] = (length >> 0) & 0xFF;
+	       memcpy(&requestBuf[8], region->data + offset, length);
+
+	       if (request(radio, requestBuf, 8 + length, reply, &replyLength) == false)
+	       {
+		    return false;
+	       }
+
+	       offset += length;
+	       radio->bytesWritten += length;
+	  }
+
+	  requestBuf[0] = 'W';
+	  requestBuf[1] = 3;
+
+	  if (request(radio, requestBuf, 2, reply, &replyLength) == false)
+	  {
+	       return false;
+	  }
+     }
+
+     return true;
+}
+
+/**
+ * Read the region back, and compare its CRC with the one of the file data
+ **/
+static bool verifyRegion(radio_t *radio, const region_t *region)
+{
+     uint8_t  requestBuf[8];
+     uint8_t  reply[3 + MAX_TRANSFER_SIZE];
+     size_t   replyLength;
+     uint32_t crc = 0;
+
+     for (size_t offset = 0; offset < region->length; offset += replyLength)
+     {
+	  uint32_t address = region->address + offset;
+	  size_t   length = (((region->length - offset) > MAX_TRANSFER_SIZE) ? MAX_TRANSFER_SIZE : (region->length - offset));
+
+	  requestBuf[0] = 'R';
+	  requestBuf[1] = region->area;
+	  requestBuf[2] = (address >> 24) & 0xFF;
+	  requestBuf[3] = (address >> 16) & 0xFF;
+	  requestBuf[4] = (address >> 8) & 0xFF;
+	  requestBuf[5] = (address >> 0) & 0xFF;
+	  requestBuf[6] = (length >> 8) & 0xFF;
+	  requestBuf[7] = (length >> 0) & 0xFF;
+
+	  if ((request(radio, requestBuf, sizeof(requestBuf), reply, &replyLength) == false) || (replyLength != length))
+	  {
+	       return false;
+	  }
+
+	  crc = crc32Update(crc, &reply[3], replyLength);
+	  radio->bytesVerified += replyLength;
+     }
+
+     return (crc == region->crc);
+}
+
+static void *programRadio(void *arg)
+{
+     radio_t *radio = (radio_t *)arg;
+     char     message[128];
+     double   startTime;
+
+     radio->success = true;
+
+     if ((radio->fd = serialOpen(radio->device)) == -1)
+     {
+	  radioFail(radio, strerror(errno));
+	  return NULL;
+     }
+
+     // Display the CPS screen (0) and light the backlight (4)
+     if ((sendCommand(radio, 0, 0, 0, 0, 0, NULL) == false) || (sendCommand(radio, 4, 0, 0, 0, 0, NULL) == false))
+     {
+	  radioFail(radio, "no reply");
+	  goto exit;
+     }
+
+     startTime = getTime();
+     for (int i = 0; i < numRegions; i++)
+     {
+	  snprintf(message, sizeof(message), "writing %s", regions[i].name);
+	  radioLog(radio, message);
+	  displayMessage(radio, "Writing");
+
+	  if (((regions[i].area == AREA_FLASH) ? writeFlashRegion(radio, &regions[i]) : writeEEPROMRegion(radio, &regions[i])) == false)
+	  {
+	       snprintf(message, sizeof(message), "write of %s failed", regions[i].name);
+	       radioFail(radio, message);
+	       goto exit;
+	  }
+     }
+     radio->writeTime = getTime() - startTime;
+
+     startTime = getTime();
+     for (int i = 0; i < numRegions; i++)
+     {
+	  snprintf(message, sizeof(message), "verifying %s", regions[i].name);
+	  radioLog(radio, message);
+	  displayMessage(radio, "Verifying");
+
+	  if (verifyRegion(radio, &regions[i]) == false)
+	  {
+	       snprintf(message, sizeof(message), "verification of %s failed", regions[i].name);
+	       radioFail(radio, message);
+	       goto exit;
+	  }
+     }
+     radio->verifyTime = getTime() - startTime;
+
+exit:
+     if (radio->success && (noReboot == false))
+     {
+	  uint8_t rebootCommand[32] = { 'C', 6, (settingsWritten ? 1 : 0) };
+
+	  // Close the CPS screen (5), then reboot without saving the settings (6 1) if they have been written,
+	  // as the radio would overwrite them with the ones in RAM, otherwise save them and reboot (6 0).
+	  // The radio doesn't reply to the reboot command.
+	  sendCommand(radio, 5, 0, 0, 0, 0, NULL);
+	  if (write(radio->fd, rebootCommand, sizeof(rebootCommand)) != sizeof(rebootCommand))
+	  {
+	       radioFail(radio, "reboot failed");
+	  }
+     }
+     else
+     {
+	  // Leave the result on the CPS screen, and flash the green (6 3) or red (6 4) LED
+	  displayMessage(radio, (radio->success ? "Done" : "Failed"));
+	  sendCommand(radio, 6, (radio->success ? 3 : 4), 0, 0, 0, NULL);
+     }
+
+     radioLog(radio, (radio->success ? "done" : radio->error));
+
+     close(radio->fd);
+     radio->fd = -1;
+
+     return NULL;
+}
+
+static void printReport(double totalTime)
+{
+     int failures = 0;
+
+     fprintf(stdout, "\n%-20s %-8s %10s %12s %12s %8s\n", "Device", "Status", "Written", "Write KB/s", "Verify KB/s", "Retries");
+
+     for (int i = 0; i < numRadios; i++)
+     {
+	  radio_t *radio = &radios[i];
+
+	  fprintf(stdout, "%-20s %-8s %10zu %12.2f %12.2f %8u%s%s\n", radio->device, (radio->success ? "OK" : "FAILED"),
+		  radio->bytesWritten,
+		  ((radio->writeTime > 0) ? ((radio->bytesWritten / 1024.0) / radio->writeTime) : 0.0),
+		  ((radio->verifyTime > 0) ? ((radio->bytesVerified / 1024.0) / radio->verifyTime) : 0.0),
+		  radio->retries,
+		  (radio->success ? "" : "  "), (radio->success ? "" : radio->error));
+
+	  if (radio->success == false)
+	  {
+	       failures++;
+	  }
+     }
+
+     fprintf(stdout, "\n%d radio(s) programmed, %d failure(s), in %.1f seconds\n", numRadios - failures, failures, totalTime);
+}
+
+static void usage(const char *programName)
+{
+     fprintf(stdout, "Usage: %s [OPTION]\n", programName);
+     fprintf(stdout, "\n");
+     fprintf(stdout, "    -h             : Display this help text,\n");
+     fprintf(stdout, "    -c <filename>  : Write the codeplug file (128KB CPS image),\n");
+     fprintf(stdout, "    -i <filename>  : Write the DMR IDs database image,\n");
+     fprintf(stdout, "    -s <filename>  : Write the settings (EEPROM 0x%04X) file,\n", SETTINGS_EEPROM_ADDRESS);
+     fprintf(stdout, "    -d <device>    : Only program the specified device (can be repeated) [default: all OpenGD77 radios],\n");
+     fprintf(stdout, "    -n             : Don't reboot the radios once programmed, leave the result on their screen.\n");
+     fprintf(stdout, "\n");
+}
+
+/**
+ *
+ **/
+int main(int argc, char **argv)
+{
+     double startTime;
+     int    opt;
+
+     while ((opt = getopt(argc, argv, "hc:i:s:d:n")) != -1)
+     {
+	  if ((numRegions > (MAX_REGIONS - 3)) && ((opt == 'c') || (opt == 'i') || (opt == 's')))
+	  {
+	       fprintf(stderr, "Error. Too many files\n");
+	       return EXIT_FAILURE;
+	  }
+
+	  switch (opt)
+	  {
+	  case 'c':
+	       if (addCodeplug(optarg) == false)
+	       {
+		    return EXIT_FAILURE;
+	       }
+	       break;
+	  case 'i':
+	       if (addDMRIDs(optarg) == false)
+	       {
+		    return EXIT_FAILURE;
+	       }
+	       break;
+	  case 's':
+	       if (addSettings(optarg) == false)
+	       {
+		    return EXIT_FAILURE;
+	       }
+	       break;
+	  case 'd':
+	       addRadio(optarg);
+	       break;
+	  case 'n':
+	       noReboot = true;
+	       break;
+	  case 'h':
+	  default:
+	       usage(argv[0]);
+	       return ((opt == 'h') ? EXIT_SUCCESS : EXIT_FAILURE);
+	  }
+     }
+
+     if (numRegions == 0)
+     {
+	  usage(argv[0]);
+	  return EXIT_FAILURE;
+     }
+
+     if (numRadios == 0)
+     {
+	  discoverRadios();
+
+	  if (numRadios == 0)
+	  {
+	       fprintf(stderr, "Error. No OpenGD77 radio found\n");
+	       return EXIT_FAILURE;
+	  }
+     }
+
+     fprintf(stdout, "Programming %d radio(s)\n", numRadios);
+
+     startTime = getTime();
+
+     for (int i = 0; i < numRadios; i++)
+     {
+	  radios[i].threadStarted = (pthread_create(&radios[i].thread, NULL, programRadio, &radios[i]) == 0);
+
+	  if (radios[i].threadStarted == false)
+	  {
+	       radioFail(&radios[i], "unable to create the thread");
+	  }
+     }
+
+     for (int i = 0; i < numRadios; i++)
+     {
+	  if (radios[i].threadStarted)
+	  {
+	       pthread_join(radios[i].thread, NULL);
+	  }
+     }
+
+     printReport(getTime() - startTime);
+
+     for (int i = 0; i < numRadios; i++)
+     {
+	  if (radios[i].success == false)
+	  {
+	       return EXIT_FAILURE;
+	  }
+     }
+
+     return EXIT_SUCCESS;
+}
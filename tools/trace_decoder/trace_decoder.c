@@ -0,0 +1,452 @@
+/* -*- mode: c; c-file-style: "k&r"; compile-command: "gcc -Wall -O2 -s -o trace_decoder trace_decoder.c"; -*- */
+
+/*
+ * Trace decoder: prints the binary event trace of the OpenGD77 firmware (see trace.c) as a timeline,
+ * either streamed live from the radio over USB, or from a dump of the RTT trace channel.
+ *
+ * Copyright (C)2019 Roger Clark. VK3KYY
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *   1. Redistributions of source code must retain the above copyright notice,
+ *      this list of conditions and the following disclaimer.
+ *   2. Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer in the
+ *      documentation and/or other materials provided with the distribution.
+ *   3. The name of the author may not be used to endorse or promote products
+ *      derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR IMPLIED
+ * WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO
+ * EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ * ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+//
+// Each record is 16 bytes, little endian (see traceRecord_t in trace.h):
+//
+//   timestamp(32, PITCounter, 0.1mS) eventId(16) sequence(16) arg1(32) arg2(32)
+//
+// USB: the stream is started with 'C' 8 1 (reply '-') and stopped with 'C' 8 0. The records are then sent
+// in packets: 'T' number_of_records(8) records, with 1 to 8 records per packet.
+// The reply is '!' when the radio is streaming its screen, as both streams can't share the USB link.
+//
+// RTT: the records are written as they are to the up channel 1 ("Trace"), e.g. JLinkRTTLogger -RTTChannel 1 trace.bin
+//
+// The sequence is the low 16 bits of the record number, a gap means the records were lost between the ring and the host.
+//
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <errno.h>
+#include <signal.h>
+#include <termios.h>
+
+#define DEFAULT_DEVICE     "/dev/ttyACM0"
+#define RECORD_SIZE        16
+#define MAX_PACKET_RECORDS 8// TRACE_STREAM_MAX_RECORDS in usb_com.c
+
+// Must match traceEventId_t in trace.h
+enum
+{
+     TRACE_EVENT_OVERFLOW = 1,
+     TRACE_EVENT_DMR_SYS_INT,
+     TRACE_EVENT_DMR_SEND_REJECTED,
+     TRACE_EVENT_DMR_SEND_START,
+     TRACE_EVENT_DMR_SEND_END,
+     TRACE_EVENT_DMR_RX_DATA,
+     TRACE_EVENT_DMR_RX_STOP,
+     TRACE_EVENT_DMR_ABNORMAL_EXIT,
+     TRACE_EVENT_DMR_TIMESLOT,
+     TRACE_EVENT_DMR_RX_ISR,
+     TRACE_EVENT_DMR_TX_ISR,
+     TRACE_EVENT_CODEC_ENCODE,
+     TRACE_EVENT_CODEC_DECODE,
+     NUM_TRACE_EVENTS
+};
+
+static const char *eventNames[NUM_TRACE_EVENTS] =
+{
+     [0]                             = "?",
+     [TRACE_EVENT_OVERFLOW]          = "OVERFLOW",
+     [TRACE_EVENT_DMR_SYS_INT]       = "DMR_SYS_INT",
+     [TRACE_EVENT_DMR_SEND_REJECTED] = "DMR_SEND_REJECTED",
+     [TRACE_EVENT_DMR_SEND_START]    = "DMR_SEND_START",
+     [TRACE_EVENT_DMR_SEND_END]      = "DMR_SEND_END",
+     [TRACE_EVENT_DMR_RX_DATA]       = "DMR_RX_DATA",
+     [TRACE_EVENT_DMR_RX_STOP]       = "DMR_RX_STOP",
+     [TRACE_EVENT_DMR_ABNORMAL_EXIT] = "DMR_ABNORMAL_EXIT",
+     [TRACE_EVENT_DMR_TIMESLOT]      = "DMR_TIMESLOT",
+     [TRACE_EVENT_DMR_RX_ISR]        = "DMR_RX_ISR",
+     [TRACE_EVENT_DMR_TX_ISR]        = "DMR_TX_ISR",
+     [TRACE_EVENT_CODEC_ENCODE]      = "CODEC_ENCODE",
+     [TRACE_EVENT_CODEC_DECODE]      = "CODEC_DECODE"
+};
+
+typedef struct
+{
+     uint32_t timestamp;
+     uint16_t eventId;
+     uint16_t sequence;
+     uint32_t arg1;
+     uint32_t arg2;
+} traceRecord_t;
+
+static volatile sig_atomic_t stopRequested = 0;
+
+static bool     havePrevious = false;
+static bool     haveSequence = false;
+static uint32_t firstTimestamp;
+static uint32_t previousTimestamp;
+static uint16_t expectedSequence;
+static unsigned long numRecords = 0;
+static unsigned long numLost = 0;
+static unsigned long numBadPackets = 0;
+
+
+static void signalHandler(int sig)
+{
+     (void)sig;
+     stopRequested = 1;
+}
+
+static uint32_t get32(const uint8_t *p)
+{
+     return (p[0] | (p[1] << 8) | (p[2] << 16) | ((uint32_t)p[3] << 24));
+}
+
+static uint16_t get16(const uint8_t *p)
+{
+     return (p[0] | (p[1] << 8));
+}
+
+static void unpackRecord(const uint8_t *buf, traceRecord_t *record)
+{
+     record->timestamp = get32(&buf[0]);
+     record->eventId = get16(&buf[4]);
+     record->sequence = get16(&buf[6]);
+     record->arg1 = get32(&buf[8]);
+     record->arg2 = get32(&buf[12]);
+}
+
+static void decodeArgs(const traceRecord_t *record, char *text, size_t size)
+{
+     switch (record->eventId)
+     {
+     case TRACE_EVENT_OVERFLOW:
+	  snprintf(text, size, "%u records lost in the ring", record->arg1);
+	  break;
+     case TRACE_EVENT_DMR_SYS_INT:
+	  snprintf(text, size, "flags:0x%02X slot_state:%u", record->arg1, record->arg2);
+	  break;
+     case TRACE_EVENT_DMR_SEND_START:
+	  snprintf(text, size, "0x84:0x%02X", record->arg1);
+	  break;
+     case TRACE_EVENT_DMR_RX_DATA:
+	  snprintf(text, size, "type:%u sync:%u crc:%s rpi:%u cc:%u timecode:%u",
+		   record->arg1 & 0xFF, (record->arg1 >> 8) & 0xFF, ((record->arg1 >> 16) & 0xFF) ? "ok" : "bad",
+		   (record->arg1 >> 24) & 0xFF, record->arg2 & 0xFF, (record->arg2 >> 8) & 0xFF);
+	  break;
+     case TRACE_EVENT_DMR_RX_STOP:
+	  snprintf(text, size, "timecode:%u", record->arg1);
+	  break;
+     case TRACE_EVENT_DMR_ABNORMAL_EXIT:
+	  snprintf(text, size, "0x98:0x%02X", record->arg1);
+	  break;
+     case TRACE_EVENT_DMR_TIMESLOT:
+	  snprintf(text, size, "slot_state:%u timecode:%u", record->arg1, record->arg2);
+	  break;
+     case TRACE_EVENT_CODEC_ENCODE:
+	  snprintf(text, size, "wavbuffer_count:%u", record->arg1);
+	  break;
+     case TRACE_EVENT_CODEC_DECODE:
+	  snprintf(text, size, "wavbuffer_count:%u bit_errors:%u", record->arg1, record->arg2);
+	  break;
+     case TRACE_EVENT_DMR_SEND_REJECTED:
+     case TRACE_EVENT_DMR_SEND_END:
+     case TRACE_EVENT_DMR_RX_ISR:
+     case TRACE_EVENT_DMR_TX_ISR:
+	  text[0] = 0;
+	  break;
+     default:
+	  snprintf(text, size, "0x%08X 0x%08X", record->arg1, record->arg2);
+	  break;
+     }
+}
+
+/**
+ * Print one line of the timeline: time since the first record, time since the previous record, event and its arguments.
+ **/
+static void printRecord(const traceRecord_t *record)
+{
+     char     args[128];
+     uint32_t delta;
+
+     if (record->eventId == TRACE_EVENT_OVERFLOW)
+     {
+	  // Not a real record, it has no sequence. The next record follows the skipped ones
+	  numLost += record->arg1;
+	  haveSequence = false;
+     }
+     else
+     {
+	  if (haveSequence && (record->sequence != expectedSequence))
+	  {
+	       uint16_t gap = record->sequence - expectedSequence;
+
+	       printf("%12s %11s  ---- %u records lost in the transfer\n", "", "", gap);
+	       numLost += gap;
+	  }
+	  expectedSequence = record->sequence + 1;
+	  haveSequence = true;
+     }
+
+     if (havePrevious == false)
+     {
+	  firstTimestamp = record->timestamp;
+	  previousTimestamp = record->timestamp;
+	  havePrevious = true;
+     }
+
+     // PITCounter is a 32 bit count of 0.1mS, the subtractions handle it wrapping
+     delta = record->timestamp - previousTimestamp;
+     previousTimestamp = record->timestamp;
+
+     decodeArgs(record, args, sizeof(args));
+
+     printf("%10u.%01u +%8u.%01u  %-18s %s\n",
+	    (record->timestamp - firstTimestamp) / 10, (record->timestamp - firstTimestamp) % 10,
+	    delta / 10, delta % 10,
+	    ((record->eventId < NUM_TRACE_EVENTS) ? eventNames[record->eventId] : "?"), args);
+
+     numRecords++;
+}
+
+static int decodeFile(const char *filename)
+{
+     uint8_t       buf[RECORD_SIZE];
+     traceRecord_t record;
+     FILE         *fp;
+
+     if ((fp = fopen(filename, "rb")) == NULL)
+     {
+	  fprintf(stderr, "Error. Can't open %s: %s\n", filename, strerror(errno));
+	  return EXIT_FAILURE;
+     }
+
+     while ((stopRequested == 0) && (fread(buf, 1, sizeof(buf), fp) == sizeof(buf)))
+     {
+	  unpackRecord(buf, &record);
+	  printRecord(&record);
+     }
+
+     fclose(fp);
+
+     return EXIT_SUCCESS;
+}
+
+static int serialOpen(const char *device)
+{
+     struct termios tio;
+     int fd;
+
+     if ((fd = open(device, O_RDWR | O_NOCTTY)) == -1)
+     {
+	  return -1;
+     }
+
+     if (tcgetattr(fd, &tio) == -1)
+     {
+	  close(fd);
+	  return -1;
+     }
+
+     cfmakeraw(&tio);
+     cfsetspeed(&tio, B115200);
+
+     if (tcsetattr(fd, TCSANOW, &tio) == -1)
+     {
+	  close(fd);
+	  return -1;
+     }
+
+     tcflush(fd, TCIOFLUSH);
+
+     return fd;
+}
+
+/**
+ * Read 'len' bytes, returns false on error or when interrupted
+ **/
+static bool serialRead(int fd, uint8_t *buf, size_t len)
+{
+     while (len > 0)
+     {
+	  ssize_t rlen;
+
+	  if ((rlen = read(fd, buf, len)) <= 0)
+	  {
+	       return false;
+	  }
+
+	  buf += rlen;
+	  len -= rlen;
+     }
+
+     return true;
+}
+
+static bool sendTraceCommand(int fd, bool enable)
+{
+     uint8_t request[] = { 'C', 8, (enable ? 1 : 0) };
+
+     return (write(fd, request, sizeof(request)) == sizeof(request));
+}
+
+static int decodeSerial(const char *device)
+{
+     uint8_t          buf[MAX_PACKET_RECORDS * RECORD_SIZE];
+     traceRecord_t    record;
+     struct sigaction sa;
+     int              fd;
+
+     if ((fd = serialOpen(device)) == -1)
+     {
+	  fprintf(stderr, "Error. Can't open %s: %s\n", device, strerror(errno));
+	  return EXIT_FAILURE;
+     }
+
+     // No SA_RESTART, so that the blocking read() returns when interrupted
+     memset(&sa, 0, sizeof(sa));
+     sa.sa_handler = signalHandler;
+     sigaction(SIGINT, &sa, NULL);
+     sigaction(SIGTERM, &sa, NULL);
+
+     if (sendTraceCommand(fd, true) == false)
+     {
+	  fprintf(stderr, "Error. Can't write to %s: %s\n", device, strerror(errno));
+	  close(fd);
+	  return EXIT_FAILURE;
+     }
+
+     while (stopRequested == 0)
+     {
+	  int  n;
+	  bool valid = true;
+
+	  if (serialRead(fd, buf, 1) == false)
+	  {
+	       break;
+	  }
+
+	  if (buf[0] == '!')
+	  {
+	       fprintf(stderr, "Error. The radio refused to stream the trace, its screen is being streamed\n");
+	       break;
+	  }
+
+	  // Anything but a trace packet ('-' reply to the command) is skipped
+	  if (buf[0] != 'T')
+	  {
+	       continue;
+	  }
+
+	  if (serialRead(fd, buf, 1) == false)
+	  {
+	       break;
+	  }
+
+	  // Not a packet header, the stream is resynchronised on the next 'T'
+	  n = buf[0];
+	  if ((n < 1) || (n > MAX_PACKET_RECORDS))
+	  {
+	       numBadPackets++;
+	       continue;
+	  }
+
+	  if (serialRead(fd, buf, n * RECORD_SIZE) == false)
+	  {
+	       break;
+	  }
+
+	  for (int i = 0; i < n; i++)
+	  {
+	       unpackRecord(&buf[i * RECORD_SIZE], &record);
+	       if ((record.eventId == 0) || (record.eventId >= NUM_TRACE_EVENTS))
+	       {
+		    valid = false;
+		    break;
+	       }
+	  }
+
+	  if (valid == false)
+	  {
+	       numBadPackets++;
+	       continue;
+	  }
+
+	  for (int i = 0; i < n; i++)
+	  {
+	       unpackRecord(&buf[i * RECORD_SIZE], &record);
+	       printRecord(&record);
+	  }
+	  fflush(stdout);
+     }
+
+     sendTraceCommand(fd, false);
+     tcdrain(fd);
+     close(fd);
+
+     return EXIT_SUCCESS;
+}
+
+static void usage(const char *name)
+{
+     fprintf(stderr, "Usage: %s [-d device] [-f file]\n", name);
+     fprintf(stderr, "  -d device : stream the trace from the radio over USB (default %s)\n", DEFAULT_DEVICE);
+     fprintf(stderr, "  -f file   : decode a dump of the RTT trace channel (1)\n");
+}
+
+int main(int argc, char **argv)
+{
+     const char *device = DEFAULT_DEVICE;
+     const char *filename = NULL;
+     int         opt;
+     int         ret;
+
+     while ((opt = getopt(argc, argv, "hd:f:")) != -1)
+     {
+	  switch (opt)
+	  {
+	  case 'd':
+	       device = optarg;
+	       break;
+	  case 'f':
+	       filename = optarg;
+	       break;
+	  default:
+	       usage(argv[0]);
+	       return ((opt == 'h') ? EXIT_SUCCESS : EXIT_FAILURE);
+	  }
+     }
+
+     printf("%12s %11s  %-18s %s\n", "time (mS)", "delta", "event", "arguments");
+
+     ret = ((filename != NULL) ? decodeFile(filename) : decodeSerial(device));
+
+     fprintf(stderr, "%lu records, %lu lost, %lu bad packets\n", numRecords, numLost, numBadPackets);
+
+     return ret;
+}
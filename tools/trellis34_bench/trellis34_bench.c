@@ -0,0 +1,321 @@
+/* -*- mode: c; c-file-style: "k&r"; compile-command: "gcc -Wall -O2 -I../../firmware/include -o trellis34_bench trellis34_bench.c"; -*- */
+
+/*
+ * Host check and benchmark of the rate 3/4 Trellis codec of the hotspot (firmware/source/hotspot/Trellis34.c).
+ *
+ * The firmware encoder and decoder are compared with a reference codec written straight from the
+ * ETSI TS 102 361-1 B.2 tables, on fixed and random payloads, with and without bit errors.
+ * The time per burst of the firmware code is then reported (the portable path, not the Cortex-M4 SIMD one).
+ *
+ * Copyright (C)2019 Roger Clark. VK3KYY
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *   1. Redistributions of source code must retain the above copyright notice,
+ *      this list of conditions and the following disclaimer.
+ *   2. Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer in the
+ *      documentation and/or other materials provided with the distribution.
+ *   3. The name of the author may not be used to endorse or promote products
+ *      derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR IMPLIED
+ * WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO
+ * EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ * ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+//
+// Usage: trellis34_bench [iterations]
+//
+// The exit code is 0 when all the checks passed, 1 otherwise.
+//
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include <time.h>
+
+// The firmware source is built as it is, without main.h and its hardware headers
+#define _DMR_TRELLIS34_H_
+bool Trellis34_decode(const unsigned char* in, unsigned char* out);
+void Trellis34_encode(const unsigned char* in, unsigned char* out);
+#include "../../firmware/source/hotspot/Trellis34.c"
+
+#define BURST_LENGTH     33
+#define PAYLOAD_LENGTH   18
+#define NUM_TRIBITS      49
+#define NUM_DIBITS       98
+#define NUM_STATES       8
+
+// ETSI TS 102 361-1 Table B.7: constellation point to dibit pair
+static const int8_t REF_CONSTELLATION[16][2] = {
+     { +1, -1 }, { -1, -1 }, { +3, -3 }, { -3, -3 }, { -3, -1 }, { +3, -1 }, { -1, -3 }, { +1, -3 },
+     { -3, +3 }, { +3, +3 }, { -1, +1 }, { +1, +1 }, { +1, +3 }, { -1, +3 }, { +3, +1 }, { -3, +1 }
+};
+
+// ETSI TS 102 361-1 Table B.9: constellation point for [state][tribit], the state being the previous tribit
+static const uint8_t REF_TRANSITION[NUM_STATES][8] = {
+     { 0,  8, 4, 12, 2, 10, 6, 14 },
+     { 4, 12, 2, 10, 6, 14, 0,  8 },
+     { 1,  9, 5, 13, 3, 11, 7, 15 },
+     { 5, 13, 3, 11, 7, 15, 1,  9 },
+     { 3, 11, 7, 15, 1,  9, 5, 13 },
+     { 7, 15, 1,  9, 5, 13, 3, 11 },
+     { 2, 10, 6, 14, 0,  8, 4, 12 },
+     { 6, 14, 0,  8, 4, 12, 2, 10 }
+};
+
+// ETSI TS 102 361-1 Table B.8: transmitted dibit i is dibit REF_INTERLEAVE[i] of the encoder output
+static const uint8_t REF_INTERLEAVE[NUM_DIBITS] = {
+      0,  1,  8,  9, 16, 17, 24, 25, 32, 33, 40, 41, 48, 49, 56, 57, 64, 65, 72, 73, 80, 81, 88, 89, 96, 97,
+      2,  3, 10, 11, 18, 19, 26, 27, 34, 35, 42, 43, 50, 51, 58, 59, 66, 67, 74, 75, 82, 83, 90, 91,
+      4,  5, 12, 13, 20, 21, 28, 29, 36, 37, 44, 45, 52, 53, 60, 61, 68, 69, 76, 77, 84, 85, 92, 93,
+      6,  7, 14, 15, 22, 23, 30, 31, 38, 39, 46, 47, 54, 55, 62, 63, 70, 71, 78, 79, 86, 87, 94, 95
+};
+
+static int getBit(const uint8_t *data, int n)
+{
+     return (data[n / 8] >> (7 - (n % 8))) & 1;
+}
+
+static void setBit(uint8_t *data, int n, int bit)
+{
+     if (bit)
+	  data[n / 8] |= (0x80 >> (n % 8));
+     else
+	  data[n / 8] &= ~(0x80 >> (n % 8));
+}
+
+// The 196 payload bits are around the 68 bits of the sync / embedded signalling
+static int burstBit(int n)
+{
+     return (n < 98) ? n : (n + 68);
+}
+
+// Dibit symbol to its 2 bits: +3 is 01, +1 is 00, -1 is 10, -3 is 11
+static int symbolToBits(int symbol)
+{
+     switch (symbol) {
+     case +3: return 1;
+     case +1: return 0;
+     case -1: return 2;
+     default: return 3;
+     }
+}
+
+static void refPayloadToTribits(const uint8_t *payload, uint8_t *tribits)
+{
+     for (int i = 0; i < (NUM_TRIBITS - 1); i++)
+	  tribits[i] = (getBit(payload, i * 3) << 2) | (getBit(payload, i * 3 + 1) << 1) | getBit(payload, i * 3 + 2);
+     tribits[NUM_TRIBITS - 1] = 0;
+}
+
+static void refEncode(const uint8_t *payload, uint8_t *burst)
+{
+     uint8_t tribits[NUM_TRIBITS];
+     int symbols[NUM_DIBITS];
+     int state = 0;
+
+     refPayloadToTribits(payload, tribits);
+
+     for (int i = 0; i < NUM_TRIBITS; i++) {
+	  int point = REF_TRANSITION[state][tribits[i]];
+
+	  symbols[i * 2] = REF_CONSTELLATION[point][0];
+	  symbols[i * 2 + 1] = REF_CONSTELLATION[point][1];
+	  state = tribits[i];
+     }
+
+     for (int i = 0; i < NUM_DIBITS; i++) {
+	  int bits = symbolToBits(symbols[REF_INTERLEAVE[i]]);
+
+	  setBit(burst, burstBit(i * 2), bits & 2);
+	  setBit(burst, burstBit(i * 2 + 1), bits & 1);
+     }
+}
+
+// Plain hard decision Viterbi decoder, with integer metrics and full survivor paths. Returns the best path bit errors.
+static int refDecode(const uint8_t *burst, uint8_t *payload)
+{
+     int received[NUM_DIBITS];
+     int metric[NUM_STATES], newMetric[NUM_STATES];
+     uint8_t path[NUM_STATES][NUM_TRIBITS], newPath[NUM_STATES][NUM_TRIBITS];
+
+     for (int i = 0; i < NUM_DIBITS; i++)
+	  received[REF_INTERLEAVE[i]] = (getBit(burst, burstBit(i * 2)) << 1) | getBit(burst, burstBit(i * 2 + 1));
+
+     for (int s = 0; s < NUM_STATES; s++)
+	  metric[s] = (s == 0) ? 0 : 10000;
+
+     for (int step = 0; step < NUM_TRIBITS; step++) {
+	  for (int s = 0; s < NUM_STATES; s++)
+	       newMetric[s] = 100000;
+
+	  for (int prev = 0; prev < NUM_STATES; prev++) {
+	       for (int tribit = 0; tribit < 8; tribit++) {
+		    int point = REF_TRANSITION[prev][tribit];
+		    int d0 = symbolToBits(REF_CONSTELLATION[point][0]) ^ received[step * 2];
+		    int d1 = symbolToBits(REF_CONSTELLATION[point][1]) ^ received[step * 2 + 1];
+		    int m = metric[prev] + __builtin_popcount(d0) + __builtin_popcount(d1);
+
+		    if (m < newMetric[tribit]) {
+			 newMetric[tribit] = m;
+			 memcpy(newPath[tribit], path[prev], step);
+			 newPath[tribit][step] = tribit;
+		    }
+	       }
+	  }
+
+	  memcpy(metric, newMetric, sizeof(metric));
+	  memcpy(path, newPath, sizeof(path));
+     }
+
+     memset(payload, 0, PAYLOAD_LENGTH);
+     for (int i = 0; i < (NUM_TRIBITS - 1); i++) {
+	  setBit(payload, i * 3, path[0][i] & 4);
+	  setBit(payload, i * 3 + 1, path[0][i] & 2);
+	  setBit(payload, i * 3 + 2, path[0][i] & 1);
+     }
+
+     return metric[0];
+}
+
+static void randomBytes(uint8_t *data, int length)
+{
+     for (int i = 0; i < length; i++)
+	  data[i] = rand() & 0xFF;
+}
+
+static void flipBurstBit(uint8_t *burst, int n)
+{
+     int pos = burstBit(n);
+
+     setBit(burst, pos, !getBit(burst, pos));
+}
+
+static double elapsedMicroseconds(const struct timespec *start, const struct timespec *end)
+{
+     return ((end->tv_sec - start->tv_sec) * 1e6) + ((end->tv_nsec - start->tv_nsec) / 1e3);
+}
+
+static int failures = 0;
+
+static void check(bool ok, const char *what, int vector)
+{
+     if (!ok) {
+	  fprintf(stderr, "FAIL: %s (vector %d)\n", what, vector);
+	  failures++;
+     }
+}
+
+int main(int argc, char **argv)
+{
+     int iterations = (argc > 1) ? atoi(argv[1]) : 100000;
+     uint8_t payload[PAYLOAD_LENGTH], decoded[PAYLOAD_LENGTH], refDecoded[PAYLOAD_LENGTH];
+     uint8_t burst[BURST_LENGTH], refBurst[BURST_LENGTH];
+     int twoErrorFailures = 0, twoErrorRefMismatches = 0;
+     const int numVectors = 200;
+     struct timespec start, end;
+     volatile int sink = 0;
+
+     srand(1);
+
+     // Known vector: an all zero payload is constellation point 0 (+1 -1, so bits 00 10) in every step,
+     // which leaves 0x22 in every byte of the payload area. The sync / embedded signalling bits are untouched.
+     memset(payload, 0, sizeof(payload));
+     memset(burst, 0xFF, sizeof(burst));
+     Trellis34_encode(payload, burst);
+     for (int i = 0; i < 196; i++)
+	  check(getBit(burst, burstBit(i)) == (((i % 4) == 2) ? 1 : 0), "all zero payload encoding", 0);
+     for (int i = 98; i < 166; i++)
+	  check(getBit(burst, i) == 1, "sync bits left untouched", 0);
+
+     for (int v = 0; v < numVectors; v++) {
+	  // Vectors 1 and 2 are all ones and alternate bits, then random payloads
+	  if (v == 0)
+	       memset(payload, 0xFF, sizeof(payload));
+	  else if (v == 1)
+	       memset(payload, 0x55, sizeof(payload));
+	  else
+	       randomBytes(payload, sizeof(payload));
+
+	  randomBytes(burst, sizeof(burst));
+	  memcpy(refBurst, burst, sizeof(burst));
+	  Trellis34_encode(payload, burst);
+	  refEncode(payload, refBurst);
+	  check(memcmp(burst, refBurst, sizeof(burst)) == 0, "encoder differs from the reference", v);
+
+	  check(Trellis34_decode(burst, decoded) && (memcmp(decoded, payload, sizeof(payload)) == 0), "error free burst", v);
+	  check((refDecode(burst, refDecoded) == 0) && (memcmp(refDecoded, payload, sizeof(payload)) == 0), "reference decoder, error free burst", v);
+
+	  // Every single bit error is corrected
+	  for (int e = 0; e < 196; e++) {
+	       uint8_t corrupted[BURST_LENGTH];
+
+	       memcpy(corrupted, burst, sizeof(burst));
+	       flipBurstBit(corrupted, e);
+	       check(Trellis34_decode(corrupted, decoded) && (memcmp(decoded, payload, sizeof(payload)) == 0), "single bit error", v);
+	  }
+
+	  // With 2 errors the code is beyond its free distance, so only count how often both decoders miss, or disagree
+	  for (int n = 0; n < 20; n++) {
+	       uint8_t corrupted[BURST_LENGTH];
+	       int e1 = rand() % 196, e2;
+
+	       do {
+		    e2 = rand() % 196;
+	       } while (e2 == e1);
+
+	       memcpy(corrupted, burst, sizeof(burst));
+	       flipBurstBit(corrupted, e1);
+	       flipBurstBit(corrupted, e2);
+	       refDecode(corrupted, refDecoded);
+	       if (!Trellis34_decode(corrupted, decoded) || (memcmp(decoded, payload, sizeof(payload)) != 0))
+		    twoErrorFailures++;
+	       if (memcmp(refDecoded, payload, sizeof(payload)) != 0)
+		    twoErrorRefMismatches++;
+	  }
+     }
+
+     // Noise is rejected: the best path through a random burst has 7 or more bit errors
+     for (int v = 0; v < numVectors; v++) {
+	  randomBytes(burst, sizeof(burst));
+	  check(!Trellis34_decode(burst, decoded), "random burst rejected", v);
+     }
+
+     printf("%d vectors checked against the reference codec, %d failures\n", numVectors, failures);
+     printf("2 bit errors: %d of %d bursts not recovered (reference decoder: %d)\n", twoErrorFailures, numVectors * 20, twoErrorRefMismatches);
+
+     randomBytes(payload, sizeof(payload));
+     Trellis34_encode(payload, burst);
+
+     clock_gettime(CLOCK_MONOTONIC, &start);
+     for (int i = 0; i < iterations; i++) {
+	  burst[i % BURST_LENGTH] ^= 0x01;// Keep the compiler from hoisting the work out of the loop
+	  sink += Trellis34_decode(burst, decoded);
+	  burst[i % BURST_LENGTH] ^= 0x01;
+     }
+     clock_gettime(CLOCK_MONOTONIC, &end);
+     printf("Trellis34_decode: %.2f uS per burst\n", elapsedMicroseconds(&start, &end) / iterations);
+
+     clock_gettime(CLOCK_MONOTONIC, &start);
+     for (int i = 0; i < iterations; i++) {
+	  payload[i % PAYLOAD_LENGTH] ^= 0x01;
+	  Trellis34_encode(payload, burst);
+	  sink += burst[i % BURST_LENGTH];
+     }
+     clock_gettime(CLOCK_MONOTONIC, &end);
+     printf("Trellis34_encode: %.2f uS per burst\n", elapsedMicroseconds(&start, &end) / iterations);
+
+     return (failures == 0) ? 0 : 1;
+}
@@ -0,0 +1,336 @@
+/* -*- mode: c; c-file-style: "k&r"; compile-command: "gcc -Wall -O2 -s -o voice_prompts_builder voice_prompts_builder.c"; -*- */
+
+/*
+ * Voice prompts builder: packs AMBE voice prompt files into the image which the OpenGD77 firmware plays from
+ * the Flash (see speech_synthesis.c), on the GD-77, DM-1801 and RD-5R.
+ *
+ * Copyright (C)2019 Roger Clark. VK3KYY
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *   1. Redistributions of source code must retain the above copyright notice,
+ *      this list of conditions and the following disclaimer.
+ *   2. Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer in the
+ *      documentation and/or other materials provided with the distribution.
+ *   3. The name of the author may not be used to endorse or promote products
+ *      derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR IMPLIED
+ * WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO
+ * EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ * ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+//
+// Usage: voice_prompts_builder [-o output] directory
+//
+// Each prompt is a file of raw AMBE bursts (27 bytes, 3 AMBE frames, 60mS), as the ones saved by the call
+// recorder (ambeRecorder.c). The file of prompt number N is directory/<promptNames[N]>.amb, e.g. prompts/zero.amb.
+// The prompts are numbered as the words of the EPL003 (EPL003_Sequence_t in EPL003.h), which is the order
+// the firmware asks for them. A missing file gives an empty prompt, except for the sequence separator,
+// which is made of silence bursts.
+//
+// The image is written to the Flash at 0xA0000 (SPEECH_PROMPTS_FLASH_START), 128KB at most. All values are little endian:
+//
+//   magic(32, "AMBP") number_of_prompts(32)
+//   offsets(32) * (number_of_prompts + 1)   offset of each prompt from the start of the image, then the end of the last one
+//   bursts of prompt 0, prompt 1...
+//
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include <unistd.h>
+#include <errno.h>
+
+#define DEFAULT_OUTPUT     "voice_prompts.bin"
+#define AMBE_BURST_LENGTH  27
+#define IMAGE_MAX_SIZE     0x20000// SPEECH_PROMPTS_FLASH_SIZE
+#define PROMPTS_MAX        128// SPEECH_PROMPTS_MAX
+#define PROMPTS_MAGIC      "AMBP"
+#define SEPARATOR_PROMPT   88// SPEECH_SYNTHESIS_SEQUENCE_SEPARATOR
+#define SEPARATOR_BURSTS   3// About the 200mS gap of the EPL003 on the GD-77S
+
+// Must match EPL003_Sequence_t in EPL003.h
+static const char *promptNames[] =
+{
+     "zero",                        // 0
+     "one",                         // 1
+     "two",                         // 2
+     "three",                       // 3
+     "four",                        // 4
+     "five",                        // 5
+     "six",                         // 6
+     "seven",                       // 7
+     "eight",                       // 8
+     "nine",                        // 9
+     "ten",                         // 10
+     "eleven",                      // 11
+     "twelve",                      // 12
+     "thirteen",                    // 13
+     "fourteen",                    // 14
+     "fifteen",                     // 15
+     "sixteen",                     // 16
+     "seventeen",                   // 17
+     "eighteen",                    // 18
+     "nineteen",                    // 19
+     "twenty",                      // 20
+     "thirty",                      // 21
+     "forty",                       // 22
+     "fifty",                       // 23
+     "sixty",                       // 24
+     "seventy",                     // 25
+     "eighty",                      // 26
+     "ninety",                      // 27
+     "hundred",                     // 28
+     "power_on",                    // 29
+     "please_charge_the_battery",   // 30
+     "cloning",                     // 31
+     "power_off",                   // 32
+     "alarm",                       // 33
+     "squelch",                     // 34
+     "vox",                         // 35
+     "level",                       // 36
+     "scramble",                    // 37
+     "scan",                        // 38
+     "on",                          // 39
+     "off",                         // 40
+     "frequency",                   // 41
+     "channel",                     // 42
+     "power",                       // 43
+     "key",                         // 44
+     "lock",                        // 45
+     "unlock",                      // 46
+     "mode",                        // 47
+     "shift",                       // 48
+     "plus",                        // 49
+     "minus",                       // 50
+     "reverse",                     // 51
+     "priority",                    // 52
+     "tone",                        // 53
+     "receive",                     // 54
+     "transmit",                    // 55
+     "store",                       // 56
+     "id_code",                     // 57
+     "ctcss",                       // 58
+     "dcs",                         // 59
+     "dtmf",                        // 60
+     "step",                        // 61
+     "wide",                        // 62
+     "narrow",                      // 63
+     "light",                       // 64
+     "menu",                        // 65
+     "function",                    // 66
+     "set",                         // 67
+     "name",                        // 68
+     "exit",                        // 69
+     "error",                       // 70
+     "auto",                        // 71
+     "okay",                        // 72
+     "enter",                       // 73
+     "delete",                      // 74
+     "high",                        // 75
+     "middle",                      // 76
+     "low",                         // 77
+     "battery",                     // 78
+     "point",                       // 79
+     "save",                        // 80
+     "radio",                       // 81
+     "t_o_t",                       // 82
+     "reverse_function",            // 83
+     "comm_pending",                // 84
+     "whisper",                     // 85
+     "tone_duplicate",              // 86
+     "end",                         // 87
+     "sequence_separator",          // 88
+     "display_color",               // 89
+     "orange",                      // 90
+     "green",                       // 91
+     "blue",                        // 92
+     "red",                         // 93
+     "yellow",                      // 94
+     "purple",                      // 95
+     "white",                       // 96
+};
+
+#define NUM_PROMPTS (sizeof(promptNames) / sizeof(promptNames[0]))
+
+// SILENCE_AUDIO in HR-C6000.c
+static const uint8_t silenceBurst[AMBE_BURST_LENGTH] =
+{
+     0xB9, 0xE8, 0x81, 0x52, 0x61, 0x73, 0x00, 0x2A, 0x6B, 0xB9, 0xE8, 0x81, 0x52,
+     0x61, 0x73, 0x00, 0x2A, 0x6B, 0xB9, 0xE8, 0x81, 0x52, 0x61, 0x73, 0x00, 0x2A, 0x6B
+};
+
+static uint8_t image[IMAGE_MAX_SIZE];
+
+static void put32(uint8_t *p, uint32_t value)
+{
+     p[0] = value & 0xFF;
+     p[1] = (value >> 8) & 0xFF;
+     p[2] = (value >> 16) & 0xFF;
+     p[3] = (value >> 24) & 0xFF;
+}
+
+/**
+ * Append the prompt file to the image at 'pos', returns the new end of the image, or -1 on error
+ **/
+static long appendPromptFile(const char *filename, long pos, bool *found)
+{
+     FILE *fp;
+     long  length;
+
+     if ((fp = fopen(filename, "rb")) == NULL)
+     {
+	  if (errno == ENOENT)
+	  {
+	       *found = false;
+	       return pos;
+	  }
+
+	  fprintf(stderr, "Error. Can't open %s: %s\n", filename, strerror(errno));
+	  return -1;
+     }
+
+     *found = true;
+     fseek(fp, 0, SEEK_END);
+     length = ftell(fp);
+     fseek(fp, 0, SEEK_SET);
+
+     if ((length % AMBE_BURST_LENGTH) != 0)
+     {
+	  fprintf(stderr, "Error. %s is not made of %d byte AMBE bursts (%ld bytes)\n", filename, AMBE_BURST_LENGTH, length);
+	  fclose(fp);
+	  return -1;
+     }
+
+     if ((pos + length) > IMAGE_MAX_SIZE)
+     {
+	  fprintf(stderr, "Error. The prompts don't fit in the %d bytes of Flash, at %s\n", IMAGE_MAX_SIZE, filename);
+	  fclose(fp);
+	  return -1;
+     }
+
+     if (fread(&image[pos], 1, length, fp) != length)
+     {
+	  fprintf(stderr, "Error. Can't read %s\n", filename);
+	  fclose(fp);
+	  return -1;
+     }
+
+     fclose(fp);
+     return (pos + length);
+}
+
+static void usage(const char *name)
+{
+     fprintf(stderr, "Usage: %s [-o output] directory\n", name);
+     fprintf(stderr, "  -o output : image file to write (default %s)\n", DEFAULT_OUTPUT);
+     fprintf(stderr, "  -l        : list the prompt file names, in the order of the prompts\n");
+}
+
+int main(int argc, char **argv)
+{
+     const char *output = DEFAULT_OUTPUT;
+     const char *directory;
+     char        filename[1024];
+     long        pos;
+     int         numMissing = 0;
+     int         opt;
+     FILE       *fp;
+
+     while ((opt = getopt(argc, argv, "hlo:")) != -1)
+     {
+	  switch (opt)
+	  {
+	  case 'o':
+	       output = optarg;
+	       break;
+	  case 'l':
+	       for (int i = 0; i < NUM_PROMPTS; i++)
+	       {
+		    printf("%3d %s.amb\n", i, promptNames[i]);
+	       }
+	       return EXIT_SUCCESS;
+	  default:
+	       usage(argv[0]);
+	       return ((opt == 'h') ? EXIT_SUCCESS : EXIT_FAILURE);
+	  }
+     }
+
+     if (optind >= argc)
+     {
+	  usage(argv[0]);
+	  return EXIT_FAILURE;
+     }
+     directory = argv[optind];
+
+     if (NUM_PROMPTS > PROMPTS_MAX)
+     {
+	  fprintf(stderr, "Error. The firmware can't handle more than %d prompts\n", PROMPTS_MAX);
+	  return EXIT_FAILURE;
+     }
+
+     memcpy(image, PROMPTS_MAGIC, 4);
+     put32(&image[4], NUM_PROMPTS);
+     pos = 8 + ((NUM_PROMPTS + 1) * 4);
+
+     for (int i = 0; i < NUM_PROMPTS; i++)
+     {
+	  bool found;
+
+	  put32(&image[8 + (i * 4)], pos);
+
+	  snprintf(filename, sizeof(filename), "%s/%s.amb", directory, promptNames[i]);
+	  if ((pos = appendPromptFile(filename, pos, &found)) < 0)
+	  {
+	       return EXIT_FAILURE;
+	  }
+
+	  if (found == false)
+	  {
+	       if (i == SEPARATOR_PROMPT)
+	       {
+		    for (int b = 0; (b < SEPARATOR_BURSTS) && ((pos + AMBE_BURST_LENGTH) <= IMAGE_MAX_SIZE); b++)
+		    {
+			 memcpy(&image[pos], silenceBurst, AMBE_BURST_LENGTH);
+			 pos += AMBE_BURST_LENGTH;
+		    }
+	       }
+	       else
+	       {
+		    fprintf(stderr, "Warning. %s is missing, the prompt will be silent\n", filename);
+		    numMissing++;
+	       }
+	  }
+     }
+     put32(&image[8 + (NUM_PROMPTS * 4)], pos);
+
+     if ((fp = fopen(output, "wb")) == NULL)
+     {
+	  fprintf(stderr, "Error. Can't create %s: %s\n", output, strerror(errno));
+	  return EXIT_FAILURE;
+     }
+
+     if (fwrite(image, 1, pos, fp) != pos)
+     {
+	  fprintf(stderr, "Error. Can't write %s\n", output);
+	  fclose(fp);
+	  return EXIT_FAILURE;
+     }
+     fclose(fp);
+
+     fprintf(stdout, "Wrote %s: %d prompts (%d missing), %ld bytes. To be written to the Flash at 0xA0000\n", output, (int)NUM_PROMPTS, numMissing, pos);
+
+     return EXIT_SUCCESS;
+}